@@ -0,0 +1,110 @@
+///
+/// @file change_detector.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `ChangeDetector` class which finds the regions of a
+///        frame that differ from the previous frame.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef CHANGE_DETECTOR_HPP
+#define CHANGE_DETECTOR_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "pixel_format.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class ChangeDetector
+    /// @brief Compares frames tile by tile against a copy of the previous
+    ///        frame. Comparison uses AVX2 or SSE2 when the build targets them.
+    class ChangeDetector final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        ChangeDetector() noexcept = default; ///< Default constructor
+        ~ChangeDetector() noexcept = default; ///< Default destructor
+        ChangeDetector(ChangeDetector &&) noexcept = default; ///< Default move constructor
+        ChangeDetector &operator=(ChangeDetector &&) noexcept = default; ///< Default move assignment operator
+        ChangeDetector(const ChangeDetector &) noexcept = delete; ///< Deleted copy constructor
+        ChangeDetector &operator=(ChangeDetector const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Finds the changed regions of a frame and remembers it for
+        ///        the next call. Changed tiles next to each other in a tile
+        ///        row are merged into one region.
+        /// @param data_ptr[in] Image buffer pointer
+        /// @param layout[in] Layout of the image
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param dirty_regions[out] Changed regions, empty if nothing changed
+        void detect(const uint8_t* data_ptr,
+                    const ImageLayout& layout,
+                    int frame_width,
+                    int frame_height,
+                    std::vector<Rect>& dirty_regions);
+
+        /// @brief Forgets the previous frame, the next frame is fully dirty.
+        void reset() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @brief Compares a region of every plane with the previous frame.
+        /// @param data_ptr[in] Image buffer pointer
+        /// @param layout[in] Layout of the image
+        /// @param region[in] Region in image pixels
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @return true if the region equals the previous frame
+        bool is_region_unchanged(const uint8_t* data_ptr,
+                                 const ImageLayout& layout,
+                                 const Rect& region,
+                                 int frame_width,
+                                 int frame_height) const noexcept;
+
+        /// @brief Copies a region of every plane into the previous frame.
+        void store_region(const uint8_t* data_ptr,
+                          const ImageLayout& layout,
+                          const Rect& region,
+                          int frame_width,
+                          int frame_height) noexcept;
+
+        /// @brief Compares two byte ranges with the widest available vectors.
+        static bool are_bytes_equal(const uint8_t* lhs,
+                                    const uint8_t* rhs,
+                                    size_t size) noexcept;
+
+        static constexpr int m_tile_size = 64; ///< Tile edge length in image pixels.
+        std::vector<uint8_t> m_previous_frame; ///< Copy of the previous frame, planes with packed rows.
+        size_t m_plane_offsets[ImageLayout::max_plane_count]{}; ///< Start of each plane in the copy.
+        int m_previous_width{0}; ///< Width of the previous frame.
+        int m_previous_height{0}; ///< Height of the previous frame.
+
+    };
+} // YB
+
+#endif // CHANGE_DETECTOR_HPP
+
+/* end_of_file */
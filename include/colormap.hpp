@@ -0,0 +1,42 @@
+///
+/// @file colormap.hpp
+/// @author Yasin BASAR
+/// @brief Lookup tables of the built-in pseudo-color maps.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef COLORMAP_HPP
+#define COLORMAP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @brief Number of entries in a built-in colormap.
+    constexpr int colormap_entry_count = 256;
+
+    /// @brief Builds the lookup table of a built-in colormap.
+    /// @param colormap[in] Built-in colormap, `Custom` gives the gray ramp
+    /// @return `colormap_entry_count` RGBA entries
+    std::vector<uint8_t> make_colormap(Colormap colormap);
+
+} // YB
+
+#endif // COLORMAP_HPP
+
+/* end_of_file */
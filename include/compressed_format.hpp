@@ -0,0 +1,77 @@
+///
+/// @file compressed_format.hpp
+/// @author Yasin BASAR
+/// @brief Describes how each `CompressedFormat` is stored in textures and
+///        decodes the formats the driver can not sample.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef COMPRESSED_FORMAT_HPP
+#define COMPRESSED_FORMAT_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @struct CompressedLayout
+    /// @brief Texture and upload parameters of a block compressed image.
+    struct CompressedLayout
+    {
+        GLenum internal_format; ///< Texture storage format.
+        int block_size; ///< Bytes of one 4x4 block.
+        int block_columns; ///< Blocks in a row.
+        int block_rows; ///< Rows of blocks.
+        size_t image_size; ///< Bytes of the whole image.
+    };
+
+    /// @brief Computes the layout of a block compressed image.
+    /// @param format[in] Compressed format of the image
+    /// @param frame_width[in] Image Width
+    /// @param frame_height[in] Image Height
+    /// @return Layout of the image
+    CompressedLayout get_compressed_layout(CompressedFormat format,
+                                           int frame_width,
+                                           int frame_height) noexcept;
+
+    /// @brief Checks if textures of a compressed format can be created.
+    ///        Valid after the first window was created.
+    /// @param format[in] Compressed format
+    /// @return true if the driver samples the format, false if frames are
+    ///         decoded on the CPU
+    bool is_compressed_format_supported(CompressedFormat format) noexcept;
+
+    /// @brief Decodes a block compressed image to RGBA. Pixels of edge
+    ///        blocks outside the image are dropped.
+    /// @param data_ptr[in] Compressed image, see `get_compressed_layout`
+    /// @param format[in] Compressed format of the image
+    /// @param frame_width[in] Image Width
+    /// @param frame_height[in] Image Height
+    /// @param rgba_ptr[out] Buffer of `frame_width * frame_height * 4` bytes
+    void decompress_image(const uint8_t* data_ptr,
+                          CompressedFormat format,
+                          int frame_width,
+                          int frame_height,
+                          uint8_t* rgba_ptr) noexcept;
+
+} // YB
+
+#endif // COMPRESSED_FORMAT_HPP
+
+/* end_of_file */
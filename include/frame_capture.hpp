@@ -0,0 +1,195 @@
+///
+/// @file frame_capture.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `FrameCapture` class which reads back the presented
+///        frames of a window asynchronously for screenshots and recording.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef FRAME_CAPTURE_HPP
+#define FRAME_CAPTURE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gl_state_cache.hpp"
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class FrameCapture
+    /// @brief Copies the drawn framebuffer into a ring of pixel pack buffers
+    ///        right before it is presented. Every copy is guarded by a fence
+    ///        and only mapped once the fence signaled, so the drawing thread
+    ///        never waits for the GPU. The mapped buffers are handed to a
+    ///        worker thread which copies them and calls the user callback or
+    ///        writes the stream file, the drawing thread unmaps a buffer
+    ///        after the worker copied it.
+    ///        When every buffer is in flight or the worker falls behind the
+    ///        frame is dropped instead of slowing down the display.
+    class FrameCapture final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        FrameCapture() noexcept = default; ///< Default constructor
+        ~FrameCapture() noexcept; ///< Stops the worker, `release` must have been called
+        FrameCapture(FrameCapture &&) noexcept = delete; ///< Deleted move constructor
+        FrameCapture &operator=(FrameCapture &&) noexcept = delete; ///< Deleted move assignment operator
+        FrameCapture(const FrameCapture &) noexcept = delete; ///< Deleted copy constructor
+        FrameCapture &operator=(FrameCapture const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Opens the destination and starts the worker thread.
+        ///        It can be called from any thread, frames are captured
+        ///        from the next `capture` call on.
+        /// @param settings[in] Destination of the frames
+        /// @return false if a capture runs, the settings are invalid
+        ///         or the file could not be created
+        bool start(const CaptureSettings& settings);
+
+        /// @brief Waits until the readbacks in flight are done and hands them
+        ///        to the worker. The window's context must be current.
+        void flush() noexcept;
+
+        /// @brief Lets the worker deliver the queued frames, then joins it and
+        ///        closes the file. Readbacks still in flight are discarded,
+        ///        call `flush` first when the context can be made current.
+        ///        It can be called from any thread.
+        void stop() noexcept;
+
+        /// @brief Hands finished readbacks to the worker and starts reading
+        ///        the current framebuffer. Called after drawing and before
+        ///        presenting, the window's context must be current.
+        /// @param gl_state[in,out] State cache of the window, counts the calls
+        void capture(GLStateCache& gl_state) noexcept;
+
+        /// @brief Deletes the pixel pack buffers and fences, after waiting
+        ///        for the worker to copy the mapped ones.
+        ///        The window's context must be current.
+        void release() noexcept;
+
+        /// @brief Returns the frame counters. It can be called from any thread.
+        /// @return Statistics of the running or the last capture
+        CaptureStatistics get_statistics() const noexcept;
+
+        /// @brief Checks if a capture runs. It can be called from any thread.
+        /// @return true between `start` and `stop`
+        bool is_active() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @struct Readback
+        /// @brief Pixel pack buffer and the fence of the copy into it.
+        struct Readback
+        {
+            GLuint buffer; ///< Pixel pack buffer.
+            size_t capacity; ///< Allocated bytes of the buffer.
+            GLsync fence; ///< Signaled when the copy is done, nullptr once it was collected.
+            bool is_mapped; ///< Set while the worker copies the buffer.
+            int width; ///< Width of the copied framebuffer.
+            int height; ///< Height of the copied framebuffer.
+            uint64_t frame_index; ///< Index of the frame since the capture started.
+        };
+
+        /// @struct CapturedFrame
+        /// @brief Frame waiting for the worker, bottom row first as OpenGL reads it.
+        struct CapturedFrame
+        {
+            std::vector<uint8_t> pixels; ///< RGBA pixels, copied by the worker.
+            const uint8_t* mapped_ptr; ///< Mapped pixel pack buffer, valid until the copy is done.
+            int readback_index; ///< Readback the mapping belongs to.
+            int width; ///< Frame width.
+            int height; ///< Frame height.
+            uint64_t frame_index; ///< Index of the frame since the capture started.
+        };
+
+        /// @brief Hands signaled readbacks to the worker and frees the ones
+        ///        it copied, oldest first.
+        /// @param is_blocking[in] true to wait for every readback in flight
+        void collect(bool is_blocking) noexcept;
+
+        /// @brief Maps a finished readback and queues it for the worker.
+        /// @param readback_index[in] Readback whose fence signaled
+        /// @return true if the buffer stays mapped until the worker copied it
+        bool deliver(int readback_index) noexcept;
+
+        /// @brief Unmaps a readback buffer.
+        /// @param readback[in,out] Mapped readback
+        static void unmap(Readback& readback) noexcept;
+
+        /// @brief Delivers queued frames until the capture stops and the queue is empty.
+        void run_worker() noexcept;
+
+        /// @brief Passes a frame to the callback or writes it into the file.
+        ///        Called from the worker thread.
+        /// @param frame[in,out] Frame, its rows can be reordered in place
+        /// @return false if the frame could not be written
+        bool write_frame(CapturedFrame& frame) noexcept;
+
+        /// @brief Converts a frame to I420 and appends it to the Y4M stream.
+        /// @param frame[in] Frame
+        /// @return false if the frame size differs from the stream header
+        bool write_y4m_frame(const CapturedFrame& frame) noexcept;
+
+        static constexpr int m_max_frames_in_flight = 8; ///< Upper limit of the readback ring.
+        static constexpr size_t m_max_queued_frames = 8; ///< Frames the worker can fall behind before frames are dropped.
+
+        std::array<Readback, m_max_frames_in_flight> m_readbacks{}; ///< Readback ring, used by the drawing thread only.
+        int m_readback_count{0}; ///< Created readbacks, 0 until the first capture.
+        int m_first_pending{0}; ///< Ring index of the oldest readback in flight.
+        int m_pending_count{0}; ///< Readbacks in flight.
+        uint32_t m_readback_session{0}; ///< Capture the readbacks belong to.
+        uint64_t m_next_frame_index{0}; ///< Index given to the next captured frame.
+
+        mutable std::mutex m_mutex; ///< Guards the members below.
+        std::condition_variable m_condition; ///< Wakes the worker for queued frames and stops.
+        std::condition_variable m_copy_condition; ///< Signaled when the worker copied a mapped buffer.
+        std::array<bool, m_max_frames_in_flight> m_is_copy_pending{}; ///< Mapped readbacks the worker did not copy yet.
+        std::deque<CapturedFrame> m_queue{}; ///< Frames waiting for the worker, oldest first.
+        std::vector<std::vector<uint8_t>> m_free_buffers{}; ///< Frame buffers the worker is done with.
+        CaptureSettings m_settings{}; ///< Settings of the running capture.
+        bool m_is_active{false}; ///< Set between `start` and `stop`.
+        uint32_t m_session{0}; ///< Incremented by every `start`.
+        CaptureStatistics m_statistics{}; ///< Counters of the running or the last capture.
+
+        std::thread m_worker{}; ///< Delivers the queued frames.
+        std::FILE* m_file{nullptr}; ///< Stream file, used by the worker only while it runs.
+        int m_stream_width{0}; ///< Frame width of the Y4M header, 0 until it is written.
+        int m_stream_height{0}; ///< Frame height of the Y4M header.
+        std::vector<uint8_t> m_converted{}; ///< I420 frame of the Y4M writer.
+
+    };
+} // YB
+
+#endif // FRAME_CAPTURE_HPP
+
+/* end_of_file */
@@ -0,0 +1,141 @@
+///
+/// @file frame_pacer.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `FramePacer` class which decides when the frames of
+///        a window are presented and measures how evenly they are.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "frame_profiler.hpp"
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class FramePacer
+    /// @brief Paces the presents of a window. The swap interval selects vsync,
+    ///        waits of the frame rate limiter sleep for most of their length
+    ///        and spin for the last part, since sleeps overshoot by the
+    ///        scheduler granularity. Settings can be changed from any thread,
+    ///        they are applied by the thread which presents the window with
+    ///        its context current.
+    class FramePacer final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Constructs a pacer for the swap interval the window was created with.
+        ///        On Windows the system timer resolution is raised to 1 ms
+        ///        while the pacer exists.
+        /// @param mode[in] `VSync` or `Unlimited`
+        explicit FramePacer(PacingMode mode) noexcept;
+        ~FramePacer() noexcept; ///< Restores the system timer resolution
+        FramePacer(FramePacer &&) noexcept = delete; ///< Deleted move constructor
+        FramePacer &operator=(FramePacer &&) noexcept = delete; ///< Deleted move assignment operator
+        FramePacer(const FramePacer &) noexcept = delete; ///< Deleted copy constructor
+        FramePacer &operator=(FramePacer const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        using clock = std::chrono::steady_clock;
+
+        /// @brief Stores new settings, they are applied before the next present.
+        /// @param settings[in] Pacing settings
+        void set_settings(const PacingSettings& settings) noexcept;
+
+        /// @brief Sets the swap interval directly, e.g. for windows of a group
+        ///        which move the vsync wait between them. The context must be current.
+        /// @param interval[in] Swap interval
+        void set_swap_interval(int interval) noexcept;
+
+        /// @brief Hands the swap interval to a window group. While grouped
+        ///        pacing settings are kept pending and the pacer neither
+        ///        limits the frame rate nor drains the driver queue, they are
+        ///        applied again by the first present after leaving the group.
+        ///        Joining must happen on the presenting thread.
+        /// @param is_grouped[in] true when the window joins a group
+        void set_grouped(bool is_grouped) noexcept;
+
+        /// @brief Applies pending settings and waits for the present time of
+        ///        the frame rate limiter. Called right before the swap.
+        void begin_swap() noexcept;
+
+        /// @brief Records the present which just returned. In `LowLatency`
+        ///        mode the driver queue is drained first.
+        void end_swap() noexcept;
+
+        /// @brief Holds the caller back in `LowLatency` mode until its next
+        ///        frame can just be drawn before the next vertical blank.
+        void delay_next_frame() noexcept;
+
+        /// @brief Waits as long as a present would have when an unchanged
+        ///        frame is not presented, so a caller showing it in a loop
+        ///        is still paced. `Unlimited` returns at once.
+        void skip_present() noexcept;
+
+        /// @brief Returns the intervals between the recent presents.
+        /// @return Pacing statistics
+        PacingStatistics get_statistics() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @brief Waits until a point in time, sleeping while the remaining
+        ///        time is longer than a sleep can overshoot and spinning after.
+        /// @param deadline[in] Point in time to return at
+        void wait_until(clock::time_point deadline) noexcept;
+
+        static constexpr std::chrono::microseconds m_spin_margin{500}; ///< Time always spun before a deadline.
+        static constexpr std::chrono::microseconds m_low_latency_margin{1000}; ///< Slack left before the vertical blank.
+
+        mutable std::mutex m_settings_mutex; ///< Guards `m_pending_settings`.
+        PacingSettings m_pending_settings; ///< Settings waiting for the presenting thread.
+        std::atomic<bool> m_has_pending_settings{false}; ///< Set when the settings changed.
+        std::atomic<bool> m_is_grouped{false}; ///< Set while a window group owns the swap interval.
+
+        mutable std::mutex m_statistics_mutex; ///< Guards the intervals and the counters.
+        RollingPercentiles m_intervals{}; ///< Intervals between recent presents.
+        uint64_t m_late_frame_count{0}; ///< Presents later than half a period.
+        int m_swap_interval; ///< Swap interval in use.
+
+        PacingSettings m_settings; ///< Settings in use.
+        clock::duration m_target_period{}; ///< Present period of `TargetRate`.
+        clock::duration m_display_period{}; ///< Measured vertical blank period, zero until known.
+        clock::duration m_frame_work{}; ///< Smoothed time the caller needs to deliver a frame.
+        clock::duration m_sleep_overshoot{std::chrono::milliseconds(1)}; ///< Smoothed time sleeps return late.
+        clock::time_point m_next_present{}; ///< Present time of the next limited frame.
+        clock::time_point m_last_present{}; ///< Return of the last present.
+        clock::time_point m_release_time{}; ///< When the caller was released for its next frame.
+        bool m_has_skipped_present{false}; ///< Set when presents were skipped, the next interval is not measured.
+
+    };
+} // YB
+
+#endif // FRAME_PACER_HPP
+
+/* end_of_file */
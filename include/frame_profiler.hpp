@@ -0,0 +1,162 @@
+///
+/// @file frame_profiler.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `FrameProfiler` class which measures the stages of
+///        every frame of a window on the CPU and on the GPU.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @enum FrameStage
+    /// @brief Measured stages of a frame.
+    enum class FrameStage : uint8_t
+    {
+        PollEvents, ///< Pumping window events, CPU only.
+        Upload, ///< Updating the textures.
+        Draw, ///< Drawing into the back buffer.
+        Swap, ///< Presenting, CPU only.
+        Count ///< Number of stages.
+    };
+
+    /// @class RollingPercentiles
+    /// @brief Keeps the latest samples of a duration in a ring,
+    ///        percentiles are only computed when they are asked for.
+    class RollingPercentiles final
+    {
+    public:
+
+        /// @brief Adds a sample and overwrites the oldest one if the ring is full.
+        /// @param milliseconds[in] Duration
+        void add(float milliseconds) noexcept;
+
+        /// @brief Computes the percentiles of the samples in the ring.
+        /// @return Percentiles, zeros if there is no sample
+        TimingPercentiles get_percentiles() const noexcept;
+
+        /// @brief Computes the mean and the standard deviation of the samples in the ring.
+        /// @param mean[out] Average sample, zero if there is no sample
+        /// @param standard_deviation[out] Spread of the samples, zero if there is no sample
+        void get_spread(double& mean, double& standard_deviation) const noexcept;
+
+    private:
+
+        static constexpr size_t m_capacity = 256; ///< Number of recent samples kept.
+        std::array<float, m_capacity> m_samples{}; ///< Ring of samples.
+        size_t m_next_index{0}; ///< Ring index the next sample is written to.
+        size_t m_count{0}; ///< Number of valid samples.
+
+    };
+
+    /// @class FrameProfiler
+    /// @brief Measures frame stages of a window. CPU times come from a steady
+    ///        clock, GPU times from `GL_TIME_ELAPSED` queries which are only
+    ///        read once their results are available, so nothing waits for
+    ///        the GPU. Stage functions are called by the thread which draws
+    ///        the window, statistics can be read from any thread.
+    class FrameProfiler final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        FrameProfiler() noexcept = default; ///< Default constructor
+        ~FrameProfiler() noexcept = default; ///< Default destructor
+        FrameProfiler(FrameProfiler &&) noexcept = delete; ///< Deleted move constructor
+        FrameProfiler &operator=(FrameProfiler &&) noexcept = delete; ///< Deleted move assignment operator
+        FrameProfiler(const FrameProfiler &) noexcept = delete; ///< Deleted copy constructor
+        FrameProfiler &operator=(FrameProfiler const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        using clock = std::chrono::steady_clock;
+
+        /// @brief Creates the timer queries. The window's context must be current.
+        void create_queries() noexcept;
+
+        /// @brief Deletes the timer queries. The window's context must be current.
+        void release_queries() noexcept;
+
+        /// @brief Starts measuring a stage, its GPU time is measured for
+        ///        `Upload` and `Draw`. A stage which runs again in the same
+        ///        frame adds its CPU time, its GPU time covers the first run
+        ///        only. Called while a stage runs it is counted as part of
+        ///        that stage.
+        /// @param stage[in] Stage which starts
+        void begin_stage(FrameStage stage) noexcept;
+
+        /// @brief Ends the stage started by the matching `begin_stage`.
+        void end_stage() noexcept;
+
+        /// @brief Records the stage times of the frame which was presented
+        ///        and collects GPU times of earlier frames which are ready.
+        void end_frame() noexcept;
+
+        /// @brief Drops the stage times of a frame which is not presented,
+        ///        so they are not added to the next presented frame.
+        void discard_frame() noexcept;
+
+        /// @brief Returns the percentiles of the recent frames.
+        ///        `dropped_frame_count` is left zero.
+        FrameStatistics get_statistics() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        static constexpr int m_stage_count = static_cast<int>(FrameStage::Count); ///< Number of stages.
+        static constexpr int m_gpu_stage_count = 2; ///< `Upload` and `Draw` are measured on the GPU.
+        static constexpr int m_query_frame_count = 4; ///< Frames a query result can be late before its slot is reused.
+
+        mutable std::mutex m_mutex; ///< Guards the percentiles and the counter.
+        std::array<RollingPercentiles, m_stage_count> m_cpu_percentiles{}; ///< CPU times of each stage.
+        std::array<RollingPercentiles, m_gpu_stage_count> m_gpu_percentiles{}; ///< GPU times of the measured stages.
+        uint64_t m_presented_frame_count{0}; ///< Frames ended with `end_frame`.
+
+        std::array<float, m_stage_count> m_frame_times{}; ///< CPU times of the current frame.
+        std::array<bool, m_stage_count> m_is_stage_measured{}; ///< Stages the current frame went through.
+        FrameStage m_current_stage{FrameStage::Count}; ///< Stage being measured, `Count` if none.
+        int m_nested_stage_count{0}; ///< Stages begun while `m_current_stage` runs.
+        bool m_is_query_active{false}; ///< Set while the current stage runs a timer query.
+        std::array<bool, m_gpu_stage_count> m_is_query_issued{}; ///< Stages whose query of the current frame was started.
+        clock::time_point m_stage_begin{}; ///< Start of the stage being measured.
+
+        GLuint m_queries[m_query_frame_count][m_gpu_stage_count]{}; ///< Timer queries of recent frames.
+        bool m_is_query_pending[m_query_frame_count][m_gpu_stage_count]{}; ///< Set while a query result was not read.
+        int m_query_frame_index{0}; ///< Query slot of the current frame.
+
+    };
+} // YB
+
+#endif // FRAME_PROFILER_HPP
+
+/* end_of_file */
@@ -0,0 +1,153 @@
+///
+/// @file gl_extensions.hpp
+/// @author Yasin BASAR
+/// @brief Optional OpenGL entry points which are not part of the 3.3 core profile.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef GL_EXTENSIONS_HPP
+#define GL_EXTENSIONS_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#ifndef GL_DEBUG_OUTPUT
+#define GL_DEBUG_OUTPUT 0x92E0
+#endif
+
+#ifndef GL_DEBUG_SEVERITY_HIGH
+#define GL_DEBUG_SEVERITY_HIGH 0x9146
+#endif
+
+#ifndef GL_DEBUG_SEVERITY_MEDIUM
+#define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+#endif
+
+#ifndef GL_DEBUG_SEVERITY_LOW
+#define GL_DEBUG_SEVERITY_LOW 0x9148
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class GLExtensions
+    /// @brief Loads the entry points of the extensions the library can use
+    ///        when the driver exposes them. GLAD is generated for the 3.3 core
+    ///        profile, so these are resolved through GLFW instead.
+    class GLExtensions final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        GLExtensions() noexcept = delete; ///< Deleted default constructor
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        using TexStorage2DProc = void (APIENTRY*)(GLenum target,
+                                                  GLsizei levels,
+                                                  GLenum internal_format,
+                                                  GLsizei width,
+                                                  GLsizei height);
+
+        using BufferStorageProc = void (APIENTRY*)(GLenum target,
+                                                   GLsizeiptr size,
+                                                   const void* data,
+                                                   GLbitfield flags);
+
+        using ClearTexImageProc = void (APIENTRY*)(GLuint texture,
+                                                   GLint level,
+                                                   GLenum format,
+                                                   GLenum type,
+                                                   const void* data);
+
+        using DebugProc = void (APIENTRY*)(GLenum source,
+                                           GLenum type,
+                                           GLuint id,
+                                           GLenum severity,
+                                           GLsizei length,
+                                           const GLchar* message,
+                                           const void* user_data);
+
+        using DebugMessageCallbackProc = void (APIENTRY*)(DebugProc callback,
+                                                          const void* user_data);
+
+        /// @brief Resolves the optional entry points.
+        ///        An OpenGL context must be current on the calling thread.
+        static void load() noexcept;
+
+        /// @brief Checks if the current context supports an OpenGL version
+        ///        or an extension which provides the same functionality.
+        /// @param major[in] Major core version providing the functionality
+        /// @param minor[in] Minor core version providing the functionality
+        /// @param extension[in] Extension name providing the functionality
+        /// @return true if the functionality is available
+        static bool is_supported(int major,
+                                 int minor,
+                                 const char* extension) noexcept;
+
+        static TexStorage2DProc tex_storage_2d; ///< glTexStorage2D, nullptr if not supported.
+        static BufferStorageProc buffer_storage; ///< glBufferStorage, nullptr if not supported.
+        static DebugMessageCallbackProc debug_message_callback; ///< glDebugMessageCallback, nullptr if not supported.
+        static ClearTexImageProc clear_tex_image; ///< glClearTexImage, nullptr if not supported.
+        static bool has_s3tc; ///< BC1 and BC3 textures can be created.
+        static bool has_bptc; ///< BC7 textures can be created.
+        static bool has_etc2; ///< ETC2 textures can be created.
+        static bool is_software_renderer; ///< The renderer rasterizes on the CPU, e.g. llvmpipe or SwiftShader.
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        static bool m_is_loaded; ///< A variable to not resolve entry points again for every window.
+
+    };
+} // YB
+
+#endif // GL_EXTENSIONS_HPP
+
+/* end_of_file */
@@ -0,0 +1,142 @@
+///
+/// @file gl_state_cache.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `GLStateCache` class which skips redundant OpenGL
+///        state changes of a context.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef GL_STATE_CACHE_HPP
+#define GL_STATE_CACHE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class GLStateCache
+    /// @brief Remembers the bindings, pixel store parameters and uniforms a
+    ///        context was given last and only forwards changes to OpenGL.
+    ///        Every forwarded and skipped call is counted. Code which changes
+    ///        state without the cache, or deletes bound objects, must call
+    ///        `invalidate` afterwards.
+    class GLStateCache final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        GLStateCache() noexcept; ///< Constructs a cache which knows nothing
+        ~GLStateCache() noexcept = default; ///< Default destructor
+        GLStateCache(GLStateCache &&) noexcept = delete; ///< Deleted move constructor
+        GLStateCache &operator=(GLStateCache &&) noexcept = delete; ///< Deleted move assignment operator
+        GLStateCache(const GLStateCache &) noexcept = delete; ///< Deleted copy constructor
+        GLStateCache &operator=(GLStateCache const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief glUseProgram
+        void use_program(GLuint program) noexcept;
+
+        /// @brief glActiveTexture + glBindTexture for a texture unit.
+        /// @param unit[in] Texture unit index, not `GL_TEXTURE0` based
+        /// @param target[in] `GL_TEXTURE_1D`, `GL_TEXTURE_2D` or `GL_TEXTURE_2D_ARRAY`
+        /// @param texture[in] Texture id
+        void bind_texture(int unit, GLenum target, GLuint texture) noexcept;
+
+        /// @brief glBindVertexArray
+        void bind_vertex_array(GLuint vertex_array) noexcept;
+
+        /// @brief glBindFramebuffer with `GL_FRAMEBUFFER`
+        void bind_framebuffer(GLuint framebuffer) noexcept;
+
+        /// @brief glBindBuffer with `GL_PIXEL_UNPACK_BUFFER`
+        void bind_pixel_unpack_buffer(GLuint buffer) noexcept;
+
+        /// @brief glPixelStorei for the unpack parameters
+        /// @param parameter[in] `GL_UNPACK_ALIGNMENT`, `GL_UNPACK_ROW_LENGTH`,
+        ///        `GL_UNPACK_SKIP_PIXELS` or `GL_UNPACK_SKIP_ROWS`
+        /// @param value[in] Parameter value
+        void set_unpack_parameter(GLenum parameter, GLint value) noexcept;
+
+        /// @brief glUniform1i on the current program
+        void set_uniform(GLint location, GLint value) noexcept;
+
+        /// @brief glUniform2f on the current program
+        void set_uniform(GLint location, GLfloat x, GLfloat y) noexcept;
+
+        /// @brief glUniform4f on the current program
+        void set_uniform(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) noexcept;
+
+        /// @brief Forgets the uniform values, e.g. when the program they
+        ///        were set on is replaced.
+        void invalidate_uniforms() noexcept;
+
+        /// @brief Forgets everything, the next call of each kind is forwarded.
+        void invalidate() noexcept;
+
+        /// @brief Counts OpenGL calls which are not cached, such as uploads and draws.
+        /// @param count[in] Number of calls
+        void count_calls(uint32_t count = 1) noexcept;
+
+        /// @brief Returns the call counts since the last call and resets them.
+        /// @param issued_count[out] Calls which reached OpenGL
+        /// @param skipped_count[out] Redundant calls which were skipped
+        void take_call_counts(uint32_t& issued_count, uint32_t& skipped_count) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @brief Returns the cache slot of a texture target.
+        static int get_target_index(GLenum target) noexcept;
+
+        /// @brief Counts a call as issued or skipped.
+        /// @param is_redundant[in] true if the call was skipped
+        /// @return true if the call must be forwarded
+        bool count(bool is_redundant) noexcept;
+
+        static constexpr GLuint m_unknown = 0xFFFFFFFFu; ///< Value of state which was not set through the cache.
+        static constexpr int m_unit_count = 8; ///< Texture units tracked.
+        static constexpr int m_target_count = 3; ///< Texture targets tracked.
+        static constexpr int m_unpack_parameter_count = 4; ///< Unpack parameters tracked.
+        static constexpr int m_uniform_count = 16; ///< Uniform locations tracked.
+
+        GLuint m_program; ///< Current program.
+        int m_active_unit; ///< Current texture unit, -1 if unknown.
+        GLuint m_textures[m_unit_count][m_target_count]; ///< Bound texture of each unit and target.
+        GLuint m_vertex_array; ///< Bound vertex array.
+        GLuint m_framebuffer; ///< Bound framebuffer.
+        GLuint m_pixel_unpack_buffer; ///< Bound pixel unpack buffer.
+        GLint m_unpack_parameters[m_unpack_parameter_count]; ///< Unpack parameter values.
+        bool m_is_unpack_parameter_known[m_unpack_parameter_count]; ///< Set when the value is known.
+        GLfloat m_uniforms[m_uniform_count][4]; ///< Uniform values, integers are stored as floats.
+        bool m_is_uniform_known[m_uniform_count]; ///< Set when the uniform value is known.
+        uint32_t m_issued_count; ///< Calls which reached OpenGL.
+        uint32_t m_skipped_count; ///< Redundant calls which were skipped.
+
+    };
+} // YB
+
+#endif // GL_STATE_CACHE_HPP
+
+/* end_of_file */
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <cstdint>
+#include "window_types.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Third Party Includes
@@ -29,6 +30,11 @@ struct GLFWwindow;
 
 namespace YB
 {
+    /// @brief Called when a window needs to be drawn again without a new
+    ///        frame, e.g. after a resize or a display setting change.
+    /// @param user_data[in] User data which was passed with the listener
+    using RedrawListener = void (*)(void* user_data);
+
     class IWindowProperties
     {
     public:
@@ -52,11 +58,121 @@ namespace YB
     // Public Members
     ////////////////////////////////////////////////////////////////////////////
 
-        virtual void image_show(uint8_t * data_ptr,
+        virtual void image_show(const uint8_t * data_ptr,
                                 int frame_width,
                                 int frame_height,
+                                PixelFormat format,
                                 volatile bool& t_exit_status) noexcept = 0;
 
+        virtual void image_show_regions(const uint8_t * data_ptr,
+                                        int frame_width,
+                                        int frame_height,
+                                        PixelFormat format,
+                                        const Rect* dirty_regions,
+                                        int region_count,
+                                        volatile bool& t_exit_status) noexcept = 0;
+
+        virtual bool image_show_view(const FrameView& view,
+                                     volatile bool& t_exit_status) noexcept = 0;
+
+        virtual void image_show_generation(const uint8_t* data_ptr,
+                                           int frame_width,
+                                           int frame_height,
+                                           PixelFormat format,
+                                           uint64_t generation,
+                                           volatile bool& t_exit_status) noexcept = 0;
+
+        virtual void image_show_compressed(const uint8_t* data_ptr,
+                                           int frame_width,
+                                           int frame_height,
+                                           CompressedFormat format,
+                                           volatile bool& t_exit_status) noexcept = 0;
+
+        virtual void refresh() noexcept = 0;
+
+        virtual void render_frame(const uint8_t* data_ptr,
+                                  int frame_width,
+                                  int frame_height,
+                                  PixelFormat format) noexcept = 0;
+
+        virtual void upload_frame(const uint8_t* data_ptr,
+                                  int frame_width,
+                                  int frame_height,
+                                  PixelFormat format) noexcept = 0;
+
+        virtual void draw_frame() noexcept = 0;
+
+        virtual void swap_buffers() noexcept = 0;
+
+        virtual void set_swap_interval(int interval) noexcept = 0;
+
+        virtual void set_grouped(bool is_grouped) noexcept = 0;
+
+        virtual uint8_t* acquire_frame(int frame_width,
+                                       int frame_height,
+                                       PixelFormat format) noexcept = 0;
+
+        virtual void submit_acquired_frame(volatile bool& t_exit_status) noexcept = 0;
+
+        virtual void set_display_range(float minimum, float maximum) noexcept = 0;
+
+        virtual void set_auto_display_range() noexcept = 0;
+
+        virtual void set_colormap(Colormap colormap) = 0;
+
+        virtual void set_custom_colormap(const uint8_t* rgba_entries,
+                                         int entry_count) = 0;
+
+        virtual void set_view(float zoom, float center_x, float center_y) noexcept = 0;
+
+        virtual bool set_tile_source(const TileSource& source, size_t memory_budget) = 0;
+
+        virtual void tiled_image_show(volatile bool& t_exit_status) = 0;
+
+        virtual bool set_mosaic(const MosaicLayout& layout) = 0;
+
+        virtual bool update_mosaic_tile(int tile_index, const uint8_t* data_ptr) noexcept = 0;
+
+        virtual void mosaic_show(volatile bool& t_exit_status) = 0;
+
+        virtual void set_aspect_mode(AspectMode aspect_mode) noexcept = 0;
+
+        virtual void set_overlay(const Overlay& overlay) = 0;
+
+        virtual void set_change_detection(bool is_enabled) noexcept = 0;
+
+        virtual void set_compressed_upload(CompressedUpload compressed_upload) noexcept = 0;
+
+        virtual bool is_compressed_upload_native(CompressedFormat format) const noexcept = 0;
+
+        virtual UploadStatistics get_upload_statistics() const noexcept = 0;
+
+        virtual bool pop_event(WindowEvent& event) noexcept = 0;
+
+        virtual FrameStatistics get_frame_statistics() const noexcept = 0;
+
+        virtual bool read_pixels(uint8_t* rgba_ptr) noexcept = 0;
+
+        virtual bool start_capture(const CaptureSettings& settings) = 0;
+
+        virtual void flush_capture() noexcept = 0;
+
+        virtual void stop_capture() noexcept = 0;
+
+        virtual CaptureStatistics get_capture_statistics() const noexcept = 0;
+
+        virtual void set_pacing(const PacingSettings& settings) noexcept = 0;
+
+        virtual PacingStatistics get_pacing_statistics() const noexcept = 0;
+
+        virtual void make_context_current() noexcept = 0;
+
+        virtual void release_context() noexcept = 0;
+
+        virtual void set_redraw_listener(RedrawListener listener, void* user_data) noexcept = 0;
+
+        virtual bool should_close() const noexcept = 0;
+
     ////////////////////////////////////////////////////////////////////////////
     // Private Members
     ////////////////////////////////////////////////////////////////////////////
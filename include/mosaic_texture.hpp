@@ -0,0 +1,119 @@
+///
+/// @file mosaic_texture.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `MosaicTexture` class which keeps the streams of a
+///        mosaic window in the layers of one texture array.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef MOSAIC_TEXTURE_HPP
+#define MOSAIC_TEXTURE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gl_state_cache.hpp"
+#include "pixel_format.hpp"
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class MosaicTexture
+    /// @brief `GL_TEXTURE_2D_ARRAY` with one layer per tile of a mosaic grid.
+    ///        Tiles are updated one at a time as their streams deliver frames
+    ///        and the grid is drawn as instances of the image quad, the
+    ///        instance index selects the layer. The context which owns the
+    ///        texture must be current for every call.
+    class MosaicTexture final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        MosaicTexture() noexcept; ///< Constructs a disabled mosaic
+        ~MosaicTexture() noexcept = default; ///< Default destructor, `release` must be called before
+        MosaicTexture(MosaicTexture &&) noexcept = delete; ///< Deleted move constructor
+        MosaicTexture &operator=(MosaicTexture &&) noexcept = delete; ///< Deleted move assignment operator
+        MosaicTexture(const MosaicTexture &) noexcept = delete; ///< Deleted copy constructor
+        MosaicTexture &operator=(MosaicTexture const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Texture unit the array is bound to, the plane and colormap
+        ///        units stay untouched.
+        static constexpr int texture_unit = 4;
+
+        /// @brief Releases the previous texture array and allocates one for a
+        ///        new grid. Every tile starts black.
+        /// @param layout[in] Grid layout, 0 columns disables the mosaic
+        /// @param gl_state[in,out] State cache of the owning context
+        /// @return false if the layout is invalid or too large for the driver
+        bool configure(const MosaicLayout& layout, GLStateCache& gl_state);
+
+        /// @brief Deletes the texture array.
+        void release() noexcept;
+
+        /// @brief Checks if a grid is configured.
+        /// @return true if the mosaic can be drawn
+        bool is_enabled() const noexcept;
+
+        /// @brief Returns the configured grid.
+        /// @return Grid layout
+        const MosaicLayout& get_layout() const noexcept;
+
+        /// @brief Returns the layout of a single tile.
+        /// @return Image layout of one stream frame
+        const ImageLayout& get_tile_layout() const noexcept;
+
+        /// @brief Returns the texture array.
+        /// @return Texture name, 0 if the mosaic is disabled
+        GLuint get_texture() const noexcept;
+
+        /// @brief Uploads a stream frame into the layer of its tile.
+        /// @param tile_index[in] Row major tile index
+        /// @param data_ptr[in] Frame of the grid's tile size and format
+        /// @param gl_state[in,out] State cache of the owning context
+        /// @return false if the mosaic is disabled or the index is out of the grid
+        bool update_tile(int tile_index,
+                         const uint8_t* data_ptr,
+                         GLStateCache& gl_state) noexcept;
+
+        /// @brief Switches the minification filter and rebuilds the mipmaps
+        ///        of every layer after tiles changed while the grid is minified.
+        /// @param is_minified[in] Tiles are drawn smaller than their resolution
+        /// @param gl_state[in,out] State cache of the owning context
+        void update_mipmaps(bool is_minified, GLStateCache& gl_state) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        MosaicLayout m_layout; ///< Configured grid, 0 columns while disabled.
+        ImageLayout m_tile_layout; ///< Layout of one stream frame.
+        GLuint m_texture; ///< Texture array, one layer per tile.
+        bool m_is_mipmap_filter; ///< Set while the layers are minified through mipmaps.
+        bool m_are_mipmaps_dirty; ///< Set when a layer changed after the mipmaps were built.
+
+    };
+} // YB
+
+#endif // MOSAIC_TEXTURE_HPP
+
+/* end_of_file */
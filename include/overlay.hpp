@@ -0,0 +1,76 @@
+///
+/// @file overlay.hpp
+/// @author Yasin BASAR
+/// @brief Converts overlay primitives into the instances of the overlay
+///        shader and builds its glyph atlas.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef OVERLAY_HPP
+#define OVERLAY_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @enum OverlayKind
+    /// @brief Shapes the overlay shader expands an instance into.
+    enum class OverlayKind : uint8_t
+    {
+        Line, ///< Segment between two image points, window pixel thickness.
+        Rect, ///< Filled rectangle between two image corners.
+        Point, ///< Disc around an image point, window pixel diameter.
+        Glyph ///< Atlas cell at an image point plus a window pixel offset.
+    };
+
+    /// @struct OverlayInstance
+    /// @brief Vertex attributes of one instanced overlay quad.
+    struct OverlayInstance
+    {
+        float position[4]; ///< Line ends, rect corners, point center or glyph anchor and pixel offset.
+        float extent[4]; ///< Thickness, diameter or glyph pixel size and atlas cell, kind in the last entry.
+        uint8_t color[4]; ///< RGBA, normalized by the shader.
+    };
+
+    /// @brief Glyph edge length in atlas texels.
+    constexpr int glyph_size = 8;
+
+    /// @brief Atlas cells per row, cells cover ASCII 32 to 127.
+    constexpr int glyph_atlas_columns = 16;
+
+    /// @brief Atlas cell rows.
+    constexpr int glyph_atlas_rows = 6;
+
+    /// @brief Builds the single channel glyph atlas. The cell of ASCII 127
+    ///        is solid and used for text backgrounds.
+    /// @return `glyph_atlas_columns * glyph_atlas_rows * glyph_size^2` bytes,
+    ///         top row first
+    std::vector<uint8_t> make_glyph_atlas();
+
+    /// @brief Appends the instances of every primitive of an overlay.
+    ///        Box outlines become four lines and text one glyph per character.
+    /// @param overlay[in] Overlay primitives
+    /// @param instances[in,out] Instance list
+    void append_overlay_instances(const Overlay& overlay,
+                                  std::vector<OverlayInstance>& instances);
+
+} // YB
+
+#endif // OVERLAY_HPP
+
+/* end_of_file */
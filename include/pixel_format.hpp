@@ -0,0 +1,147 @@
+///
+/// @file pixel_format.hpp
+/// @author Yasin BASAR
+/// @brief Describes how each `PixelFormat` is stored in textures.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef PIXEL_FORMAT_HPP
+#define PIXEL_FORMAT_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include "window_types.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @enum SamplingLayout
+    /// @brief Tells the fragment shader how to turn the plane textures
+    ///        into RGB. Values match `u_sampling_layout` in the shader.
+    enum class SamplingLayout : int
+    {
+        Interleaved = 0, ///< Plane 0 already holds RGBA.
+        SemiPlanarYuv = 1, ///< Plane 0 holds Y, plane 1 holds UV.
+        PlanarYuv = 2, ///< Plane 0 holds Y, plane 1 holds U, plane 2 holds V.
+        PackedYuyv = 3, ///< Plane 0 holds Y0 U Y1 V in each texel.
+        Scalar = 4 ///< Plane 0 holds one value, mapped through the display
+                   ///< range and the colormap.
+    };
+
+    /// @struct PlaneLayout
+    /// @brief Texture and upload parameters of one plane of an image.
+    struct PlaneLayout
+    {
+        GLint internal_format; ///< Texture storage format.
+        GLenum upload_format; ///< Client pixel format of the plane.
+        GLenum upload_type; ///< Client data type of the plane.
+        int width; ///< Plane width in texels.
+        int height; ///< Plane height in texels.
+        int bytes_per_texel; ///< Size of one client texel in bytes.
+        size_t row_pitch; ///< Bytes from the start of one plane row to the next.
+        size_t offset; ///< Byte offset of the plane inside the image buffer.
+    };
+
+    /// @struct ImageLayout
+    /// @brief All planes of an image and how they are sampled.
+    struct ImageLayout
+    {
+        static constexpr int max_plane_count = 3; ///< Most planes any format has.
+
+        PlaneLayout planes[max_plane_count]; ///< Plane descriptions.
+        int plane_count; ///< Number of valid entries in `planes`, 0 if the format can not store the size.
+        SamplingLayout sampling_layout; ///< How the shader combines the planes.
+        float value_scale; ///< Converts a client value to the value the shader samples.
+        float default_minimum; ///< Client value shown black when no display range is set.
+        float default_maximum; ///< Client value shown white when no display range is set.
+        size_t frame_size; ///< Bytes from the buffer start to the end of the last plane row.
+    };
+
+    /// @brief Computes plane layouts of an image.
+    /// @param format[in] Pixel format of the image
+    /// @param frame_width[in] Image Width
+    /// @param frame_height[in] Image Height
+    /// @param row_pitch[in] Bytes between rows of plane 0, 0 for tightly
+    ///        packed rows. See `FrameView` for the pitch of chroma planes.
+    /// @return Layout of the image, without planes for an odd `YUYV` width
+    ImageLayout get_image_layout(PixelFormat format,
+                                 int frame_width,
+                                 int frame_height,
+                                 size_t row_pitch = 0) noexcept;
+
+    /// @brief Computes the layout of the region a frame view shows. Plane
+    ///        offsets point at the first texel of the region inside the
+    ///        view's buffer and keep the buffer's row pitches.
+    /// @param view[in] Frame view
+    /// @param layout[out] Layout of the shown region
+    /// @return false if the pitch is too small for the buffer width, the
+    ///         region is outside the buffer or splits subsampled texels
+    bool get_view_layout(const FrameView& view, ImageLayout& layout) noexcept;
+
+    /// @brief Checks if two layouts place every plane at the same offset
+    ///        with the same row pitch.
+    /// @param lhs[in] First layout
+    /// @param rhs[in] Second layout
+    /// @return true if the same buffer is read the same way through both
+    bool is_same_storage(const ImageLayout& lhs, const ImageLayout& rhs) noexcept;
+
+    /// @brief Finds the unpack row length and alignment which make OpenGL
+    ///        step from one row of a plane to the next by its row pitch.
+    /// @param plane[in] Plane layout
+    /// @param row_length[out] Value of `GL_UNPACK_ROW_LENGTH` in texels
+    /// @param alignment[out] Value of `GL_UNPACK_ALIGNMENT`
+    /// @return false if no combination matches, rows must be uploaded one by one
+    bool get_unpack_row_length(const PlaneLayout& plane,
+                               int& row_length,
+                               int& alignment) noexcept;
+
+    /// @brief Converts a region of an image to the matching region of one of
+    ///        its planes. Subsampled planes get the smallest covering region.
+    /// @param plane[in] Plane layout
+    /// @param region[in] Region in image pixels
+    /// @param frame_width[in] Image Width
+    /// @param frame_height[in] Image Height
+    /// @return Region in plane texels
+    Rect get_plane_region(const PlaneLayout& plane,
+                          const Rect& region,
+                          int frame_width,
+                          int frame_height) noexcept;
+
+    /// @brief Finds the smallest and the largest value of a single channel
+    ///        image. Only every 4th row and column is visited, which keeps
+    ///        automatic display ranges cheap enough to run for every frame.
+    /// @param data_ptr[in] Image buffer pointer
+    /// @param format[in] Pixel format of the image, must be a single channel format
+    /// @param frame_width[in] Image Width
+    /// @param frame_height[in] Image Height
+    /// @param row_pitch[in] Bytes between rows
+    /// @param minimum[out] Smallest visited value
+    /// @param maximum[out] Largest visited value
+    /// @return false if the format is not a single channel format
+    bool find_value_range(const uint8_t* data_ptr,
+                          PixelFormat format,
+                          int frame_width,
+                          int frame_height,
+                          size_t row_pitch,
+                          float& minimum,
+                          float& maximum) noexcept;
+
+} // YB
+
+#endif // PIXEL_FORMAT_HPP
+
+/* end_of_file */
@@ -0,0 +1,151 @@
+///
+/// @file playback_source.hpp
+/// @author Yasin BASAR
+/// @brief Plays recorded raw and Y4M frame files from a memory mapping.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef PLAYBACK_SOURCE_HPP
+#define PLAYBACK_SOURCE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "window_creator.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @struct RawFileLayout
+    /// @brief Describes a file of frames without a self describing header,
+    ///        e.g. a raw RGBA dump or a capture with a header per frame.
+    struct RawFileLayout
+    {
+        int frame_width; ///< Image Width
+        int frame_height; ///< Image Height
+        PixelFormat format; ///< Memory layout of every frame.
+        double frame_rate; ///< Frames per second when frames carry no timestamp.
+        size_t file_header_size; ///< Bytes skipped at the start of the file.
+        size_t frame_header_size; ///< Bytes before every frame. With 8 or more, the first 8 bytes
+                                  ///< hold the capture time in microseconds, little endian,
+                                  ///< and frames are paced by it instead of `frame_rate`.
+    };
+
+    /// @class PlaybackSource
+    /// @brief Maps a recorded file into memory and hands out frames straight
+    ///        from the mapping, so captures larger than the RAM can be played.
+    ///        The frames after the current one are read ahead and the ones
+    ///        already shown are dropped from the working set. `next_frame`
+    ///        paces frames at their recorded times.
+    class DLL_SPECS PlaybackSource
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        PlaybackSource() noexcept = delete; ///< Deleted default constructor
+        PlaybackSource(PlaybackSource &&) noexcept = delete; ///< Deleted move constructor
+        PlaybackSource &operator=(PlaybackSource &&) noexcept = delete; ///< Deleted move assignment operator
+        PlaybackSource(const PlaybackSource &) noexcept = delete; ///< Deleted copy constructor
+        PlaybackSource &operator=(PlaybackSource &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Opens a YUV4MPEG2 file. 8 bit 4:2:0 files are played as
+        ///        `I420` and 8 bit monochrome files as `Gray`, deeper
+        ///        colorspaces such as `420p10` are rejected. Every frame
+        ///        must have the same frame header. Throws `std::runtime_error`
+        ///        if the file can not be mapped or its header is not supported.
+        /// @param file_path[in] Path of the Y4M file
+        explicit PlaybackSource(const char* file_path);
+
+        /// @brief Opens a raw frame file. Throws `std::runtime_error` if the
+        ///        file can not be mapped or the layout is invalid.
+        /// @param file_path[in] Path of the raw file
+        /// @param layout[in] Frame size, format and headers of the file
+        PlaybackSource(const char* file_path, const RawFileLayout& layout);
+
+        /// @brief Unmaps the file. Frames handed out are invalid afterwards.
+        ~PlaybackSource() noexcept;
+
+        /// @return Image Width
+        int get_frame_width() const noexcept;
+
+        /// @return Image Height
+        int get_frame_height() const noexcept;
+
+        /// @return Memory layout of the frames
+        PixelFormat get_format() const noexcept;
+
+        /// @return Number of complete frames in the file
+        size_t get_frame_count() const noexcept;
+
+        /// @brief Returns the recorded time of a frame.
+        /// @param frame_index[in] Frame index
+        /// @return Seconds since the first frame, 0 for frames recorded before it
+        double get_timestamp(size_t frame_index) const noexcept;
+
+        /// @brief Returns a frame and reads the following ones ahead.
+        /// @param frame_index[in] Frame index
+        /// @return Frame inside the mapping, valid while the source exists,
+        ///         nullptr if the index is out of range
+        const uint8_t* get_frame(size_t frame_index) noexcept;
+
+        /// @brief Moves playback to a frame. Pacing restarts from it.
+        /// @param frame_index[in] Frame `next_frame` returns next
+        void seek(size_t frame_index) noexcept;
+
+        /// @brief Scales the playback speed, 2 plays twice as fast.
+        ///        Pacing restarts from the next frame.
+        /// @param speed[in] Speed factor, greater than zero
+        void set_speed(double speed) noexcept;
+
+        /// @brief Waits until the recorded time of the next frame relative
+        ///        to the first played frame and returns it. A source which
+        ///        falls more than a second behind restarts its pacing
+        ///        instead of rushing to catch up.
+        /// @return Next frame, nullptr after the last frame
+        const uint8_t* next_frame() noexcept;
+
+        /// @brief Shows every remaining frame in a window at its recorded time.
+        /// @param window[in] Window to show the frames in
+        /// @param exit_status[out] Set when the window is closed
+        void play(const WindowCreator& window, volatile bool& exit_status) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        class Impl; ///< Implementation class
+        std::unique_ptr<Impl> p_impl; ///< Pointer to implementation class
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Protected Members
+    ////////////////////////////////////////////////////////////////////////////
+    protected:
+
+        // Data
+
+    };
+} // YB
+
+#endif // PLAYBACK_SOURCE_HPP
+
+/* End of File */
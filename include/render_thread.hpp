@@ -0,0 +1,142 @@
+///
+/// @file render_thread.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `RenderThread` class which presents submitted frames
+///        of a window asynchronously.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "i_window_properties.hpp"
+#include "spsc_queue.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class RenderThread
+    /// @brief Owns the context of a window and presents the frames
+    ///        pushed by a single producer thread.
+    class RenderThread final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        RenderThread() noexcept = delete; ///< Deleted default constructor
+        RenderThread(RenderThread &&) noexcept = delete; ///< Deleted move constructor
+        RenderThread &operator=(RenderThread &&) noexcept = delete; ///< Deleted move assignment operator
+        RenderThread(const RenderThread &) noexcept = delete; ///< Deleted copy constructor
+        RenderThread &operator=(RenderThread const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Detaches the window's context from the calling thread
+        ///        and starts the render thread.
+        /// @param window_properties[in] Window which will be rendered
+        /// @param policy[in] How submitted frames are consumed
+        RenderThread(IWindowProperties& window_properties,
+                     PresentPolicy policy);
+
+        /// @brief Stops the render thread and releases pending frames.
+        ~RenderThread() noexcept;
+
+        /// @brief Queues a frame for presentation without blocking. In mailbox
+        ///        mode it replaces the pending frame, which is released here.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        /// @param release_callback[in] Called when the buffer can be reused, can be nullptr
+        /// @param user_data[in] Passed to the release callback
+        /// @return false if the fifo queue is full, the buffer is not used then
+        bool submit(const uint8_t* data_ptr,
+                    int frame_width,
+                    int frame_height,
+                    PixelFormat format,
+                    FrameReleaseCallback release_callback,
+                    void* user_data) noexcept;
+
+        /// @brief Returns the number of frames which were never presented.
+        uint64_t get_dropped_frame_count() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @struct FrameSlot
+        /// @brief A submitted frame waiting in the queue.
+        struct FrameSlot
+        {
+            const uint8_t* data_ptr; ///< Image buffer pointer.
+            int frame_width; ///< Image Width
+            int frame_height; ///< Image Height
+            PixelFormat format; ///< Memory layout of the image buffer.
+            FrameReleaseCallback release_callback; ///< Called when the buffer can be reused.
+            void* user_data; ///< Passed to the release callback.
+        };
+
+        /// @brief Render loop which runs on the render thread.
+        void run() noexcept;
+
+        /// @brief Takes the next frame to present. Render thread side.
+        /// @param frame[out] Frame to present
+        /// @return false if no frame is pending
+        bool take_frame(FrameSlot& frame) noexcept;
+
+        /// @brief Checks if the render thread has work to do.
+        ///        `m_wake_mutex` must be locked.
+        /// @return true if a frame is pending, a refresh was requested or
+        ///         the thread is stopping
+        bool is_awake() const noexcept;
+
+        /// @brief Wakes the render thread to redraw the window. Registered
+        ///        as the window's redraw listener.
+        /// @param user_data[in] The render thread
+        static void request_refresh(void* user_data) noexcept;
+
+        /// @brief Hands a buffer back to its producer.
+        /// @param frame[in] Frame whose buffer is not needed anymore
+        static void release(const FrameSlot& frame) noexcept;
+
+        static constexpr size_t m_queue_capacity = 4; ///< Number of frames which can wait for presentation.
+        IWindowProperties& m_window_properties; ///< Window which is rendered.
+        PresentPolicy m_policy; ///< How submitted frames are consumed.
+        SpscQueue<FrameSlot, m_queue_capacity> m_queue; ///< Frames waiting for presentation in fifo mode.
+        std::atomic<bool> m_is_running; ///< Cleared to stop the render loop, written with `m_wake_mutex` locked.
+        std::atomic<uint64_t> m_dropped_frame_count; ///< Frames which were never presented.
+        std::mutex m_wake_mutex; ///< Guards the mailbox and the refresh request, orders wakeups of the render thread.
+        std::condition_variable m_wake_condition; ///< Signaled on a submit, a refresh request and a stop.
+        FrameSlot m_mailbox_frame; ///< Latest frame in mailbox mode, guarded by `m_wake_mutex`.
+        bool m_has_mailbox_frame; ///< Set while `m_mailbox_frame` waits, guarded by `m_wake_mutex`.
+        bool m_is_refresh_requested; ///< Set when the window needs a redraw, guarded by `m_wake_mutex`.
+        std::thread m_thread; ///< Render thread.
+
+    };
+} // YB
+
+#endif // RENDER_THREAD_HPP
+
+/* end_of_file */
@@ -0,0 +1,116 @@
+///
+/// @file spsc_queue.hpp
+/// @author Yasin BASAR
+/// @brief Lock-free single producer single consumer ring queue.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class SpscQueue
+    /// @brief Fixed capacity ring queue. `push` must only be called from one
+    ///        thread and `pop` must only be called from one other thread.
+    /// @tparam T Trivially copyable item type
+    /// @tparam Capacity Number of items, must be a power of two
+    template <typename T, size_t Capacity>
+    class SpscQueue final
+    {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                      "SpscQueue capacity must be a power of two");
+
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        SpscQueue() noexcept = default; ///< Default constructor
+        SpscQueue(SpscQueue &&) noexcept = delete; ///< Deleted move constructor
+        SpscQueue &operator=(SpscQueue &&) noexcept = delete; ///< Deleted move assignment operator
+        SpscQueue(const SpscQueue &) noexcept = delete; ///< Deleted copy constructor
+        SpscQueue &operator=(SpscQueue const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Appends an item to the queue. Producer side.
+        /// @param item[in] Item to append
+        /// @return false if the queue is full
+        bool push(const T& item) noexcept
+        {
+            const size_t head = this->m_head.load(std::memory_order_relaxed);
+            const size_t tail = this->m_tail.load(std::memory_order_acquire);
+
+            if (head - tail == Capacity)
+            {
+                return false;
+            }
+
+            this->m_items[head & (Capacity - 1)] = item;
+            this->m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// @brief Removes the oldest item from the queue. Consumer side.
+        /// @param item[out] Removed item
+        /// @return false if the queue is empty
+        bool pop(T& item) noexcept
+        {
+            const size_t tail = this->m_tail.load(std::memory_order_relaxed);
+            const size_t head = this->m_head.load(std::memory_order_acquire);
+
+            if (head == tail)
+            {
+                return false;
+            }
+
+            item = this->m_items[tail & (Capacity - 1)];
+            this->m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /// @brief Checks if the queue has no items. Consumer side.
+        /// @return true if `pop` would fail
+        bool is_empty() const noexcept
+        {
+            return this->m_head.load(std::memory_order_acquire)
+                == this->m_tail.load(std::memory_order_relaxed);
+        }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        alignas(64) std::atomic<size_t> m_head{0}; ///< Next write position, owned by the producer.
+        alignas(64) std::atomic<size_t> m_tail{0}; ///< Next read position, owned by the consumer.
+        T m_items[Capacity]{}; ///< Item storage.
+
+    };
+} // YB
+
+#endif // SPSC_QUEUE_HPP
+
+/* end_of_file */
@@ -0,0 +1,158 @@
+///
+/// @file tile_cache.hpp
+/// @author Yasin BASAR
+/// @brief Defines the `TileCache` class which keeps the recently displayed
+///        tiles of a tiled image in textures.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "gl_state_cache.hpp"
+#include "pixel_format.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class TileCache
+    /// @brief GPU cache of the tiles of a `TileSource`. Every tile has its
+    ///        own texture and the least recently used tile is evicted once
+    ///        the memory budget is reached. Tiles used by the current frame
+    ///        are never evicted. The context which owns the textures must be
+    ///        current for every call.
+    class TileCache final
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        TileCache() noexcept; ///< Constructs a cache without a source
+        ~TileCache() noexcept = default; ///< Default destructor, `release` must be called before
+        TileCache(TileCache &&) noexcept = delete; ///< Deleted move constructor
+        TileCache &operator=(TileCache &&) noexcept = delete; ///< Deleted move assignment operator
+        TileCache(const TileCache &) noexcept = delete; ///< Deleted copy constructor
+        TileCache &operator=(TileCache const &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Releases the tiles of the previous source and starts
+        ///        caching a new one.
+        /// @param source[in] Tile source, `read_tile` nullptr disables the cache
+        /// @param memory_budget[in] Most bytes the tile textures can use
+        /// @return false if the source can not be displayed
+        bool configure(const TileSource& source, size_t memory_budget);
+
+        /// @brief Deletes every tile texture and forgets the source. State
+        ///        caches of the context must be invalidated afterwards.
+        void release() noexcept;
+
+        /// @brief Checks if a source is set.
+        /// @return true if tiles can be requested
+        bool is_enabled() const noexcept;
+
+        /// @brief Returns the current source.
+        /// @return Source given to `configure`
+        const TileSource& get_source() const noexcept;
+
+        /// @brief Returns the layout of a tile.
+        /// @return Single plane layout of `tile_size` x `tile_size` pixels
+        const ImageLayout& get_tile_layout() const noexcept;
+
+        /// @brief Looks up a resident tile and marks it as used by a frame.
+        /// @param level[in] Pyramid level
+        /// @param tile_x[in] Tile column
+        /// @param tile_y[in] Tile row
+        /// @param frame_index[in] Frame which draws the tile
+        /// @return Texture of the tile, 0 if it is not resident
+        GLuint find(int level, int tile_x, int tile_y, uint64_t frame_index) noexcept;
+
+        /// @brief Reads a tile from the source and uploads it, evicting the
+        ///        least recently used tile when the budget is reached. Edge
+        ///        pixels of tiles at the right and bottom of the level are
+        ///        replicated outward.
+        /// @param level[in] Pyramid level
+        /// @param tile_x[in] Tile column
+        /// @param tile_y[in] Tile row
+        /// @param frame_index[in] Frame which draws the tile
+        /// @param gl_state[in] State cache of the current context
+        /// @return Texture of the tile, 0 if the source failed or every
+        ///         resident tile is used by the frame
+        GLuint load(int level,
+                    int tile_x,
+                    int tile_y,
+                    uint64_t frame_index,
+                    GLStateCache& gl_state);
+
+        /// @brief Returns the number of resident tiles.
+        /// @return Tile count
+        size_t get_tile_count() const noexcept;
+
+        /// @brief Returns the size of an image dimension at a pyramid level.
+        /// @param size[in] Full resolution size
+        /// @param level[in] Pyramid level
+        /// @return Size halved `level` times, rounded up
+        static int get_level_size(int size, int level) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        /// @struct Tile
+        /// @brief Resident tile.
+        struct Tile
+        {
+            uint64_t key; ///< Level and position, see `make_key`.
+            GLuint texture; ///< Texture holding the tile.
+            uint64_t frame_index; ///< Last frame which used the tile, unused while `key` is `m_free_key`.
+        };
+
+        /// @brief Packs a tile address into a cache key.
+        static uint64_t make_key(int level, int tile_x, int tile_y) noexcept;
+
+        /// @brief Copies the last column and row of an edge tile inside the
+        ///        level into the column and row after them, so linear
+        ///        filtering at the image edge does not blend in unused texels.
+        /// @param valid_width[in] Tile columns inside the level
+        /// @param valid_height[in] Tile rows inside the level
+        void replicate_tile_edges(int valid_width, int valid_height) noexcept;
+
+        /// @brief Creates a tile texture with the storage of a full tile.
+        /// @param gl_state[in] State cache of the current context
+        /// @return Texture id
+        GLuint create_tile_texture(GLStateCache& gl_state) const noexcept;
+
+        static constexpr uint64_t m_free_key = ~uint64_t{0}; ///< Key of a texture without a tile, no tile address maps to it.
+        TileSource m_source; ///< Current source.
+        ImageLayout m_tile_layout; ///< Layout of one tile.
+        size_t m_capacity; ///< Most resident tiles within the memory budget.
+        std::list<Tile> m_tiles; ///< Resident tiles, most recently used first.
+        std::unordered_map<uint64_t, std::list<Tile>::iterator> m_index; ///< Resident tiles by key.
+        std::vector<uint8_t> m_staging; ///< Buffer the source writes a tile into.
+
+    };
+} // YB
+
+#endif // TILE_CACHE_HPP
+
+/* end_of_file */
@@ -26,8 +26,10 @@
 // Project Includes
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include "window_types.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Third Party Includes
@@ -41,6 +43,9 @@ struct GLFWwindow;
 
 namespace YB
 {
+    class IWindowProperties;
+    class WindowGroup;
+
     /// @class Window
     /// @brief
     class DLL_SPECS WindowCreator
@@ -66,15 +71,21 @@ namespace YB
         /// @param window_height[in] Window Height
         /// @param cap_to_screen_frame_rate[in] Set false this parameter for unlimited framerate,
         /// otherwise window's framerate will be capped to the screen's framerate.
+        /// `set_pacing` offers adaptive vsync, a target frame rate and a low latency mode.
+        /// @param upload_mode[in] Texture upload strategy, see `UploadMode`.
+        /// @param surface_mode[in] Visible window or offscreen rendering, see `SurfaceMode`.
         WindowCreator(const char* window_name,
                       int window_width,
                       int window_height,
-                      bool cap_to_screen_frame_rate);
+                      bool cap_to_screen_frame_rate,
+                      UploadMode upload_mode = UploadMode::Direct,
+                      SurfaceMode surface_mode = SurfaceMode::Window);
 
         /// @brief Destructs window creator object.
         ~WindowCreator() noexcept;
 
-	    /// @brief It runs window render cycle
+	    /// @brief It runs window render cycle.
+	    ///        Does nothing while a render thread runs, use `submit_frame` then.
 	    /// @param data_ptr[in] Image buffer pointer. Only 4 channel images acceptable.
 	    /// @param frame_width[in] Image Width
 	    /// @param frame_height[in] Image Height
@@ -84,11 +95,367 @@ namespace YB
 	                    int frame_height,
 	                    volatile bool& exit_status) const noexcept;
 
+        /// @brief It runs window render cycle for an image in any supported
+        ///        pixel format. Conversion to RGB happens on the GPU.
+        ///        Does nothing while a render thread runs, use `submit_frame` then.
+        /// @param data_ptr[in] Image buffer pointer. Planes of planar formats
+        ///        must follow each other in this buffer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer, see `PixelFormat`
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        PixelFormat format,
+                        volatile bool& exit_status) const noexcept;
+
+        /// @brief It runs window render cycle and uploads only the given
+        ///        regions of the image, the rest of the displayed image is
+        ///        kept from the previous frames.
+        ///        Does nothing while a render thread runs, use `submit_frame` then.
+        /// @param data_ptr[in] Image buffer pointer, the whole frame.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer, see `PixelFormat`
+        /// @param dirty_regions[in] Changed regions in image pixels, they are
+        ///        clipped to the image. The whole frame is uploaded when the
+        ///        resolution or the format changes.
+        /// @param region_count[in] Number of regions. With 0 nothing is uploaded,
+        ///        and unless a resize, an expose or a display setting changed
+        ///        nothing is drawn or presented either, the call only waits
+        ///        like a present in the frame pacer.
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        PixelFormat format,
+                        const Rect* dirty_regions,
+                        int region_count,
+                        volatile bool& exit_status) const noexcept;
+
+        /// @brief It runs window render cycle for an image inside a larger or
+        ///        padded buffer, e.g. a camera frame with aligned rows or a
+        ///        crop of a bigger picture. Rows are read in place through
+        ///        the unpack row length, skip and alignment parameters.
+        ///        Does nothing while a render thread runs, use `submit_frame` then.
+        /// @param view[in] Buffer, its row pitch and the region to show
+        /// @param exit_status[out] Use it to end your render loop
+        /// @return false if the pitch is smaller than a row, the region is
+        ///         outside the buffer or splits subsampled pixels, or while
+        ///         a render thread runs
+        bool image_show(const FrameView& view,
+                        volatile bool& exit_status) const noexcept;
+
+        /// @brief It runs window render cycle for a frame the caller tags with
+        ///        a generation, e.g. a counter it bumps whenever the buffer is
+        ///        rewritten. Showing the resident generation again reads no
+        ///        pixels, and unless a resize, an expose or a display setting
+        ///        changed it neither draws nor swaps. The call is still paced
+        ///        like a present, so a status window which shows the same
+        ///        buffer in a loop stays idle.
+        ///        Does nothing while a render thread runs, use `submit_frame` then.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer, see `PixelFormat`
+        /// @param generation[in] Content generation, 0 if unknown (always uploaded)
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        PixelFormat format,
+                        uint64_t generation,
+                        volatile bool& exit_status) const noexcept;
+
+        /// @brief It runs window render cycle for a block compressed image,
+        ///        e.g. a tile or an asset stored as BC or ETC2 blocks. The
+        ///        blocks are uploaded as they are when the driver samples the
+        ///        format, which moves 4 to 8 times fewer bytes than RGBA.
+        ///        Otherwise they are decoded to RGBA on the CPU first, see
+        ///        `set_compressed_upload` to choose the path.
+        ///        Does nothing while a render thread runs, use `submit_frame` then.
+        /// @param data_ptr[in] Compressed image, rows of 4x4 blocks without padding
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Compressed format of the image, see `CompressedFormat`
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        CompressedFormat format,
+                        volatile bool& exit_status) const noexcept;
+
+        /// @brief Checks if the driver samples a compressed format, frames
+        ///        of unsupported formats are decoded on the CPU.
+        /// @param format[in] Compressed format
+        /// @return true if compressed frames are uploaded without decoding
+        bool is_compressed_format_supported(CompressedFormat format) const noexcept;
+
+        /// @brief Selects whether compressed frames are uploaded as blocks or
+        ///        decoded to RGBA on the CPU. `Auto` uploads blocks unless the
+        ///        renderer is a software rasterizer, where sampling them costs
+        ///        more than decoding them once; run `window_creator_bench` on
+        ///        the target to compare both paths.
+        /// @param compressed_upload[in] Auto by default
+        void set_compressed_upload(CompressedUpload compressed_upload) const noexcept;
+
+        /// @brief Checks which path the next compressed frame of a format
+        ///        takes with the current `set_compressed_upload` setting.
+        /// @param format[in] Compressed format
+        /// @return true if frames are uploaded as blocks, false if decoded
+        bool is_compressed_upload_native(CompressedFormat format) const noexcept;
+
+        /// @brief Draws the last shown content again from the resident
+        ///        textures if a resize, an expose or a display setting asks
+        ///        for it, without a new frame. Expose events are redrawn on
+        ///        their own while this window's context is current, and a
+        ///        render thread refreshes its window while it waits.
+        void refresh() const noexcept;
+
+        /// @brief Enables change detection for frames shown without dirty
+        ///        regions. Each frame is compared with the previous one in
+        ///        64x64 tiles (with AVX2 or SSE2 when available) and only
+        ///        changed tiles are uploaded. Useful for mostly static content
+        ///        such as dashboards or screen captures.
+        /// @param is_enabled[in] true to upload changed tiles only
+        void set_change_detection(bool is_enabled) const noexcept;
+
+        /// @brief Returns the bytes uploaded to the GPU and the bytes left out
+        ///        because they did not change.
+        UploadStatistics get_upload_statistics() const noexcept;
+
+        /// @brief Returns a buffer to write the next frame into. It points into
+        ///        GPU visible memory (persistently mapped when the driver supports
+        ///        ARB_buffer_storage), so the frame is displayed by `submit_frame`
+        ///        without any copy on the CPU. Not available while a render
+        ///        thread runs.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image which will be written, see `PixelFormat`
+        /// @return Writable buffer of the frame, nullptr if it is not available
+        uint8_t* acquire_frame(int frame_width,
+                               int frame_height,
+                               PixelFormat format) const noexcept;
+
+        /// @brief Displays the frame written into the buffer returned by
+        ///        `acquire_frame`. The buffer must not be used after this call.
+        /// @param exit_status[out] Use it to end your render loop
+        void submit_frame(volatile bool& exit_status) const noexcept;
+
+        /// @brief Sets the values of single channel formats (`Gray`, `R16`, `R16F`,
+        ///        `R32F`) which are shown as the first and the last colormap
+        ///        entry. Window/level is applied in the fragment shader.
+        /// @param minimum[in] Value in the units of the image buffer, e.g. 0 - 65535 for `R16`
+        /// @param maximum[in] Value in the units of the image buffer
+        void set_display_range(float minimum, float maximum) const noexcept;
+
+        /// @brief Derives the display range of single channel formats from
+        ///        the minimum and maximum of every frame. Frames written
+        ///        through `acquire_frame` keep the range of the last frame
+        ///        passed by pointer, their write-only buffers are not read.
+        void set_auto_display_range() const noexcept;
+
+        /// @brief Selects the pseudo-color map of single channel formats.
+        /// @param colormap[in] Built-in colormap, see `Colormap`
+        void set_colormap(Colormap colormap) const;
+
+        /// @brief Sets a user pseudo-color map of single channel formats.
+        /// @param rgba_entries[in] Table of RGBA entries, lowest value first. It is copied.
+        /// @param entry_count[in] Number of entries, at least 2
+        void set_custom_colormap(const uint8_t* rgba_entries, int entry_count) const;
+
+        /// @brief Zooms into and pans over the image on the GPU. The full
+        ///        frame stays uploaded, so navigating costs no pixel work.
+        ///        Frames shown smaller than their resolution are minified
+        ///        through mipmaps.
+        /// @param zoom[in] Magnification, 1 shows the whole image
+        /// @param center_x[in] Horizontal image position shown at the window
+        ///        center, 0 is the first column and 1 the last
+        /// @param center_y[in] Vertical image position shown at the window
+        ///        center, 0 is the first row and 1 the last
+        void set_view(float zoom, float center_x, float center_y) const noexcept;
+
+        /// @brief Displays an image larger than a texture can hold, e.g. a whole
+        ///        slide scan or a satellite mosaic, from a pyramid of tiles.
+        ///        Only the tiles visible at the current view are read and
+        ///        kept on the GPU, least recently used tiles are evicted when
+        ///        the budget is reached. Use `set_view` to navigate and
+        ///        `tiled_image_show` to present. Not available while a render
+        ///        thread runs.
+        /// @param source[in] Tile source, `read_tile` nullptr leaves the tiled mode
+        /// @param memory_budget[in] Most bytes of GPU memory the tiles can use
+        /// @return false if the source is invalid, e.g. the format has more
+        ///         than one plane or the tile is larger than a texture
+        bool set_tile_source(const TileSource& source, size_t memory_budget) const;
+
+        /// @brief Draws and presents the visible tiles of the tiled image.
+        ///        Missing tiles are read from the source over the next calls
+        ///        and a coarser level is shown in their place meanwhile.
+        /// @param exit_status[out] Use it to end your render loop
+        void tiled_image_show(volatile bool& exit_status) const;
+
+        /// @brief Turns the window into a wall of streams, e.g. a 4x4 grid of
+        ///        cameras. Streams are layers of one texture array and the
+        ///        grid is drawn with one instanced draw call and presented
+        ///        once, instead of one window, context and swap per stream.
+        ///        Zoom, aspect mode and overlays apply to the whole grid.
+        ///        Not available while a render thread runs.
+        /// @param layout[in] Grid layout, 0 columns leaves the mosaic mode
+        /// @return false if the layout is invalid, e.g. the format has more
+        ///         than one plane or there are more tiles than array layers
+        bool set_mosaic(const MosaicLayout& layout) const;
+
+        /// @brief Uploads the latest frame of one stream into its tile. Call
+        ///        it from the thread which shows the window, only for the
+        ///        streams which have a new frame.
+        /// @param tile_index[in] Row major tile index, 0 is the tile of the
+        ///        first image row and column
+        /// @param data_ptr[in] Frame of the grid's tile size and format
+        /// @return false if there is no mosaic or the index is out of the grid
+        bool update_mosaic_tile(int tile_index, const uint8_t* data_ptr) const noexcept;
+
+        /// @brief Draws every tile of the mosaic and presents the window once.
+        /// @param exit_status[out] Use it to end your render loop
+        void mosaic_show(volatile bool& exit_status) const;
+
+        /// @brief Selects whether the image keeps its aspect ratio in the window.
+        /// @param aspect_mode[in] Stretch by default
+        void set_aspect_mode(AspectMode aspect_mode) const noexcept;
+
+        /// @brief Replaces the boxes, lines, points and text drawn over every
+        ///        frame until the next call. They are drawn by the GPU with
+        ///        one instanced draw, the image buffer is not touched.
+        ///        It can be called from any thread.
+        /// @param overlay[in] Primitives in image pixels, copied during the call
+        void set_overlay(const Overlay& overlay) const;
+
+        /// @brief Removes every overlay primitive.
+        void clear_overlay() const;
+
+        /// @brief Copies the last drawn frame of an offscreen window, top row
+        ///        first. Not available while a render thread runs.
+        /// @param rgba_ptr[out] Buffer of window_width * window_height * 4 bytes
+        /// @return false if the window is not offscreen or it can not be read now
+        bool read_pixels(uint8_t* rgba_ptr) const noexcept;
+
+        /// @brief Starts capturing every presented frame, including zoom,
+        ///        letterbox bars and anything else drawn into the window.
+        ///        Frames are read back asynchronously and delivered on a
+        ///        worker thread, a frame is dropped rather than the display
+        ///        waiting when the readbacks or the worker fall behind.
+        ///        For a screenshot stop the capture once the first frame
+        ///        arrived. `stop_capture` must not be called from the callback.
+        /// @param settings[in] Callback or raw/Y4M file the frames go to
+        /// @return false if a capture runs or the destination is invalid
+        bool start_capture(const CaptureSettings& settings) const;
+
+        /// @brief Stops the capture and closes its file after the queued
+        ///        frames are delivered. Without a render thread the readbacks
+        ///        in flight are waited for, with one they are dropped.
+        void stop_capture() const noexcept;
+
+        /// @brief Returns the captured and dropped frame counts.
+        ///        It can be called from any thread.
+        /// @return Statistics of the running or the last capture
+        CaptureStatistics get_capture_statistics() const noexcept;
+
+        /// @brief Changes when frames are presented. The settings are applied
+        ///        before the next present, so it works with a render thread
+        ///        too. `TargetRate` sleeps and spins the last half millisecond
+        ///        to hit its present times, `LowLatency` drains the driver
+        ///        queue after every present and returns from `image_show`
+        ///        just in time for the next frame to make the next vertical
+        ///        blank. Windows of a `WindowGroup` are paced by the group,
+        ///        their settings are applied after the group is destroyed.
+        /// @param settings[in] Pacing mode and the target rate of `TargetRate`
+        void set_pacing(const PacingSettings& settings) const noexcept;
+
+        /// @brief Returns the intervals between the recent presents and their
+        ///        jitter. It can be called from any thread.
+        /// @return Pacing statistics since the pacing mode last changed
+        PacingStatistics get_pacing_statistics() const noexcept;
+
+        /// @brief Moves presentation of this window to a dedicated render thread.
+        ///        After this call use `submit_frame` instead of `image_show`
+        ///        and pump events with `poll_events` from the main thread.
+        /// @param policy[in] How submitted frames are consumed, see `PresentPolicy`
+        void start_render_thread(PresentPolicy policy);
+
+        /// @brief Stops the render thread and releases pending frames.
+        ///        The window's context stays detached, `image_show` makes it
+        ///        current again.
+        void stop_render_thread() noexcept;
+
+        /// @brief Queues a frame for the render thread without blocking.
+        /// @param data_ptr[in] Image buffer pointer.
+        ///        It must stay valid until `release_callback` is called for it.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer, see `PixelFormat`
+        /// @param exit_status[out] Use it to end your render loop
+        /// @param release_callback[in] Called when the buffer can be reused, can be
+        ///        nullptr. See `FrameReleaseCallback` for the calling thread.
+        /// @param user_data[in] Passed to the release callback
+        /// @return false if the frame was not queued, either because the fifo queue
+        ///         is full or the render thread is not started. The buffer is not used then.
+        bool submit_frame(const uint8_t* data_ptr,
+                          int frame_width,
+                          int frame_height,
+                          PixelFormat format,
+                          volatile bool& exit_status,
+                          FrameReleaseCallback release_callback = nullptr,
+                          void* user_data = nullptr) const noexcept;
+
+        /// @brief Returns the number of submitted frames which were never presented.
+        uint64_t get_dropped_frame_count() const noexcept;
+
+        /// @brief Removes the oldest event of this window from its queue.
+        ///        Key, resize and close events are queued by the thread which
+        ///        pumps events, the queue holds 64 events and drops newer ones
+        ///        while it is full, counted by `get_stats().dropped_event_count`.
+        ///        A dropped close or resize still takes effect, `exit_status`
+        ///        is set and the window keeps its new size. ESC still closes
+        ///        the window by itself.
+        /// @param event[out] Removed event
+        /// @return false if there is no event
+        bool pop_event(WindowEvent& event) const noexcept;
+
+        /// @brief Returns per stage timings of the recent frames as p50/p95/p99.
+        ///        CPU times cover event polling, upload, draw and swap, GPU times
+        ///        come from timer queries which are read a few frames later
+        ///        without waiting. Collection is always on and costs a clock
+        ///        read per stage.
+        /// @return Frame statistics, including presented and dropped frame counts
+        FrameStatistics get_stats() const noexcept;
+
+        /// @brief Processes pending events of all windows.
+        ///        Call it from the main thread while render threads are running.
+        static void poll_events() noexcept;
+
+        /// @brief Routes OpenGL errors and driver messages to a logger through
+        ///        `KHR_debug` debug output, which does not stall the render path.
+        ///        Call it before creating the first window. Without a logger,
+        ///        builds with `GL_ERROR_CHECKS` print errors to the console.
+        /// @param logger[in] Logger, nullptr to log to the console
+        /// @param user_data[in] Passed to every logger call
+        static void set_debug_logger(DebugLogger logger, void* user_data = nullptr) noexcept;
+
     ////////////////////////////////////////////////////////////////////////////
     // Private Members
     ////////////////////////////////////////////////////////////////////////////
     private:
 
+        friend class WindowGroup;
+
+        /// @brief Gives window groups access to the window implementation.
+        /// @return Window properties of this window
+        IWindowProperties& get_window_properties() const noexcept;
+
+        /// @brief Tells window groups whether a render thread owns the context.
+        /// @return true while a render thread runs
+        bool has_render_thread() const noexcept;
+
         class Impl; ///< Implementation class
         std::unique_ptr<Impl> p_impl; ///< Pointer to implementation class
 
@@ -0,0 +1,111 @@
+///
+/// @file window_group.hpp
+/// @author Yasin BASAR
+/// @brief Presents several windows in one pass with a single vertical blank wait.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef WINDOW_GROUP_HPP
+#define WINDOW_GROUP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <memory>
+#include "window_creator.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class WindowGroup
+    /// @brief Uploads the pending frames of all member windows first and then
+    ///        presents every window, so a frame costs at most one vertical
+    ///        blank wait instead of one per window.
+    class DLL_SPECS WindowGroup
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        WindowGroup() noexcept = delete; ///< Deleted default constructor
+        WindowGroup(WindowGroup &&) noexcept = delete; ///< Deleted move constructor
+        WindowGroup &operator=(WindowGroup &&) noexcept = delete; ///< Deleted move assignment operator
+        WindowGroup(const WindowGroup &) noexcept = delete; ///< Deleted copy constructor
+        WindowGroup &operator=(WindowGroup &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Creates an empty window group.
+        /// @param cap_to_screen_frame_rate[in] Set false this parameter for unlimited framerate,
+        /// otherwise the group's framerate will be capped to the screen's framerate.
+        explicit WindowGroup(bool cap_to_screen_frame_rate);
+
+        /// @brief Destructs window group object. Member windows are not destroyed.
+        ~WindowGroup() noexcept;
+
+        /// @brief Adds a window to the group. The window must outlive the group.
+        ///        The group owns the swap interval of its members, their
+        ///        `set_pacing` settings are kept until the group is destroyed.
+        ///        Frames of a member which starts a render thread are ignored.
+        /// @param window[in] Window to present with the group
+        /// @return false if the window runs a render thread or is a member already
+        bool add_window(WindowCreator& window);
+
+        /// @brief Sets the frame which will be shown in a window by the next `present`.
+        /// @param window[in] Member window
+        /// @param data_ptr[in] Image buffer pointer.
+        ///        It must stay valid until `present` returns.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer, see `PixelFormat`
+        void set_frame(const WindowCreator& window,
+                       const uint8_t* data_ptr,
+                       int frame_width,
+                       int frame_height,
+                       PixelFormat format = PixelFormat::RGBA) noexcept;
+
+        /// @brief Pumps events once, uploads all pending frames and then
+        ///        presents every window which received a frame.
+        /// @param exit_status[out] Set when any member window is closed
+        void present(volatile bool& exit_status) noexcept;
+
+        /// @brief Returns the measured presentation rate of a window.
+        /// @param window[in] Member window
+        /// @return Frames per second, updated once per second
+        double get_window_frame_rate(const WindowCreator& window) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        class Impl; ///< Implementation class
+        std::unique_ptr<Impl> p_impl; ///< Pointer to implementation class
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Protected Members
+    ////////////////////////////////////////////////////////////////////////////
+    protected:
+
+        // Data
+
+    };
+} // YB
+
+#endif // WINDOW_GROUP_HPP
+
+/* End of File */
@@ -0,0 +1,90 @@
+///
+/// @file window_manager.hpp
+/// @author Yasin BASAR
+/// @brief Owns the event loop of all windows.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef WINDOW_MANAGER_HPP
+#define WINDOW_MANAGER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include "window_creator.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @class WindowManager
+    /// @brief Takes event pumping over from the windows. While it exists
+    ///        `image_show`, `submit_frame` and `WindowGroup::present` do not
+    ///        pump events anymore, the application pumps them once per tick
+    ///        for every window, or waits for them while it is idle. Events
+    ///        are delivered to each window's queue, see `WindowCreator::pop_event`.
+    ///        Only one window manager can exist, it must be used from the main thread.
+    class DLL_SPECS WindowManager
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        WindowManager(WindowManager &&) noexcept = delete; ///< Deleted move constructor
+        WindowManager &operator=(WindowManager &&) noexcept = delete; ///< Deleted move assignment operator
+        WindowManager(const WindowManager &) noexcept = delete; ///< Deleted copy constructor
+        WindowManager &operator=(WindowManager &) noexcept = delete; ///< Deleted copy assignment operator
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        /// @brief Takes event pumping over from the windows.
+        ///        Throws `std::runtime_error` if another window manager exists.
+        WindowManager();
+
+        /// @brief Gives event pumping back to the windows.
+        ~WindowManager() noexcept;
+
+        /// @brief Processes pending events of all windows without waiting.
+        void poll_events() const noexcept;
+
+        /// @brief Waits until an event arrives, `wake` is called or the
+        ///        timeout passes, then processes pending events of all windows.
+        /// @param timeout_seconds[in] Longest wait
+        void wait_events(double timeout_seconds) const noexcept;
+
+        /// @brief Wakes up `wait_events`, e.g. when a producer thread has a
+        ///        new frame. It can be called from any thread.
+        static void wake() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        // Data
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Protected Members
+    ////////////////////////////////////////////////////////////////////////////
+    protected:
+
+        // Data
+
+    };
+} // YB
+
+#endif // WINDOW_MANAGER_HPP
+
+/* End of File */
@@ -14,7 +14,20 @@
 // Project Includes
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
 #include "i_window_properties.hpp"
+#include "change_detector.hpp"
+#include "frame_capture.hpp"
+#include "frame_pacer.hpp"
+#include "frame_profiler.hpp"
+#include "overlay.hpp"
+#include "gl_state_cache.hpp"
+#include "mosaic_texture.hpp"
+#include "tile_cache.hpp"
+#include "spsc_queue.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Third Party Includes
@@ -28,6 +41,7 @@ struct GLFWwindow;
 
 typedef int GLint;
 typedef unsigned int GLuint;
+typedef struct __GLsync* GLsync;
 
 namespace YB
 {
@@ -39,10 +53,10 @@ namespace YB
     ////////////////////////////////////////////////////////////////////////////
 
         WindowProperties() noexcept = delete; ///< Deleted default constructor
-        WindowProperties(WindowProperties &&) noexcept = default; ///< Default move constructor
-        WindowProperties &operator=(WindowProperties &&) noexcept = default; ///< Default move assignment operator
-        WindowProperties(const WindowProperties &) noexcept = default; ///< Default copy constructor
-        WindowProperties &operator=(WindowProperties const &) noexcept = default; ///< Default copy assignment operator
+        WindowProperties(WindowProperties &&) noexcept = delete; ///< Deleted move constructor
+        WindowProperties &operator=(WindowProperties &&) noexcept = delete; ///< Deleted move assignment operator
+        WindowProperties(const WindowProperties &) noexcept = delete; ///< Deleted copy constructor
+        WindowProperties &operator=(WindowProperties const &) noexcept = delete; ///< Deleted copy assignment operator
 
     ////////////////////////////////////////////////////////////////////////////
     // Public Members
@@ -54,31 +68,409 @@ namespace YB
         /// @param window_height[in] Window Height
         /// @param cato_screen_frame_rate[in] Set false this parameter for unlimited framerate,
         /// otherwise window's framerate will be capped to the screen's framerate.
+        /// @param upload_mode[in] Texture upload strategy, see `UploadMode`.
+        /// @param surface_mode[in] Visible window or offscreen rendering, see `SurfaceMode`.
         WindowProperties(const char* window_name,
                          int window_width,
                          int window_height,
-                         bool cato_screen_frame_rate);
+                         bool cato_screen_frame_rate,
+                         UploadMode upload_mode,
+                         SurfaceMode surface_mode);
 
         /// @brief Destructs window creator object.
         ~WindowProperties() noexcept override;
 
         /// @brief It runs window image rendering
-        /// @param data_ptr[in] Image buffer pointer. Only 4 channel images acceptable.
+        /// @param data_ptr[in] Image buffer pointer.
         /// @param frame_width[in] Image Width
         /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
         /// @param exit_status[out] Use it to end your render loop
-        void image_show(uint8_t* data_ptr,
+        void image_show(const uint8_t* data_ptr,
                         int frame_width,
                         int frame_height,
+                        PixelFormat format,
                         volatile bool& exit_status) noexcept override;
 
+        /// @brief It runs window image rendering and updates only the given
+        ///        regions of the displayed image.
+        /// @param data_ptr[in] Image buffer pointer, the whole frame.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        /// @param dirty_regions[in] Changed regions in image pixels
+        /// @param region_count[in] Number of regions
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show_regions(const uint8_t* data_ptr,
+                                int frame_width,
+                                int frame_height,
+                                PixelFormat format,
+                                const Rect* dirty_regions,
+                                int region_count,
+                                volatile bool& exit_status) noexcept override;
+
+        /// @brief It runs window render cycle for a padded or cropped buffer.
+        ///        Rows are picked out of the buffer by the unpack parameters,
+        ///        the caller never repacks them.
+        /// @param view[in] Buffer, its row pitch and the shown region
+        /// @param exit_status[out] Use it to end your render loop
+        /// @return false if the view is invalid, nothing is shown then
+        bool image_show_view(const FrameView& view,
+                             volatile bool& exit_status) noexcept override;
+
+        /// @brief It runs window render cycle for a frame identified by a
+        ///        generation. A frame with the generation of the resident
+        ///        frame is not read, and it is not drawn or presented either
+        ///        unless something else on screen changed.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        /// @param generation[in] Changes whenever the content changes, 0 if unknown
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show_generation(const uint8_t* data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   PixelFormat format,
+                                   uint64_t generation,
+                                   volatile bool& exit_status) noexcept override;
+
+        /// @brief It runs window render cycle for a block compressed image.
+        ///        Formats the driver samples are uploaded as they are, others,
+        ///        and every format if `set_compressed_upload` asks for it, are
+        ///        decoded to RGBA on the CPU and take the RGBA path.
+        /// @param data_ptr[in] Compressed image, rows of 4x4 blocks
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Compressed format of the image
+        /// @param exit_status[out] Use it to end your render loop
+        void image_show_compressed(const uint8_t* data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   CompressedFormat format,
+                                   volatile bool& exit_status) noexcept override;
+
+        /// @brief Draws the shown frame, tiles or mosaic again from the
+        ///        resident textures if a resize, an expose or a display
+        ///        setting asks for it. The context is made current.
+        void refresh() noexcept override;
+
+        /// @brief Switches the window to a tiled image, or back to frames
+        ///        when `read_tile` of the source is nullptr.
+        /// @param source[in] Tile source
+        /// @param memory_budget[in] Most bytes of GPU memory the tiles can use
+        /// @return false if the source can not be displayed
+        bool set_tile_source(const TileSource& source, size_t memory_budget) override;
+
+        /// @brief Draws and presents the visible tiles of the tiled image.
+        ///        Tiles which are not resident are read from the source, at
+        ///        most `m_max_tile_loads_per_frame` per call and only until
+        ///        `m_tile_load_budget` is spent, and a coarser level is shown
+        ///        in their place meanwhile.
+        /// @param exit_status[out] Use it to end your render loop
+        void tiled_image_show(volatile bool& exit_status) override;
+
+        /// @brief Allocates the texture array of a mosaic grid.
+        /// @param layout[in] Grid layout, 0 columns leaves the mosaic mode
+        /// @return false if the layout is invalid or too large for the driver
+        bool set_mosaic(const MosaicLayout& layout) override;
+
+        /// @brief Uploads a stream frame into its tile of the mosaic.
+        /// @param tile_index[in] Row major tile index
+        /// @param data_ptr[in] Frame of the grid's tile size and format
+        /// @return false if there is no mosaic or the index is out of the grid
+        bool update_mosaic_tile(int tile_index, const uint8_t* data_ptr) noexcept override;
+
+        /// @brief Draws every tile of the mosaic in one draw call and presents.
+        /// @param exit_status[out] Use it to end your render loop
+        void mosaic_show(volatile bool& exit_status) override;
+
+        /// @brief Uploads, draws and presents a frame without pumping events.
+        ///        The window's context must be current on the calling thread.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        void render_frame(const uint8_t* data_ptr,
+                          int frame_width,
+                          int frame_height,
+                          PixelFormat format) noexcept override;
+
+        /// @brief Updates the window textures with a frame.
+        ///        The window's context must be current on the calling thread.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        void upload_frame(const uint8_t* data_ptr,
+                          int frame_width,
+                          int frame_height,
+                          PixelFormat format) noexcept override;
+
+        /// @brief Draws the window textures into the back buffer.
+        ///        Non-RGB formats are converted by the fragment shader.
+        ///        The window's context must be current on the calling thread.
+        void draw_frame() noexcept override;
+
+        /// @brief Presents the back buffer. It waits for the vertical
+        ///        blank if the swap interval of the window is not zero.
+        ///        Offscreen windows only flush the drawing commands.
+        void swap_buffers() noexcept override;
+
+        /// @brief Sets how many vertical blanks `swap_buffers` waits for.
+        ///        The window's context must be current on the calling thread.
+        /// @param interval[in] 0 for un-limited fps, 1 to cap to the screen's framerate
+        void set_swap_interval(int interval) noexcept override;
+
+        /// @brief Lets a window group own the swap interval, pacing settings
+        ///        are not applied while the window is grouped.
+        /// @param is_grouped[in] true when the window joins a group
+        void set_grouped(bool is_grouped) noexcept override;
+
+        /// @brief Returns a writable pointer into the next buffer of the
+        ///        upload ring, the frame written there is displayed by
+        ///        `submit_acquired_frame` without any copy on the CPU.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image which will be written
+        /// @return Buffer of the frame, nullptr if it could not be mapped
+        uint8_t* acquire_frame(int frame_width,
+                               int frame_height,
+                               PixelFormat format) noexcept override;
+
+        /// @brief Pumps events, then uploads, draws and presents the frame
+        ///        written into the buffer returned by `acquire_frame`.
+        /// @param exit_status[out] Use it to end your render loop
+        void submit_acquired_frame(volatile bool& exit_status) noexcept override;
+
+        /// @brief Sets the values of single channel formats which are shown
+        ///        as the first and the last colormap entry. It can be called
+        ///        from any thread, it is applied with the next drawn frame.
+        /// @param minimum[in] Value in the units of the image buffer
+        /// @param maximum[in] Value in the units of the image buffer
+        void set_display_range(float minimum, float maximum) noexcept override;
+
+        /// @brief Derives the display range from the minimum and maximum
+        ///        of every uploaded frame.
+        void set_auto_display_range() noexcept override;
+
+        /// @brief Selects a built-in colormap for single channel formats.
+        /// @param colormap[in] Built-in colormap
+        void set_colormap(Colormap colormap) override;
+
+        /// @brief Sets a user colormap for single channel formats.
+        /// @param rgba_entries[in] Table of RGBA entries, lowest value first
+        /// @param entry_count[in] Number of entries, at least 2
+        void set_custom_colormap(const uint8_t* rgba_entries,
+                                 int entry_count) override;
+
+        /// @brief Sets the zoom and the image position at the window center.
+        ///        It can be called from any thread.
+        /// @param zoom[in] Magnification, 1 shows the whole image
+        /// @param center_x[in] Normalized image column at the window center
+        /// @param center_y[in] Normalized image row at the window center
+        void set_view(float zoom, float center_x, float center_y) noexcept override;
+
+        /// @brief Selects whether the image keeps its aspect ratio.
+        ///        It can be called from any thread.
+        /// @param aspect_mode[in] Aspect mode
+        void set_aspect_mode(AspectMode aspect_mode) noexcept override;
+
+        /// @brief Replaces the primitives drawn over every frame. They are
+        ///        converted to instances on the calling thread and uploaded
+        ///        with the next drawn frame. It can be called from any thread.
+        /// @param overlay[in] Primitives, an empty overlay clears it
+        void set_overlay(const Overlay& overlay) override;
+
+        /// @brief Enables comparing every frame with the previous one so only
+        ///        changed tiles are uploaded. It costs a frame sized copy in
+        ///        memory and a compare pass on the CPU.
+        /// @param is_enabled[in] true to upload changed tiles only
+        void set_change_detection(bool is_enabled) noexcept override;
+
+        /// @brief Selects whether compressed frames are uploaded as blocks
+        ///        or decoded to RGBA. It can be called from any thread.
+        /// @param compressed_upload[in] Compressed upload path
+        void set_compressed_upload(CompressedUpload compressed_upload) noexcept override;
+
+        /// @brief Checks which path the next compressed frame takes.
+        /// @param format[in] Compressed format
+        /// @return true if the frame is uploaded as blocks, false if decoded
+        bool is_compressed_upload_native(CompressedFormat format) const noexcept override;
+
+        /// @brief Returns the uploaded and skipped byte counts.
+        ///        It can be called from any thread.
+        /// @return Upload statistics of the window
+        UploadStatistics get_upload_statistics() const noexcept override;
+
+        /// @brief Removes the oldest event of the window from its queue.
+        ///        Events are pushed by the thread which pumps events.
+        /// @param event[out] Removed event
+        /// @return false if there is no event
+        bool pop_event(WindowEvent& event) noexcept override;
+
+        /// @brief Returns timings of the recent frames and the presented
+        ///        frame count. It can be called from any thread.
+        /// @return Frame statistics of the window
+        FrameStatistics get_frame_statistics() const noexcept override;
+
+        /// @brief Copies the offscreen framebuffer, top row first.
+        /// @param rgba_ptr[out] Buffer of surface width * height * 4 bytes
+        /// @return false if the window is not offscreen
+        bool read_pixels(uint8_t* rgba_ptr) noexcept override;
+
+        /// @brief Starts reading back every presented frame asynchronously.
+        ///        It can be called from any thread.
+        /// @param settings[in] Callback or file the frames are delivered to
+        /// @return false if a capture runs or the destination is invalid
+        bool start_capture(const CaptureSettings& settings) override;
+
+        /// @brief Waits for the readbacks in flight so they are not lost
+        ///        when the capture stops. The context is made current.
+        void flush_capture() noexcept override;
+
+        /// @brief Stops the capture after the queued frames are delivered.
+        ///        It can be called from any thread.
+        void stop_capture() noexcept override;
+
+        /// @brief Returns the captured and dropped frame counts.
+        ///        It can be called from any thread.
+        /// @return Statistics of the running or the last capture
+        CaptureStatistics get_capture_statistics() const noexcept override;
+
+        /// @brief Changes when frames are presented, the settings are applied
+        ///        before the next present. It can be called from any thread.
+        /// @param settings[in] Pacing settings
+        void set_pacing(const PacingSettings& settings) noexcept override;
+
+        /// @brief Returns the intervals between the recent presents.
+        ///        It can be called from any thread.
+        /// @return Pacing statistics
+        PacingStatistics get_pacing_statistics() const noexcept override;
+
+        /// @brief Makes the window's context current on the calling thread.
+        void make_context_current() noexcept override;
+
+        /// @brief Detaches the window's context from the calling thread
+        ///        so another thread can make it current.
+        void release_context() noexcept override;
+
+        /// @brief Sets the listener called when the window needs a redraw,
+        ///        so a thread sleeping until the next frame can refresh it.
+        ///        It can be called from any thread.
+        /// @param listener[in] Listener, nullptr to remove it
+        /// @param user_data[in] Passed to every listener call
+        void set_redraw_listener(RedrawListener listener, void* user_data) noexcept override;
+
+        /// @brief Checks if the user requested to close the window.
+        ///        It can be called from any thread.
+        /// @return true if the window should be closed
+        bool should_close() const noexcept override;
+
+        /// @brief Processes pending events of all windows.
+        ///        It must be called from the main thread.
+        static void poll_events() noexcept;
+
+        /// @brief Processes pending events of all windows unless a window
+        ///        manager pumps them. Used by the drawing calls which used
+        ///        to pump events themselves.
+        static void poll_events_without_pump() noexcept;
+
+        /// @brief Waits until an event arrives or the timeout passes and
+        ///        processes the pending events. It sleeps if GLFW is not
+        ///        started yet. It must be called from the main thread.
+        /// @param timeout_seconds[in] Longest wait
+        static void wait_events(double timeout_seconds) noexcept;
+
+        /// @brief Wakes up a thread waiting in `wait_events`.
+        ///        It can be called from any thread.
+        static void wake_event_wait() noexcept;
+
+        /// @brief Marks whether a window manager owns event pumping.
+        /// @param has_event_pump[in] true while a window manager exists
+        /// @return false if another window manager already owns it
+        static bool set_event_pump(bool has_event_pump) noexcept;
+
+        /// @brief Routes OpenGL errors and driver messages to a logger.
+        ///        Contexts created afterwards are debug contexts and report
+        ///        through `GL_DEBUG_OUTPUT` when `KHR_debug` is supported.
+        ///        It must be called before the first window is created.
+        /// @param logger[in] Logger, nullptr to log errors to the console
+        /// @param user_data[in] Passed to every logger call
+        static void set_debug_logger(DebugLogger logger, void* user_data) noexcept;
+
     ////////////////////////////////////////////////////////////////////////////
     // Private Members
     ////////////////////////////////////////////////////////////////////////////
     private:
 
-        /// @brief It sets shader properties.
-        static void set_window_properties() noexcept;
+        /// @enum ShownContent
+        /// @brief What the last present of the window showed.
+        enum class ShownContent : uint8_t
+        {
+            None, ///< Nothing was presented yet.
+            Frame, ///< The plane textures.
+            Tiles, ///< The tiled image.
+            Mosaic ///< The mosaic grid.
+        };
+
+        /// @brief Draws and presents the resident frame, unless it is
+        ///        unchanged and nothing else on screen changed either.
+        /// @param is_frame_changed[in] true if the textures were updated
+        void present_frame(bool is_frame_changed) noexcept;
+
+        /// @brief Calls the redraw listener after a redraw was requested.
+        void notify_redraw() noexcept;
+
+        /// @brief Logs the pending OpenGL errors. Compiled only with
+        ///        `GL_ERROR_CHECKS` and skipped when debug output of this
+        ///        window's context reports them.
+        /// @param file[in] File name of the check
+        /// @param line[in] Line number of the check
+        void check_gl_error(const char* file, int line) const noexcept;
+
+        /// @brief Enables `GL_DEBUG_OUTPUT` on the current context when a
+        ///        logger is set and the driver supports `KHR_debug`.
+        /// @return true if the context reports errors through the callback
+        static bool enable_debug_output() noexcept;
+
+        /// @brief Sends a message to the logger, or to the console without one.
+        /// @param severity[in] Severity of the message
+        /// @param message[in] Null terminated message
+        static void log_message(DebugSeverity severity, const char* message) noexcept;
+
+        /// @brief Receives `GL_DEBUG_OUTPUT` messages of every context.
+        static void APIENTRY debug_message_callback(GLenum source,
+                                                    GLenum type,
+                                                    GLuint id,
+                                                    GLenum severity,
+                                                    GLsizei length,
+                                                    const GLchar* message,
+                                                    const void* user_data);
+
+        /// @brief Compiles the shaders and creates the quad buffers in the
+        ///        resource context. Every window context shares them.
+        static void create_shared_resources() noexcept;
+
+        /// @brief Deletes the shared objects. The resource context must be current.
+        static void release_shared_resources() noexcept;
+
+        /// @brief Sets the context hints of every window, the resource window
+        ///        included, so all contexts can share objects.
+        static void set_context_hints() noexcept;
+
+        /// @brief Creates the vertex array of the window. Vertex arrays are
+        ///        containers which can not be shared between contexts, so
+        ///        each window binds the shared quad buffers to its own one.
+        void create_vertex_array() noexcept;
+
+        /// @brief Links the window's shader program from the shared shader
+        ///        objects. Uniforms of a program shared between contexts
+        ///        would be written by several render threads at once.
+        void create_shader_program() noexcept;
+
+        /// @brief Makes the window's context current unless it already is.
+        void bind_context() noexcept;
 
         /// @brief It complies the shader codes if there is no error.
         ///        If there is an error print it.
@@ -88,9 +480,238 @@ namespace YB
         static GLuint shader_compile(uint32_t type,
                               const char* source);
 
-        /// @brief It creates GLFW Window.
-        /// @return Shaders attached Program object's ID
-        static GLuint shader_create() noexcept;
+        /// @brief Links a shader program from compiled shaders. The shaders
+        ///        stay alive and can be linked into other programs.
+        /// @param vertex_shader_id[in] Compiled vertex shader
+        /// @param fragment_shader_id[in] Compiled fragment shader
+        /// @return Linked program object's ID
+        static GLuint shader_link(GLuint vertex_shader_id,
+                                  GLuint fragment_shader_id) noexcept;
+
+        /// @brief Starts GLFW for the first window, later windows share it.
+        /// @param is_offscreen[in] The first window is offscreen
+        /// @return false if GLFW could not be started
+        static bool acquire_glfw(bool is_offscreen) noexcept;
+
+        /// @brief Terminates GLFW after the last window is destroyed.
+        static void release_glfw() noexcept;
+
+        /// @brief Selects GLFW's null platform with OSMesa contexts for
+        ///        offscreen windows when there is no display server.
+        ///        It must be called before `glfwInit`.
+        /// @return true if the null platform was selected
+        static bool select_headless_platform() noexcept;
+
+        /// @brief Creates the framebuffer object offscreen windows draw into.
+        /// @param width[in] Framebuffer width
+        /// @param height[in] Framebuffer height
+        void create_offscreen_framebuffer(int width, int height);
+
+        /// @struct TileDraw
+        /// @brief Resident tile drawn by the current frame.
+        struct TileDraw
+        {
+            GLuint texture; ///< Texture of the tile.
+            int level; ///< Pyramid level.
+            int tile_x; ///< Tile column.
+            int tile_y; ///< Tile row.
+        };
+
+        /// @brief Binds the framebuffer and applies pending viewport and
+        ///        display setting changes before drawing.
+        void prepare_draw() noexcept;
+
+        /// @brief Computes the clip space scale of the image quad from the
+        ///        zoom and the aspect mode.
+        /// @param image_width[in] Width of the displayed image
+        /// @param image_height[in] Height of the displayed image
+        /// @param scale_x[out] Horizontal scale, less than 1 leaves bars
+        /// @param scale_y[out] Vertical scale, less than 1 leaves bars
+        void get_view_scale(int image_width,
+                            int image_height,
+                            float& scale_x,
+                            float& scale_y) const noexcept;
+
+        /// @brief Binds the window's program, the vertex array and the
+        ///        uniforms and colormap of a sampling layout.
+        /// @param layout[in] Layout of the drawn textures
+        /// @param is_layered[in] true to sample the mosaic texture array
+        ///        instead of the plane textures
+        void bind_program(const ImageLayout& layout, bool is_layered) noexcept;
+
+        /// @brief Draws every tile of the mosaic with one instanced draw.
+        void draw_mosaic() noexcept;
+
+        /// @brief Uploads a replaced overlay into the instance buffer. The
+        ///        first overlay creates the vertex array and links the
+        ///        window's overlay program.
+        /// @param instances[in] Instances of the new overlay
+        void upload_overlay(const std::vector<OverlayInstance>& instances) noexcept;
+
+        /// @brief Draws the overlay instances over the image with one
+        ///        instanced draw and blending.
+        /// @param image_width[in] Width of the displayed image in pixels
+        /// @param image_height[in] Height of the displayed image in pixels
+        /// @param scale_x[in] Horizontal clip space scale of the image quad
+        /// @param scale_y[in] Vertical clip space scale of the image quad
+        /// @param offset_x[in] Horizontal clip space offset of the image quad
+        /// @param offset_y[in] Vertical clip space offset of the image quad
+        void draw_overlay(int image_width,
+                          int image_height,
+                          float scale_x,
+                          float scale_y,
+                          float offset_x,
+                          float offset_y) noexcept;
+
+        /// @brief Picks the visible tiles of the tiled image, loads missing
+        ///        ones and draws them.
+        void draw_tiles() noexcept;
+
+        /// @brief Draws one tile of the tiled image.
+        /// @param tile[in] Tile to draw
+        /// @param scale_x[in] Horizontal clip space scale of the whole image
+        /// @param scale_y[in] Vertical clip space scale of the whole image
+        /// @param offset_x[in] Horizontal clip space offset of the whole image
+        /// @param offset_y[in] Vertical clip space offset of the whole image
+        void draw_tile(const TileDraw& tile,
+                       float scale_x,
+                       float scale_y,
+                       float offset_x,
+                       float offset_y) noexcept;
+
+        /// @brief Switches the plane textures between plain and mipmapped
+        ///        minification and rebuilds the mipmaps of new frames while
+        ///        the image is shown smaller than its resolution.
+        /// @param layout[in] Layout of the current frame
+        /// @param is_minified[in] true if the image covers fewer pixels than it has
+        void update_mipmaps(const ImageLayout& layout, bool is_minified) noexcept;
+
+        /// @brief Returns the clip space offset of the quad which shows the
+        ///        view center in the middle of the viewport.
+        /// @param scale[in] Clip space scale of the quad along the axis
+        /// @param center[in] Normalized image position of the view center
+        /// @return Offset, limited so panning stops at the image border
+        static float get_view_offset(float scale, float center) noexcept;
+
+        /// @brief Creates a plane texture with its sampling parameters.
+        /// @param level_count[in] Number of mipmap levels
+        /// @return Texture id
+        GLuint create_texture(int level_count) noexcept;
+
+        /// @brief Allocates the storage of the plane textures once for a
+        ///        resolution and pixel format. Frames are written into them
+        ///        with sub-image uploads until either changes. Immutable
+        ///        storage is used when the driver supports it.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        void allocate_texture_storage(int frame_width,
+                                      int frame_height,
+                                      PixelFormat format) noexcept;
+
+        /// @brief Checks if the plane textures hold uncompressed frames of a
+        ///        resolution and pixel format.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        /// @return true if frames of this layout can be written with sub-image uploads
+        bool has_texture_storage(int frame_width,
+                                int frame_height,
+                                PixelFormat format) const noexcept;
+
+        /// @brief Allocates a single level texture for block compressed
+        ///        frames. Compressed textures can not build their mipmaps,
+        ///        they are always magnified or minified from the base level.
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Compressed format of the image
+        void allocate_compressed_storage(int frame_width,
+                                         int frame_height,
+                                         CompressedFormat format) noexcept;
+
+        /// @brief Uploads a block compressed frame the driver can sample as
+        ///        a whole, without change detection.
+        /// @param data_ptr[in] Compressed image
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Compressed format of the image
+        void upload_compressed_frame(const uint8_t* data_ptr,
+                                     int frame_width,
+                                     int frame_height,
+                                     CompressedFormat format) noexcept;
+
+        /// @brief Updates the regions of the window textures a frame changed.
+        ///        Regions come from the caller, from change detection or
+        ///        cover the whole frame.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_layout[in] Plane offsets and row pitches inside the buffer
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        /// @param dirty_regions[in] Changed regions, nullptr if not known
+        /// @param region_count[in] Number of regions
+        /// @return false if no region changed and nothing was uploaded
+        bool upload_frame_regions(const uint8_t* data_ptr,
+                                  const ImageLayout& frame_layout,
+                                  int frame_width,
+                                  int frame_height,
+                                  PixelFormat format,
+                                  const Rect* dirty_regions,
+                                  int region_count) noexcept;
+
+        /// @brief Counts the bytes `m_dirty_regions` covers as uploaded
+        ///        and the rest of the frame as skipped.
+        /// @param layout[in] Layout of the current texture storage
+        void count_uploaded_bytes(const ImageLayout& layout) noexcept;
+
+        /// @brief Applies display settings changed by the setters, uploads
+        ///        a new colormap table if there is one.
+        void apply_display_settings() noexcept;
+
+        /// @brief Updates `m_dirty_regions` of every plane texture from an
+        ///        image buffer, or from the bound pixel unpack buffer when
+        ///        `data_ptr` is an offset. Rows are picked out of the full
+        ///        frame with the unpack row length and skip parameters.
+        /// @param data_ptr[in] Image buffer pointer or unpack buffer offset
+        /// @param layout[in] Plane offsets and row pitches relative to `data_ptr`
+        void upload_planes(const uint8_t* data_ptr,
+                           const ImageLayout& layout) noexcept;
+
+        /// @brief Updates the automatic display range from a frame if it is enabled.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param layout[in] Plane offsets and row pitches inside the buffer
+        /// @param frame_width[in] Image Width
+        /// @param frame_height[in] Image Height
+        /// @param format[in] Memory layout of the image buffer
+        void update_auto_display_range(const uint8_t* data_ptr,
+                                       const ImageLayout& layout,
+                                       int frame_width,
+                                       int frame_height,
+                                       PixelFormat format) noexcept;
+
+        /// @brief Waits until the GPU finished reading the next buffer of
+        ///        the ring and returns a pointer to write the frame into.
+        ///        Buffers are (re)allocated for the current texture layout,
+        ///        they stay mapped when persistent mapping is supported.
+        /// @return Writable buffer memory, nullptr if mapping failed
+        uint8_t* map_next_pixel_buffer() noexcept;
+
+        /// @brief Updates the plane textures from the buffer returned by
+        ///        `map_next_pixel_buffer`, fences it and moves the ring on.
+        /// @param is_written[in] false to only release the buffer
+        void upload_from_pixel_buffer(bool is_written) noexcept;
+
+        /// @brief Copies `m_dirty_regions` of the frame into the next pixel unpack buffer of the ring
+        ///        and updates the plane textures from it. The GPU pulls the
+        ///        pixels asynchronously, a fence guards each buffer until the
+        ///        transfer which reads it is finished.
+        /// @param data_ptr[in] Image buffer pointer.
+        /// @param frame_layout[in] Plane offsets and row pitches inside the buffer
+        void upload_with_pixel_buffer_ring(const uint8_t* data_ptr,
+                                           const ImageLayout& frame_layout) noexcept;
+
+        /// @brief Releases pixel unpack buffers and their fences.
+        void release_pixel_buffer_ring() noexcept;
 
         /// @brief Keyboard callback function for handling key events.
         /// @param window[in] The GLFW window pointer.
@@ -106,7 +727,9 @@ namespace YB
 
         /// @brief Instance-specific window resize callback.
         ///        Prevents windows from affecting each other when resizing.
-        void resize_window(int width, int height) const noexcept;
+        ///        The viewport is applied by the thread which renders the
+        ///        next frame, since that thread owns the context.
+        void resize_window(int width, int height) noexcept;
 
         /// @brief Window resize callback function to update the viewport.
         /// @param window[in] The GLFW window pointer.
@@ -116,6 +739,20 @@ namespace YB
                                            int width,
                                            int height) noexcept;
 
+        /// @brief Window close callback function to queue a close event.
+        /// @param window[in] The GLFW window pointer.
+        static void window_close_callback(GLFWwindow* window) noexcept;
+
+        /// @brief Window refresh callback function, the window's content was
+        ///        damaged, e.g. by a resize or by uncovering it.
+        /// @param window[in] The GLFW window pointer.
+        static void window_refresh_callback(GLFWwindow* window) noexcept;
+
+        /// @brief Queues an event of the window, it is dropped and counted
+        ///        if the queue is full because nobody reads it.
+        /// @param event[in] Event to queue
+        void push_event(const WindowEvent& event) noexcept;
+
 #ifdef _WIN32
         /// @brief Checks if Dark Mode enabled in Windows Operating System
         /// @return returns true if Dark Mode enabled, otherwise returns false
@@ -124,16 +761,123 @@ namespace YB
 
         static const char* m_vertex_shader; ///< Holds the vertex shader code as string.
         static const char* m_fragment_shader; ///< Holds the fragment shader code as string.
-        static GLuint m_VAO; ///< Vertex Array Buffer of OpenGL operations.
+        static const char* m_overlay_vertex_shader; ///< Expands overlay instances into quads.
+        static const char* m_overlay_fragment_shader; ///< Shades overlay quads, glyphs from the atlas.
+        static GLFWwindow* m_resource_window; ///< Hidden window whose context owns the shared objects.
         static GLuint m_VBO; ///< Vertex Buffer Object of OpenGL operations.
         static GLuint m_IBO; ///< Index Buffer Object of OpenGL operations.
-        static GLuint m_shader_program; ///< Shader program attach id of OpenGL operations.
-        static GLuint m_vertex_shader_id; ///< Vertex shader attach id of OpenGL operations.
-        static GLuint m_fragment_shader_id; ///< Fragment shader attach id of OpenGL operations.
-        static GLuint m_texture_output; ///< Texture attach id of OpenGL operations.
-        static GLint m_location; ///< Location id that match locations ids in the shader code.
-        static bool m_is_common_window_resources_cleared; ///< A variable to check when there are multiple windows to not re-clear static resources.
+        static GLuint m_vertex_shader_id; ///< Shared compiled vertex shader, linked into each window's program.
+        static GLuint m_fragment_shader_id; ///< Shared compiled fragment shader, linked into each window's program.
+        static GLuint m_overlay_vertex_shader_id; ///< Shared compiled overlay vertex shader.
+        static GLuint m_overlay_fragment_shader_id; ///< Shared compiled overlay fragment shader.
+        static GLuint m_glyph_atlas_texture; ///< Shared glyph atlas of overlay text.
+        static std::atomic<int> m_glfw_user_count; ///< Number of windows which use GLFW.
+        static bool m_is_glfw_headless; ///< Set when GLFW runs on the null platform.
+        static std::atomic<bool> m_has_event_pump; ///< Set while a window manager pumps events.
+        static DebugLogger m_debug_logger; ///< User logger of OpenGL messages, nullptr logs to the console.
+        static void* m_debug_logger_user_data; ///< User data of `m_debug_logger`.
+        static constexpr int m_pbo_count = 3; ///< Number of pixel unpack buffers in the ring.
+        static constexpr int m_max_plane_count = 3; ///< Most planes any pixel format has.
+        static constexpr int m_max_tile_loads_per_frame = 16; ///< Most tiles read from a tile source per frame.
+        static constexpr std::chrono::microseconds m_tile_load_budget{4000}; ///< Time after which no more tiles are read in a frame, the first read always runs.
         GLFWwindow* m_window; ///< Window context object.
+        GLuint m_VAO; ///< Vertex array of this window's context.
+        GLuint m_shader_program; ///< Program of this window, its uniforms are only set from this window's thread.
+        GLint m_location; ///< Location id that match locations ids in the shader code.
+        GLint m_plane1_location; ///< Location of the second plane sampler.
+        GLint m_plane2_location; ///< Location of the third plane sampler.
+        GLint m_sampling_layout_location; ///< Location of the sampling layout selector.
+        GLint m_colormap_location; ///< Location of the colormap sampler.
+        GLint m_value_range_location; ///< Location of the display range of single channel formats.
+        GLint m_view_location; ///< Location of the quad scale and offset of zoom, pan and letterbox.
+        GLint m_texture_rect_location; ///< Location of the texture coordinate scale and offset of the quad.
+        GLint m_layers_location; ///< Location of the mosaic texture array sampler.
+        GLint m_is_layered_location; ///< Location of the selector between the planes and the mosaic layers.
+        GLint m_grid_location; ///< Location of the instanced grid size, 1x1 for a single image.
+        UploadMode m_upload_mode; ///< Texture upload strategy of this window.
+        SurfaceMode m_surface_mode; ///< Where this window draws its frames.
+        GLuint m_framebuffer; ///< Offscreen framebuffer object, 0 for the window's own framebuffer.
+        GLuint m_color_renderbuffer; ///< Color attachment of the offscreen framebuffer.
+        int m_surface_width; ///< Width of the offscreen framebuffer.
+        int m_surface_height; ///< Height of the offscreen framebuffer.
+        GLuint m_textures[m_max_plane_count]; ///< Plane texture ids of this window.
+        int m_texture_width; ///< Image width of the allocated texture storage.
+        int m_texture_height; ///< Image height of the allocated texture storage.
+        PixelFormat m_texture_format; ///< Pixel format of the allocated texture storage.
+        bool m_is_texture_compressed; ///< Set while plane 0 holds a block compressed frame.
+        CompressedFormat m_texture_compression; ///< Compressed format of plane 0 while `m_is_texture_compressed` is set.
+        GLuint m_pbo_ids[m_pbo_count]; ///< Pixel unpack buffers of the upload ring.
+        GLsync m_pbo_fences[m_pbo_count]; ///< Fences of the transfers reading each pixel unpack buffer.
+        uint8_t* m_pbo_mapped_ptrs[m_pbo_count]; ///< Persistent mappings of the buffers, nullptrs without buffer storage support.
+        uint8_t* m_acquired_ptr; ///< Buffer handed out by `acquire_frame` and not submitted yet.
+        int m_pbo_index; ///< Index of the pixel unpack buffer which will be written next.
+        size_t m_pbo_size; ///< Size of each pixel unpack buffer in bytes.
+        std::atomic<int> m_viewport_width; ///< Latest window width reported by the resize callback.
+        std::atomic<int> m_viewport_height; ///< Latest window height reported by the resize callback.
+        std::atomic<bool> m_is_viewport_dirty; ///< Set when the viewport must be updated before drawing.
+        std::mutex m_display_mutex; ///< Guards display settings written by the setters.
+        std::atomic<bool> m_is_display_dirty; ///< Set when the setters changed a display setting.
+        bool m_has_display_range; ///< Set when the user gave a display range, guarded by `m_display_mutex`.
+        bool m_is_auto_display_range; ///< Set when the display range follows each frame, guarded by `m_display_mutex`.
+        float m_display_minimum; ///< User display range minimum, guarded by `m_display_mutex`.
+        float m_display_maximum; ///< User display range maximum, guarded by `m_display_mutex`.
+        std::vector<uint8_t> m_pending_colormap; ///< Colormap table waiting for upload, guarded by `m_display_mutex`.
+        float m_display_zoom; ///< User zoom, guarded by `m_display_mutex`.
+        float m_display_center_x; ///< User view center column, guarded by `m_display_mutex`.
+        float m_display_center_y; ///< User view center row, guarded by `m_display_mutex`.
+        AspectMode m_display_aspect_mode; ///< User aspect mode, guarded by `m_display_mutex`.
+        std::vector<OverlayInstance> m_pending_overlay; ///< Overlay waiting for upload, guarded by `m_display_mutex`.
+        bool m_has_pending_overlay; ///< Set when the overlay was replaced, guarded by `m_display_mutex`.
+        GLuint m_overlay_VAO; ///< Vertex array of the overlay instances, 0 until an overlay is set.
+        GLuint m_overlay_program; ///< Overlay program of this window, linked with `m_overlay_VAO`.
+        GLint m_overlay_view_location; ///< Location of the image quad scale and offset in the overlay program.
+        GLint m_overlay_image_size_location; ///< Location of the image size in the overlay program.
+        GLint m_overlay_viewport_size_location; ///< Location of the viewport size in the overlay program.
+        GLuint m_overlay_buffer; ///< Instance buffer of the overlay.
+        size_t m_overlay_buffer_size; ///< Allocated bytes of `m_overlay_buffer`.
+        GLsizei m_overlay_instance_count; ///< Instances drawn over every frame.
+        GLuint m_colormap_texture; ///< 1D colormap lookup texture.
+        bool m_use_display_range; ///< Render side copy of `m_has_display_range`.
+        bool m_use_auto_display_range; ///< Render side copy of `m_is_auto_display_range`.
+        float m_level_minimum; ///< Display range minimum used by the next draw.
+        float m_level_maximum; ///< Display range maximum used by the next draw.
+        float m_auto_minimum; ///< Minimum of the last uploaded frame in auto mode.
+        float m_auto_maximum; ///< Maximum of the last uploaded frame in auto mode.
+        float m_zoom; ///< Zoom used by the next draw.
+        float m_center_x; ///< View center column used by the next draw.
+        float m_center_y; ///< View center row used by the next draw.
+        AspectMode m_aspect_mode; ///< Aspect mode used by the next draw.
+        bool m_is_mipmap_filter; ///< Set while the plane textures are minified through mipmaps.
+        bool m_are_mipmaps_dirty; ///< Set when the base level changed after the mipmaps were built.
+        std::vector<Rect> m_dirty_regions; ///< Regions of the frame being uploaded.
+        std::vector<uint8_t> m_decompressed_frame; ///< RGBA copy of compressed frames the driver can not sample.
+        ChangeDetector m_change_detector; ///< Previous frame for change detection.
+        ImageLayout m_frame_layout; ///< Storage of the last frame passed by pointer.
+        uint64_t m_frame_generation; ///< Generation of the resident frame, 0 if unknown.
+        ShownContent m_shown_content; ///< What the last present showed.
+        std::atomic<bool> m_needs_redraw; ///< Set when the window's content was damaged.
+        std::mutex m_redraw_listener_mutex; ///< Guards the redraw listener against removal during a call.
+        RedrawListener m_redraw_listener; ///< Called when a redraw is requested, guarded by `m_redraw_listener_mutex`.
+        void* m_redraw_listener_user_data; ///< User data of `m_redraw_listener`.
+        std::atomic<uint64_t> m_redundant_frame_count; ///< Unchanged frames which were not presented.
+        std::atomic<bool> m_is_change_detection_enabled; ///< Set when unchanged tiles are not uploaded.
+        std::atomic<CompressedUpload> m_compressed_upload; ///< Upload path of compressed frames.
+        std::atomic<uint64_t> m_uploaded_bytes; ///< Bytes uploaded since the window was created.
+        std::atomic<uint64_t> m_skipped_bytes; ///< Bytes not uploaded because they did not change.
+        FrameProfiler m_frame_profiler; ///< Stage timings of the presented frames.
+        FrameCapture m_frame_capture; ///< Asynchronous readback of the presented frames.
+        FramePacer m_frame_pacer; ///< Swap interval, frame rate limiter and present intervals.
+        GLStateCache m_gl_state; ///< OpenGL state of this window's context.
+        TileCache m_tile_cache; ///< Resident tiles of the tiled image.
+        MosaicTexture m_mosaic; ///< Stream layers of the mosaic grid.
+        std::vector<TileDraw> m_tile_draws; ///< Visible tiles of the current frame.
+        std::vector<TileDraw> m_fallback_tile_draws; ///< Coarser tiles shown in place of missing ones.
+        uint64_t m_tile_frame_index; ///< Counts the frames of the tiled image.
+        std::atomic<uint32_t> m_gl_call_count; ///< OpenGL calls of the last presented frame.
+        std::atomic<uint32_t> m_gl_skipped_call_count; ///< Redundant OpenGL calls skipped in the last presented frame.
+        SpscQueue<WindowEvent, 64> m_events; ///< Events pushed by the pumping thread.
+        std::atomic<uint64_t> m_dropped_event_count; ///< Events lost because the queue was full.
+        bool m_is_debug_output_enabled; ///< Set when this window's context reports errors through `GL_DEBUG_OUTPUT`.
 
     ////////////////////////////////////////////////////////////////////////////
     // Protected Members
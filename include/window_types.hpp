@@ -0,0 +1,427 @@
+///
+/// @file window_types.hpp
+/// @author Yasin BASAR
+/// @brief Common types shared by the public window API and its implementation.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#ifndef WINDOW_TYPES_HPP
+#define WINDOW_TYPES_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Forward and Typedef Declarations
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @enum UploadMode
+    /// @brief Selects how image buffers are transferred to the GPU.
+    enum class UploadMode : uint8_t
+    {
+        Direct, ///< Texture is updated straight from the caller's buffer.
+        PixelBufferRing ///< Caller's buffer is copied into a ring of pixel
+                        ///< unpack buffers and the texture is updated
+                        ///< asynchronously by the GPU.
+    };
+
+    /// @enum SurfaceMode
+    /// @brief Selects where frames are drawn.
+    enum class SurfaceMode : uint8_t
+    {
+        Window, ///< Frames are presented in a visible window.
+        Offscreen ///< Frames are drawn into a framebuffer object of a hidden
+                  ///< window and can be read back. Without a display server
+                  ///< GLFW's null platform with OSMesa is used when it is the
+                  ///< first window, later `Window` surfaces are rejected then.
+    };
+
+    /// @enum PixelFormat
+    /// @brief Memory layout of an image buffer. Planar formats expect their
+    ///        planes one after another in the same buffer. YUV formats are
+    ///        converted with BT.601 limited range coefficients.
+    enum class PixelFormat : uint8_t
+    {
+        RGBA, ///< 4 channel, 8 bit per channel.
+        BGRA, ///< 4 channel, 8 bit per channel, OpenCV channel order.
+        RGB, ///< 3 channel, 8 bit per channel.
+        BGR, ///< 3 channel, 8 bit per channel, OpenCV channel order.
+        Gray, ///< 1 channel, 8 bit.
+        NV12, ///< Y plane followed by an interleaved half resolution UV plane.
+        I420, ///< Y plane followed by half resolution U and V planes.
+        YUYV, ///< Packed 4:2:2, Y0 U Y1 V for every pixel pair. The width must be even.
+        R16, ///< 1 channel, 16 bit unsigned integer.
+        R16F, ///< 1 channel, 16 bit float.
+        R32F ///< 1 channel, 32 bit float.
+    };
+
+    /// @enum CompressedFormat
+    /// @brief Block compressed image data as texture tools and asset stores
+    ///        write it. Images are split into 4x4 pixel blocks, rows of
+    ///        blocks follow each other without padding and blocks on the
+    ///        right and bottom edges are complete even when the image size is
+    ///        not a multiple of 4.
+    enum class CompressedFormat : uint8_t
+    {
+        BC1, ///< S3TC DXT1, RGB with 1 bit alpha, 8 bytes per block.
+        BC3, ///< S3TC DXT5, RGBA, 16 bytes per block.
+        BC7, ///< BPTC, RGBA, 16 bytes per block.
+        ETC2RGB, ///< ETC2 RGB8, 8 bytes per block.
+        ETC2RGBA ///< ETC2 RGBA8 with EAC alpha, 16 bytes per block.
+    };
+
+    /// @enum CompressedUpload
+    /// @brief Selects how block compressed frames reach the texture.
+    enum class CompressedUpload : uint8_t
+    {
+        Auto, ///< Blocks are uploaded when the driver samples the format, except on
+              ///< software rasterizers such as llvmpipe, which decode the blocks on
+              ///< every texture fetch and are faster with RGBA decoded once.
+        Native, ///< Blocks are uploaded whenever the driver samples the format.
+        Decode ///< Frames are always decoded to RGBA on the CPU.
+    };
+
+    /// @enum Colormap
+    /// @brief Pseudo-color applied to single channel formats
+    ///        (`Gray`, `R16`, `R16F`, `R32F`) after the display range.
+    enum class Colormap : uint8_t
+    {
+        Gray, ///< Grayscale ramp, no pseudo-color.
+        Jet, ///< Blue to red rainbow.
+        Viridis, ///< Perceptually uniform, blue to yellow.
+        Inferno, ///< Perceptually uniform, black to yellow through red.
+        Custom ///< Table given with `set_custom_colormap`.
+    };
+
+    /// @enum AspectMode
+    /// @brief Selects how an image is fitted into its window.
+    enum class AspectMode : uint8_t
+    {
+        Stretch, ///< Image covers the whole window, its aspect ratio is not kept.
+        Letterbox ///< Image keeps its aspect ratio, black bars fill the rest.
+    };
+
+    /// @struct Rect
+    /// @brief Rectangular region of an image in pixels.
+    struct Rect
+    {
+        int x; ///< Left column.
+        int y; ///< Top row.
+        int width; ///< Number of columns.
+        int height; ///< Number of rows.
+    };
+
+    /// @struct FrameView
+    /// @brief Image inside a caller buffer whose rows are padded or which
+    ///        holds a larger picture, shown without repacking it first.
+    ///        Planes of planar formats follow each other in the buffer, each
+    ///        `row_pitch * plane height` bytes long. `NV12` chroma rows use
+    ///        `row_pitch`, `I420` chroma rows use half of it, rounded up.
+    struct FrameView
+    {
+        const uint8_t* data_ptr; ///< First byte of the buffer.
+        int buffer_width; ///< Width of the whole buffer in pixels.
+        int buffer_height; ///< Height of the whole buffer in pixels.
+        PixelFormat format; ///< Memory layout of the buffer.
+        size_t row_pitch; ///< Bytes between the starts of two rows, 0 for tightly packed rows.
+        Rect region; ///< Shown part of the buffer, a zero size shows all of it.
+                     ///< Subsampled formats need an even x (and an even y for `NV12` and `I420`).
+    };
+
+    /// @struct UploadStatistics
+    /// @brief Image bytes transferred to the GPU and bytes left out because
+    ///        they did not change, counted since the window was created.
+    struct UploadStatistics
+    {
+        uint64_t uploaded_bytes; ///< Bytes of updated regions.
+        uint64_t skipped_bytes; ///< Bytes of unchanged regions.
+    };
+
+    /// @struct TimingPercentiles
+    /// @brief Percentiles of the durations of a frame stage over the
+    ///        recent frames, in milliseconds. Zero until a sample exists.
+    struct TimingPercentiles
+    {
+        double p50_ms; ///< Median duration.
+        double p95_ms; ///< 95th percentile duration.
+        double p99_ms; ///< 99th percentile duration.
+    };
+
+    /// @struct FrameStatistics
+    /// @brief Timings of the recent frames of a window and frame counters.
+    ///        GPU timings lag a few frames behind the CPU timings.
+    struct FrameStatistics
+    {
+        TimingPercentiles poll_events; ///< CPU time of pumping window events.
+        TimingPercentiles upload; ///< CPU time of updating the textures.
+        TimingPercentiles draw; ///< CPU time of recording the draw.
+        TimingPercentiles swap; ///< CPU time of presenting, includes vsync and frame rate limiter waits.
+        TimingPercentiles gpu_upload; ///< GPU time of the texture transfers.
+        TimingPercentiles gpu_draw; ///< GPU time of the draw.
+        uint64_t presented_frame_count; ///< Frames presented since the window was created.
+        uint64_t dropped_frame_count; ///< Submitted frames which were never presented.
+        uint64_t redundant_frame_count; ///< Unchanged frames which were neither drawn nor presented.
+        uint64_t dropped_event_count; ///< Window events lost because the event queue was full.
+        uint32_t gl_call_count; ///< OpenGL calls issued for the last presented frame.
+        uint32_t gl_skipped_call_count; ///< Redundant state changes skipped for the last presented frame.
+    };
+
+    /// @enum WindowEventType
+    /// @brief Kind of a window event.
+    enum class WindowEventType : uint8_t
+    {
+        Key, ///< A key was pressed, repeated or released.
+        Resize, ///< The window size changed.
+        Close ///< The user requested to close the window.
+    };
+
+    /// @struct WindowEvent
+    /// @brief Event of a window, delivered through the window's event queue.
+    struct WindowEvent
+    {
+        WindowEventType type; ///< Kind of the event.
+        int key; ///< GLFW key code of `Key` events.
+        int action; ///< GLFW action (press, release, repeat) of `Key` events.
+        int width; ///< New width of `Resize` events.
+        int height; ///< New height of `Resize` events.
+    };
+
+    /// @enum PresentPolicy
+    /// @brief Selects how the render thread consumes submitted frames.
+    enum class PresentPolicy : uint8_t
+    {
+        Fifo, ///< Every submitted frame is presented in order.
+              ///< Submission fails while the queue is full.
+        Mailbox ///< Only the latest submitted frame is presented, a pending
+                ///< frame is released and counted as dropped when a newer one
+                ///< is submitted.
+    };
+
+    /// @brief Reads one tile of a tiled image, e.g. from a memory-mapped file.
+    ///        It is called from the thread which shows the image.
+    /// @param level[in] Pyramid level, 0 is full resolution and every level
+    ///        halves the previous one, rounded up
+    /// @param tile_x[in] Tile column in the level
+    /// @param tile_y[in] Tile row in the level
+    /// @param data_ptr[out] Tile buffer of `tile_size` x `tile_size` pixels
+    ///        without row padding. Tiles at the right and bottom edges
+    ///        only fill their top left part.
+    /// @param user_data[in] User data of the tile source
+    /// @return false if the tile could not be read, it is retried later
+    using TileReadCallback = bool (*)(int level,
+                                      int tile_x,
+                                      int tile_y,
+                                      uint8_t* data_ptr,
+                                      void* user_data);
+
+    /// @struct TileSource
+    /// @brief Image which is larger than a texture can be and is displayed
+    ///        from a pyramid of tiles. Only the tiles visible at the current
+    ///        view are read and uploaded.
+    struct TileSource
+    {
+        int width; ///< Full resolution width in pixels.
+        int height; ///< Full resolution height in pixels.
+        int tile_size; ///< Tile edge length in pixels, e.g. 256 or 512.
+        int level_count; ///< Number of pyramid levels the source provides.
+        PixelFormat format; ///< Single plane format, not `YUYV` or a planar YUV format.
+        TileReadCallback read_tile; ///< Reads a tile into the given buffer.
+        void* user_data; ///< Passed to every `read_tile` call.
+    };
+
+    /// @struct MosaicLayout
+    /// @brief Grid of streams shown together in one window. Every stream is
+    ///        a layer of one texture array, so all of them share a size and
+    ///        a format and the whole grid is drawn with a single draw call.
+    struct MosaicLayout
+    {
+        int columns; ///< Tiles per grid row, 0 leaves the mosaic mode.
+        int rows; ///< Grid rows.
+        int tile_width; ///< Frame width of every stream.
+        int tile_height; ///< Frame height of every stream.
+        PixelFormat format; ///< Single plane format, not `YUYV` or a planar YUV format.
+    };
+
+    /// @enum DebugSeverity
+    /// @brief Severity of a message reported by the OpenGL driver.
+    enum class DebugSeverity : uint8_t
+    {
+        Notification, ///< Informational, e.g. buffer placement hints.
+        Low, ///< Redundant state changes and minor performance issues.
+        Medium, ///< Major performance warnings and deprecated usage.
+        High ///< Errors and undefined behavior.
+    };
+
+    /// @brief Receives OpenGL errors and driver messages. It can be called
+    ///        from a driver thread, so it must be thread safe.
+    /// @param severity[in] Severity of the message
+    /// @param message[in] Null terminated message, valid during the call
+    /// @param user_data[in] User data which was passed to `set_debug_logger`
+    using DebugLogger = void (*)(DebugSeverity severity, const char* message, void* user_data);
+
+    /// @struct OverlayBox
+    /// @brief Axis aligned rectangle drawn over the image, e.g. a detection.
+    ///        Positions are image pixels, so overlays follow zoom and pan.
+    ///        Colors are packed as 0xRRGGBBAA.
+    struct OverlayBox
+    {
+        float x; ///< Left column in image pixels.
+        float y; ///< Top row in image pixels.
+        float width; ///< Width in image pixels.
+        float height; ///< Height in image pixels.
+        float thickness; ///< Outline width in window pixels, 0 fills the box.
+        uint32_t color; ///< 0xRRGGBBAA
+    };
+
+    /// @struct OverlayLine
+    /// @brief Line segment drawn over the image.
+    struct OverlayLine
+    {
+        float x0; ///< First end column in image pixels.
+        float y0; ///< First end row in image pixels.
+        float x1; ///< Second end column in image pixels.
+        float y1; ///< Second end row in image pixels.
+        float thickness; ///< Width in window pixels.
+        uint32_t color; ///< 0xRRGGBBAA
+    };
+
+    /// @struct OverlayPoint
+    /// @brief Round dot drawn over the image, e.g. a keypoint.
+    struct OverlayPoint
+    {
+        float x; ///< Center column in image pixels.
+        float y; ///< Center row in image pixels.
+        float size; ///< Diameter in window pixels.
+        uint32_t color; ///< 0xRRGGBBAA
+    };
+
+    /// @struct OverlayText
+    /// @brief Single line of ASCII text drawn over the image from a built-in
+    ///        8x8 glyph atlas. Its size does not change with the zoom.
+    struct OverlayText
+    {
+        float x; ///< Left column of the first glyph in image pixels.
+        float y; ///< Top row of the glyphs in image pixels.
+        float size; ///< Glyph height and advance in window pixels, multiples of 8 stay sharp.
+        uint32_t color; ///< 0xRRGGBBAA
+        uint32_t background_color; ///< 0xRRGGBBAA of the box behind the text, 0 for none.
+        const char* text; ///< Null terminated text, only read during the call.
+    };
+
+    /// @struct Overlay
+    /// @brief Primitives drawn over every frame until the overlay is replaced.
+    ///        Empty arrays can be nullptr.
+    struct Overlay
+    {
+        const OverlayBox* boxes; ///< Rectangles.
+        int box_count; ///< Number of rectangles.
+        const OverlayLine* lines; ///< Line segments.
+        int line_count; ///< Number of line segments.
+        const OverlayPoint* points; ///< Dots.
+        int point_count; ///< Number of dots.
+        const OverlayText* texts; ///< Text labels, drawn last.
+        int text_count; ///< Number of text labels.
+    };
+
+    /// @enum CaptureFileFormat
+    /// @brief Stream format of a capture written to a file.
+    enum class CaptureFileFormat : uint8_t
+    {
+        Raw, ///< RGBA frames one after another, top row first, no header.
+        Y4M ///< YUV4MPEG2 stream of I420 frames, BT.601 limited range.
+            ///< Frames of another size than the first one are dropped.
+    };
+
+    /// @brief Receives a captured frame on the capture worker thread.
+    /// @param rgba_ptr[in] RGBA pixels, top row first, valid during the call
+    /// @param frame_width[in] Width of the captured framebuffer
+    /// @param frame_height[in] Height of the captured framebuffer
+    /// @param frame_index[in] Index of the frame since the capture started,
+    ///        gaps are frames which were dropped
+    /// @param user_data[in] User data of the capture settings
+    using CaptureCallback = void (*)(const uint8_t* rgba_ptr,
+                                     int frame_width,
+                                     int frame_height,
+                                     uint64_t frame_index,
+                                     void* user_data);
+
+    /// @struct CaptureSettings
+    /// @brief Destination of the presented frames while a capture runs.
+    ///        Either `callback` or `file_path` is set.
+    struct CaptureSettings
+    {
+        CaptureCallback callback; ///< Receives every captured frame, nullptr to write a file.
+        void* user_data; ///< Passed to every `callback` call.
+        const char* file_path; ///< File which is created, used if `callback` is nullptr.
+        CaptureFileFormat file_format; ///< Stream format of the file.
+        double frame_rate; ///< Frame rate written into Y4M headers.
+        int frames_in_flight; ///< Readbacks the GPU may still be working on, 2 to 8.
+                              ///< More frames hide longer GPU latencies.
+    };
+
+    /// @struct CaptureStatistics
+    /// @brief Frame counters of the running or the last capture.
+    struct CaptureStatistics
+    {
+        uint64_t captured_frame_count; ///< Frames delivered or written.
+        uint64_t dropped_frame_count; ///< Presented frames which were not captured because
+                                      ///< every readback was in flight or the worker fell behind.
+    };
+
+    /// @enum PacingMode
+    /// @brief Selects when frames of a window are presented.
+    enum class PacingMode : uint8_t
+    {
+        Unlimited, ///< Frames are presented as soon as they are drawn, swap interval 0.
+        VSync, ///< Every present waits for the vertical blank, swap interval 1.
+        AdaptiveVSync, ///< Late frames are presented at once and may tear instead of waiting
+                       ///< a whole refresh, swap interval -1. Falls back to `VSync` without
+                       ///< `WGL_EXT_swap_control_tear` or `GLX_EXT_swap_control_tear`.
+        TargetRate, ///< Frames are presented at `target_frame_rate` without vsync.
+        LowLatency ///< Vsync without queued frames, the caller is released just in time to
+                   ///< draw its next frame before the next vertical blank.
+    };
+
+    /// @struct PacingSettings
+    /// @brief Frame pacing of a window.
+    struct PacingSettings
+    {
+        PacingMode mode; ///< When frames are presented.
+        double target_frame_rate; ///< Frames per second of `TargetRate`, ignored by other modes.
+    };
+
+    /// @struct PacingStatistics
+    /// @brief Measured intervals between the recent presents of a window.
+    struct PacingStatistics
+    {
+        TimingPercentiles frame_interval; ///< Time from one present to the next.
+        double mean_interval_ms; ///< Average interval.
+        double jitter_ms; ///< Standard deviation of the intervals.
+        uint64_t late_frame_count; ///< Frames presented more than half a period after their time, since the pacing mode was set.
+        int swap_interval; ///< Swap interval in use, -1 for adaptive vsync.
+    };
+
+    /// @brief Called when the library does not need a submitted buffer anymore
+    ///        and the producer can reuse it. It is called from the render thread,
+    ///        or from `submit_frame` for a mailbox frame which was replaced.
+    /// @param data_ptr[in] Buffer which was passed to `submit_frame`
+    /// @param user_data[in] User data which was passed to `submit_frame`
+    using FrameReleaseCallback = void (*)(const uint8_t* data_ptr, void* user_data);
+
+} // YB
+
+#endif // WINDOW_TYPES_HPP
+
+/* End of File */
@@ -0,0 +1,598 @@
+///
+/// @file benchmark_main.cpp
+/// @author Yasin BASAR
+/// @brief Measures the display path of Window Creator. Sweeps resolution,
+///        pixel or compressed format, upload mode, window count and vsync,
+///        every case runs for a fixed duration and the results are written
+///        as JSON.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <window_creator.hpp>
+#include <window_group.hpp>
+#include "compressed_format.hpp"
+#include "pixel_format.hpp"
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    constexpr int max_window_count = 4;
+    constexpr int window_width = 640;
+    constexpr int window_height = 360;
+
+    struct Resolution
+    {
+        const char* name;
+        int width;
+        int height;
+    };
+
+    struct Format
+    {
+        YB::PixelFormat format;
+        const char* name;
+    };
+
+    struct CompressedInput
+    {
+        YB::CompressedFormat format;
+        const char* name;
+    };
+
+    /// @brief One measured configuration.
+    struct Case
+    {
+        Resolution resolution;
+        Format format;
+        YB::UploadMode upload_mode;
+        int window_count; ///< 0 for `image_show` on one window, otherwise a `WindowGroup`
+        bool is_vsync;
+        bool is_cpu_conversion; ///< Converted to RGBA on the CPU before the upload, compressed frames by the library
+        const CompressedInput* compressed; ///< Block compressed frames, nullptr for `format`
+    };
+
+    /// @brief Measurements of one case.
+    struct Result
+    {
+        uint64_t frame_count;
+        double seconds;
+        double uploaded_bytes;
+        double p50_ms;
+        double p99_ms;
+    };
+
+    constexpr Resolution resolutions[] =
+    {
+        {"VGA", 640, 480},
+        {"HD", 1280, 720},
+        {"FHD", 1920, 1080},
+        {"4K", 3840, 2160},
+        {"8K", 7680, 4320}
+    };
+
+    constexpr Format formats[] =
+    {
+        {YB::PixelFormat::RGBA, "RGBA"},
+        {YB::PixelFormat::RGB, "RGB"},
+        {YB::PixelFormat::BGR, "BGR"},
+        {YB::PixelFormat::Gray, "Gray"},
+        {YB::PixelFormat::NV12, "NV12"},
+        {YB::PixelFormat::I420, "I420"},
+        {YB::PixelFormat::YUYV, "YUYV"},
+        {YB::PixelFormat::R16, "R16"}
+    };
+
+    constexpr CompressedInput compressed_inputs[] =
+    {
+        {YB::CompressedFormat::BC1, "BC1"},
+        {YB::CompressedFormat::BC3, "BC3"},
+        {YB::CompressedFormat::BC7, "BC7"},
+        {YB::CompressedFormat::ETC2RGB, "ETC2RGB"},
+        {YB::CompressedFormat::ETC2RGBA, "ETC2RGBA"}
+    };
+
+    /// @brief Converts one BT.601 limited range YUV sample to RGBA.
+    inline void yuv_to_rgba(int y, int u, int v, uint8_t* rgba)
+    {
+        const int c = 298 * (y - 16);
+        const int d = u - 128;
+        const int e = v - 128;
+
+        rgba[0] = static_cast<uint8_t>(std::clamp((c + 409 * e + 128) >> 8, 0, 255));
+        rgba[1] = static_cast<uint8_t>(std::clamp((c - 100 * d - 208 * e + 128) >> 8, 0, 255));
+        rgba[2] = static_cast<uint8_t>(std::clamp((c + 516 * d + 128) >> 8, 0, 255));
+        rgba[3] = 255;
+    }
+
+    /// @brief Reference CPU path, what callers had to do before `PixelFormat`.
+    void convert_to_rgba(const uint8_t* src,
+                         YB::PixelFormat format,
+                         int frame_width,
+                         int frame_height,
+                         uint8_t* dst)
+    {
+        const int pixel_count = frame_width * frame_height;
+        const int chroma_width = frame_width / 2;
+        const uint8_t* luma = src;
+        const uint8_t* chroma = src + pixel_count;
+
+        for (int y = 0; y < frame_height; ++y)
+        {
+            for (int x = 0; x < frame_width; ++x)
+            {
+                const int idx = y * frame_width + x;
+                const int chroma_idx = (y / 2) * chroma_width + x / 2;
+                uint8_t* out = dst + 4 * idx;
+
+                switch (format)
+                {
+                    case YB::PixelFormat::RGB:
+                        out[0] = src[3 * idx];
+                        out[1] = src[3 * idx + 1];
+                        out[2] = src[3 * idx + 2];
+                        out[3] = 255;
+                    break;
+                    case YB::PixelFormat::BGR:
+                        out[0] = src[3 * idx + 2];
+                        out[1] = src[3 * idx + 1];
+                        out[2] = src[3 * idx];
+                        out[3] = 255;
+                    break;
+                    case YB::PixelFormat::Gray:
+                        out[0] = out[1] = out[2] = src[idx];
+                        out[3] = 255;
+                    break;
+                    case YB::PixelFormat::NV12:
+                        yuv_to_rgba(luma[idx],
+                                    chroma[2 * chroma_idx],
+                                    chroma[2 * chroma_idx + 1],
+                                    out);
+                    break;
+                    case YB::PixelFormat::I420:
+                        yuv_to_rgba(luma[idx],
+                                    chroma[chroma_idx],
+                                    chroma[pixel_count / 4 + chroma_idx],
+                                    out);
+                    break;
+                    case YB::PixelFormat::YUYV:
+                    {
+                        const uint8_t* pair = src + 4 * (idx / 2);
+                        yuv_to_rgba(pair[(x % 2) * 2], pair[1], pair[3], out);
+                    }
+                    break;
+                    default:
+                    break;
+                }
+            }
+        }
+    }
+
+    /// @brief Returns the value at a percentile of sorted samples.
+    double get_percentile(const std::vector<double>& sorted_samples, double percentile)
+    {
+        if (sorted_samples.empty())
+        {
+            return 0.0;
+        }
+
+        const size_t idx = static_cast<size_t>(percentile * (sorted_samples.size() - 1) + 0.5);
+        return sorted_samples[idx];
+    }
+
+    /// @brief Windows reused by every case, GLFW windows are expensive to create.
+    struct WindowPool
+    {
+        std::vector<std::unique_ptr<YB::WindowCreator>> windows; ///< Swap interval 0, shared by groups
+        std::unique_ptr<YB::WindowCreator> vsync_window; ///< Swap interval 1, never added to a group
+    };
+
+    /// @brief Runs one case for a fixed duration.
+    Result run_case(const Case& bench_case,
+                    WindowPool& pool,
+                    double duration,
+                    volatile bool& exit_status)
+    {
+        const int frame_width = bench_case.resolution.width;
+        const int frame_height = bench_case.resolution.height;
+
+        const size_t frame_size = bench_case.compressed
+                                  ? YB::get_compressed_layout(bench_case.compressed->format,
+                                                              frame_width,
+                                                              frame_height).image_size
+                                  : YB::get_image_layout(bench_case.format.format,
+                                                         frame_width,
+                                                         frame_height).frame_size;
+
+        std::vector<uint8_t> frame(frame_size);
+
+        for (size_t idx = 0; idx < frame.size(); ++idx)
+        {
+            frame[idx] = static_cast<uint8_t>(idx * 7);
+        }
+
+        // Compressed frames are decoded by `image_show` itself, the case
+        // only selects the path with `set_compressed_upload`
+        const bool is_bench_conversion = bench_case.is_cpu_conversion && !bench_case.compressed;
+
+        std::vector<uint8_t> rgba_frame;
+
+        if (is_bench_conversion)
+        {
+            rgba_frame.resize(4 * static_cast<size_t>(frame_width) * frame_height);
+        }
+
+        const uint8_t* upload_ptr = is_bench_conversion ? rgba_frame.data() : frame.data();
+        const YB::PixelFormat upload_format = is_bench_conversion
+                                              ? YB::PixelFormat::RGBA
+                                              : bench_case.format.format;
+        const size_t upload_size = bench_case.is_cpu_conversion
+                                   ? 4 * static_cast<size_t>(frame_width) * frame_height
+                                   : frame.size();
+
+        std::unique_ptr<YB::WindowGroup> group;
+        YB::WindowCreator* single_window = nullptr;
+
+        if (bench_case.window_count > 0)
+        {
+            group = std::make_unique<YB::WindowGroup>(bench_case.is_vsync);
+
+            for (int idx = 0; idx < bench_case.window_count; ++idx)
+            {
+                group->add_window(*pool.windows[idx]);
+            }
+        }
+        else
+        {
+            single_window = bench_case.is_vsync ? pool.vsync_window.get() : pool.windows[0].get();
+
+            if (bench_case.compressed)
+            {
+                single_window->set_compressed_upload(bench_case.is_cpu_conversion
+                                                     ? YB::CompressedUpload::Decode
+                                                     : YB::CompressedUpload::Native);
+            }
+        }
+
+        const int windows_per_frame = std::max(bench_case.window_count, 1);
+
+        // Warm up allocates the texture storage and the upload ring
+        for (int idx = 0; idx < 3 && !exit_status; ++idx)
+        {
+            if (group)
+            {
+                for (int window_idx = 0; window_idx < bench_case.window_count; ++window_idx)
+                {
+                    group->set_frame(*pool.windows[window_idx], upload_ptr, frame_width, frame_height, upload_format);
+                }
+                group->present(exit_status);
+            }
+            else if (bench_case.compressed)
+            {
+                single_window->image_show(upload_ptr, frame_width, frame_height, bench_case.compressed->format, exit_status);
+            }
+            else
+            {
+                single_window->image_show(upload_ptr, frame_width, frame_height, upload_format, exit_status);
+            }
+        }
+
+        std::vector<double> latencies;
+        latencies.reserve(4096);
+
+        const auto begin = clock::now();
+        auto now = begin;
+
+        while (!exit_status
+               && std::chrono::duration<double>(now - begin).count() < duration)
+        {
+            const auto frame_begin = clock::now();
+
+            if (is_bench_conversion)
+            {
+                convert_to_rgba(frame.data(),
+                                bench_case.format.format,
+                                frame_width,
+                                frame_height,
+                                rgba_frame.data());
+            }
+
+            if (group)
+            {
+                for (int window_idx = 0; window_idx < bench_case.window_count; ++window_idx)
+                {
+                    group->set_frame(*pool.windows[window_idx], upload_ptr, frame_width, frame_height, upload_format);
+                }
+                group->present(exit_status);
+            }
+            else if (bench_case.compressed)
+            {
+                single_window->image_show(upload_ptr, frame_width, frame_height, bench_case.compressed->format, exit_status);
+            }
+            else
+            {
+                single_window->image_show(upload_ptr, frame_width, frame_height, upload_format, exit_status);
+            }
+
+            now = clock::now();
+            latencies.push_back(std::chrono::duration<double, std::milli>(now - frame_begin).count());
+        }
+
+        if (single_window && bench_case.compressed)
+        {
+            single_window->set_compressed_upload(YB::CompressedUpload::Auto);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        Result result{};
+        result.frame_count = latencies.size();
+        result.seconds = std::chrono::duration<double>(now - begin).count();
+        result.uploaded_bytes = static_cast<double>(upload_size) * windows_per_frame * latencies.size();
+        result.p50_ms = get_percentile(latencies, 0.50);
+        result.p99_ms = get_percentile(latencies, 0.99);
+
+        return result;
+    }
+
+    /// @brief Builds the list of cases of the sweep.
+    std::vector<Case> make_cases(bool is_quick,
+                                 bool is_vsync_available,
+                                 const YB::WindowCreator& window)
+    {
+        std::vector<Case> cases;
+
+        const YB::UploadMode upload_modes[] = {YB::UploadMode::Direct, YB::UploadMode::PixelBufferRing};
+        const Resolution& fhd = resolutions[2];
+        const Format& rgba = formats[0];
+
+        // Upload throughput, one window
+        for (const Resolution& resolution : resolutions)
+        {
+            if (is_quick && resolution.width > fhd.width)
+            {
+                continue;
+            }
+
+            for (const Format& format : formats)
+            {
+                for (YB::UploadMode upload_mode : upload_modes)
+                {
+                    cases.push_back({resolution, format, upload_mode, 0, false, false, nullptr});
+                }
+            }
+        }
+
+        // Conversion on the CPU and an RGBA upload, the path before `PixelFormat`
+        for (const Format& format : formats)
+        {
+            if (YB::PixelFormat::RGBA != format.format && YB::PixelFormat::R16 != format.format)
+            {
+                cases.push_back({fhd, format, YB::UploadMode::Direct, 0, false, true, nullptr});
+            }
+        }
+
+        // Pre-compressed frames uploaded as blocks, and decoded on the CPU
+        // to an RGBA upload, both forced so `CompressedUpload::Auto` can be
+        // checked against them
+        for (const CompressedInput& compressed : compressed_inputs)
+        {
+            std::fprintf(stderr,
+                         "%s is %s by default\n",
+                         compressed.name,
+                         window.is_compressed_upload_native(compressed.format) ? "uploaded as blocks" : "decoded on the CPU");
+        }
+
+        for (const Resolution& resolution : {resolutions[2], resolutions[3]})
+        {
+            if (is_quick && resolution.width > fhd.width)
+            {
+                continue;
+            }
+
+            for (const CompressedInput& compressed : compressed_inputs)
+            {
+                if (window.is_compressed_format_supported(compressed.format))
+                {
+                    cases.push_back({resolution, rgba, YB::UploadMode::Direct, 0, false, false, &compressed});
+                }
+                else
+                {
+                    std::fprintf(stderr, "%s is not supported, only its CPU decoding is measured\n", compressed.name);
+                }
+
+                cases.push_back({resolution, rgba, YB::UploadMode::Direct, 0, false, true, &compressed});
+            }
+        }
+
+        // Multi window scaling
+        for (int window_count = 1; window_count <= max_window_count; window_count *= 2)
+        {
+            for (YB::UploadMode upload_mode : upload_modes)
+            {
+                cases.push_back({fhd, rgba, upload_mode, window_count, false, false, nullptr});
+            }
+        }
+
+        // Groups move the vsync wait between windows, so these run last
+        if (is_vsync_available)
+        {
+            for (YB::UploadMode upload_mode : upload_modes)
+            {
+                cases.push_back({fhd, rgba, upload_mode, 0, true, false, nullptr});
+                cases.push_back({fhd, rgba, upload_mode, max_window_count, true, false, nullptr});
+            }
+        }
+
+        return cases;
+    }
+
+    void print_usage()
+    {
+        std::fprintf(stderr,
+                     "usage: window_creator_bench [--duration seconds] [--output file] [--window] [--quick]\n"
+                     "  --duration  seconds each case runs, default 2\n"
+                     "  --output    JSON result file, default stdout\n"
+                     "  --window    draw into visible windows and add vsync cases,\n"
+                     "              default is offscreen without vsync\n"
+                     "  --quick     skip resolutions above 1080p\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    double duration = 2.0;
+    const char* output_path = nullptr;
+    bool is_visible = false;
+    bool is_quick = false;
+
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        if (0 == std::strcmp(argv[idx], "--duration") && idx + 1 < argc)
+        {
+            duration = std::atof(argv[++idx]);
+        }
+        else if (0 == std::strcmp(argv[idx], "--output") && idx + 1 < argc)
+        {
+            output_path = argv[++idx];
+        }
+        else if (0 == std::strcmp(argv[idx], "--window"))
+        {
+            is_visible = true;
+        }
+        else if (0 == std::strcmp(argv[idx], "--quick"))
+        {
+            is_quick = true;
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    const YB::SurfaceMode surface_mode = is_visible ? YB::SurfaceMode::Window : YB::SurfaceMode::Offscreen;
+
+    WindowPool pools[2];
+
+    for (int mode_idx = 0; mode_idx < 2; ++mode_idx)
+    {
+        const YB::UploadMode upload_mode = (0 == mode_idx)
+                                           ? YB::UploadMode::Direct
+                                           : YB::UploadMode::PixelBufferRing;
+
+        for (int idx = 0; idx < max_window_count; ++idx)
+        {
+            const std::string name = "window_creator_bench " + std::to_string(idx);
+            pools[mode_idx].windows.push_back(
+                std::make_unique<YB::WindowCreator>(name.c_str(),
+                                                    window_width,
+                                                    window_height,
+                                                    false,
+                                                    upload_mode,
+                                                    surface_mode));
+        }
+
+        if (is_visible)
+        {
+            pools[mode_idx].vsync_window
+                = std::make_unique<YB::WindowCreator>("window_creator_bench vsync",
+                                                      window_width,
+                                                      window_height,
+                                                      true,
+                                                      upload_mode,
+                                                      surface_mode);
+        }
+    }
+
+    // Format support is known once a context exists
+    const std::vector<Case> cases = make_cases(is_quick, is_visible, *pools[0].windows[0]);
+
+    FILE* output = output_path ? std::fopen(output_path, "w") : stdout;
+
+    if (!output)
+    {
+        std::fprintf(stderr, "Could not open %s\n", output_path);
+        return 1;
+    }
+
+    volatile bool exit_status = false;
+
+    std::fprintf(output,
+                 "{\n  \"duration_s\": %.3f,\n  \"surface\": \"%s\",\n  \"cases\": [\n",
+                 duration,
+                 is_visible ? "window" : "offscreen");
+
+    for (size_t idx = 0; idx < cases.size() && !exit_status; ++idx)
+    {
+        const Case& bench_case = cases[idx];
+        WindowPool& pool = pools[YB::UploadMode::Direct == bench_case.upload_mode ? 0 : 1];
+
+        const char* format_name = bench_case.compressed
+                                  ? bench_case.compressed->name
+                                  : bench_case.format.name;
+
+        // Compressed blocks are decoded by the texture unit while sampling
+        const char* conversion = bench_case.is_cpu_conversion
+                                 ? "cpu"
+                                 : (bench_case.compressed ? "texture_unit" : "shader");
+
+        std::fprintf(stderr,
+                     "[%zu/%zu] %s %s %s windows=%d vsync=%d cpu=%d\n",
+                     idx + 1,
+                     cases.size(),
+                     bench_case.resolution.name,
+                     format_name,
+                     YB::UploadMode::Direct == bench_case.upload_mode ? "direct" : "pbo",
+                     std::max(bench_case.window_count, 1),
+                     bench_case.is_vsync,
+                     bench_case.is_cpu_conversion);
+
+        const Result result = run_case(bench_case, pool, duration, exit_status);
+        const double seconds = result.seconds > 0.0 ? result.seconds : 1.0;
+
+        std::fprintf(output,
+                     "%s    {\"resolution\": \"%s\", \"width\": %d, \"height\": %d, "
+                     "\"format\": \"%s\", \"upload_mode\": \"%s\", \"windows\": %d, "
+                     "\"group\": %s, \"vsync\": %s, \"conversion\": \"%s\", "
+                     "\"frames\": %llu, \"fps\": %.2f, \"mb_per_s\": %.2f, "
+                     "\"p50_ms\": %.3f, \"p99_ms\": %.3f}",
+                     (idx > 0) ? ",\n" : "",
+                     bench_case.resolution.name,
+                     bench_case.resolution.width,
+                     bench_case.resolution.height,
+                     format_name,
+                     YB::UploadMode::Direct == bench_case.upload_mode ? "direct" : "pixel_buffer_ring",
+                     std::max(bench_case.window_count, 1),
+                     bench_case.window_count > 0 ? "true" : "false",
+                     bench_case.is_vsync ? "true" : "false",
+                     conversion,
+                     static_cast<unsigned long long>(result.frame_count),
+                     result.frame_count / seconds,
+                     result.uploaded_bytes / seconds / (1024.0 * 1024.0),
+                     result.p50_ms,
+                     result.p99_ms);
+        std::fflush(output);
+    }
+
+    std::fprintf(output, "\n  ]\n}\n");
+
+    if (output != stdout)
+    {
+        std::fclose(output);
+    }
+
+    return 0;
+}
+
+/* End Of File */
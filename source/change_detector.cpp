@@ -0,0 +1,227 @@
+///
+/// @file change_detector.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `ChangeDetector` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include "change_detector.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void ChangeDetector::detect(const uint8_t* data_ptr,
+                                const ImageLayout& layout,
+                                int frame_width,
+                                int frame_height,
+                                std::vector<Rect>& dirty_regions)
+    {
+        dirty_regions.clear();
+
+        // The copy holds the planes with tightly packed rows, so a view into
+        // a larger buffer only keeps the rows of its region.
+        size_t packed_size = 0;
+        size_t packed_offsets[ImageLayout::max_plane_count]{};
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            const PlaneLayout& plane = layout.planes[idx];
+
+            packed_offsets[idx] = packed_size;
+            packed_size += static_cast<size_t>(plane.width)
+                           * static_cast<size_t>(plane.bytes_per_texel)
+                           * static_cast<size_t>(plane.height);
+        }
+
+        if (this->m_previous_frame.size() != packed_size
+            || this->m_previous_width != frame_width
+            || this->m_previous_height != frame_height)
+        {
+            this->m_previous_frame.resize(packed_size);
+            std::copy(packed_offsets,
+                      packed_offsets + ImageLayout::max_plane_count,
+                      this->m_plane_offsets);
+            this->m_previous_width = frame_width;
+            this->m_previous_height = frame_height;
+
+            this->store_region(data_ptr,
+                               layout,
+                               {0, 0, frame_width, frame_height},
+                               frame_width,
+                               frame_height);
+
+            dirty_regions.push_back({0, 0, frame_width, frame_height});
+            return;
+        }
+
+        for (int y = 0; y < frame_height; y += m_tile_size)
+        {
+            const int tile_height = std::min(m_tile_size, frame_height - y);
+            int run_begin = -1;
+
+            for (int x = 0; x < frame_width + m_tile_size; x += m_tile_size)
+            {
+                bool is_dirty = false;
+
+                if (x < frame_width)
+                {
+                    const Rect tile{x, y, std::min(m_tile_size, frame_width - x), tile_height};
+
+                    is_dirty = !this->is_region_unchanged(data_ptr,
+                                                          layout,
+                                                          tile,
+                                                          frame_width,
+                                                          frame_height);
+                }
+
+                if (is_dirty && run_begin < 0)
+                {
+                    run_begin = x;
+                }
+                else if (!is_dirty && run_begin >= 0)
+                {
+                    const Rect run{run_begin, y, std::min(x, frame_width) - run_begin, tile_height};
+
+                    this->store_region(data_ptr, layout, run, frame_width, frame_height);
+                    dirty_regions.push_back(run);
+                    run_begin = -1;
+                }
+            }
+        }
+    }
+
+    void ChangeDetector::reset() noexcept
+    {
+        this->m_previous_frame.clear();
+        std::fill(this->m_plane_offsets, this->m_plane_offsets + ImageLayout::max_plane_count, 0);
+        this->m_previous_width = 0;
+        this->m_previous_height = 0;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool ChangeDetector::is_region_unchanged(const uint8_t* data_ptr,
+                                             const ImageLayout& layout,
+                                             const Rect& region,
+                                             int frame_width,
+                                             int frame_height) const noexcept
+    {
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            const PlaneLayout& plane = layout.planes[idx];
+            const Rect plane_region = get_plane_region(plane, region, frame_width, frame_height);
+
+            const size_t region_row_size = static_cast<size_t>(plane_region.width) * plane.bytes_per_texel;
+            const size_t packed_row_size = static_cast<size_t>(plane.width) * plane.bytes_per_texel;
+            const size_t column_offset = static_cast<size_t>(plane_region.x) * plane.bytes_per_texel;
+
+            for (int row = plane_region.y; row < plane_region.y + plane_region.height; ++row)
+            {
+                const size_t offset = plane.offset + row * plane.row_pitch + column_offset;
+                const size_t previous_offset = this->m_plane_offsets[idx]
+                                               + row * packed_row_size
+                                               + column_offset;
+
+                if (!are_bytes_equal(data_ptr + offset,
+                                     this->m_previous_frame.data() + previous_offset,
+                                     region_row_size))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void ChangeDetector::store_region(const uint8_t* data_ptr,
+                                      const ImageLayout& layout,
+                                      const Rect& region,
+                                      int frame_width,
+                                      int frame_height) noexcept
+    {
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            const PlaneLayout& plane = layout.planes[idx];
+            const Rect plane_region = get_plane_region(plane, region, frame_width, frame_height);
+
+            const size_t region_row_size = static_cast<size_t>(plane_region.width) * plane.bytes_per_texel;
+            const size_t packed_row_size = static_cast<size_t>(plane.width) * plane.bytes_per_texel;
+            const size_t column_offset = static_cast<size_t>(plane_region.x) * plane.bytes_per_texel;
+
+            for (int row = plane_region.y; row < plane_region.y + plane_region.height; ++row)
+            {
+                const size_t offset = plane.offset + row * plane.row_pitch + column_offset;
+                const size_t previous_offset = this->m_plane_offsets[idx]
+                                               + row * packed_row_size
+                                               + column_offset;
+
+                std::memcpy(this->m_previous_frame.data() + previous_offset,
+                            data_ptr + offset,
+                            region_row_size);
+            }
+        }
+    }
+
+    bool ChangeDetector::are_bytes_equal(const uint8_t* lhs,
+                                         const uint8_t* rhs,
+                                         size_t size) noexcept
+    {
+        size_t idx = 0;
+
+#if defined(__AVX2__)
+        for (; idx + 32 <= size; idx += 32)
+        {
+            const __m256i lhs_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + idx));
+            const __m256i rhs_bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + idx));
+
+            if (-1 != _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_bytes, rhs_bytes)))
+            {
+                return false;
+            }
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        for (; idx + 16 <= size; idx += 16)
+        {
+            const __m128i lhs_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + idx));
+            const __m128i rhs_bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + idx));
+
+            if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi8(lhs_bytes, rhs_bytes)))
+            {
+                return false;
+            }
+        }
+#endif
+
+        return 0 == std::memcmp(lhs + idx, rhs + idx, size - idx);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
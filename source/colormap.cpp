@@ -0,0 +1,121 @@
+///
+/// @file colormap.cpp
+/// @author Yasin BASAR
+/// @brief Implements the built-in pseudo-color maps.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include "colormap.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @brief 6th degree polynomial fits of matplotlib's perceptually uniform
+    ///        colormaps, coefficients from the lowest degree up, per channel.
+    static const float viridis_coefficients[7][3] =
+    {
+        {0.2777273272234177f, 0.005407344544966578f, 0.3340998053353061f},
+        {0.1050930431085774f, 1.404613529898575f, 1.384590162594685f},
+        {-0.3308618287255563f, 0.214847559468213f, 0.09509516302823659f},
+        {-4.634230498983486f, -5.799100973351585f, -19.33244095627987f},
+        {6.228269936347081f, 14.17993336680509f, 56.69055260068105f},
+        {4.776384997670288f, -13.74514537774601f, -65.35303263337234f},
+        {-5.435455855934631f, 4.645852612178535f, 26.3124352495832f}
+    };
+
+    static const float inferno_coefficients[7][3] =
+    {
+        {0.0002189403691192265f, 0.001651004631001012f, -0.01948089843709184f},
+        {0.1065134194856116f, 0.5639564367884091f, 3.932712388889277f},
+        {11.60249308247187f, -3.972853965665698f, -15.9423941062914f},
+        {-41.70399613139459f, 17.43639888205313f, 44.35414519872813f},
+        {77.162935699427f, -33.40235894210092f, -81.80730925738993f},
+        {-71.31942824499214f, 32.62606426397723f, 73.20951985803202f},
+        {25.13112622477341f, -12.24266895238567f, -23.07032500287172f}
+    };
+
+    /// @brief Converts a [0, 1] channel value to 8 bit.
+    static uint8_t to_byte(float value) noexcept
+    {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    /// @brief Evaluates a polynomial colormap fit.
+    static void evaluate_polynomial(const float (&coefficients)[7][3],
+                                    float t,
+                                    uint8_t* rgba) noexcept
+    {
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            float value = 0.0f;
+
+            for (int degree = 6; degree >= 0; --degree)
+            {
+                value = value * t + coefficients[degree][channel];
+            }
+
+            rgba[channel] = to_byte(value);
+        }
+
+        rgba[3] = 255;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    std::vector<uint8_t> make_colormap(Colormap colormap)
+    {
+        std::vector<uint8_t> entries(4 * colormap_entry_count);
+
+        for (int idx = 0; idx < colormap_entry_count; ++idx)
+        {
+            const float t = static_cast<float>(idx) / (colormap_entry_count - 1);
+            uint8_t* rgba = &entries[4 * idx];
+
+            switch (colormap)
+            {
+                case Colormap::Jet:
+                    rgba[0] = to_byte(1.5f - std::abs(4.0f * t - 3.0f));
+                    rgba[1] = to_byte(1.5f - std::abs(4.0f * t - 2.0f));
+                    rgba[2] = to_byte(1.5f - std::abs(4.0f * t - 1.0f));
+                    rgba[3] = 255;
+                break;
+                case Colormap::Viridis:
+                    evaluate_polynomial(viridis_coefficients, t, rgba);
+                break;
+                case Colormap::Inferno:
+                    evaluate_polynomial(inferno_coefficients, t, rgba);
+                break;
+                default:
+                    rgba[0] = rgba[1] = rgba[2] = static_cast<uint8_t>(idx);
+                    rgba[3] = 255;
+                break;
+            }
+        }
+
+        return entries;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
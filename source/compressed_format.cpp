@@ -0,0 +1,900 @@
+///
+/// @file compressed_format.cpp
+/// @author Yasin BASAR
+/// @brief Implements texture layouts and CPU decoders of compressed formats.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include "compressed_format.hpp"
+#include "gl_extensions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @brief Decoded pixels of one 4x4 block, RGBA in row major order.
+    using BlockPixels = uint8_t[16][4];
+
+    /// @struct Bc7Mode
+    /// @brief Bit allocation of one of the eight BC7 block modes.
+    struct Bc7Mode
+    {
+        int subset_count; ///< Endpoint pairs of the block.
+        int partition_bits; ///< Bits selecting the subset layout.
+        int rotation_bits; ///< Bits selecting the channel swapped with alpha.
+        int index_selection_bits; ///< Bits selecting which index set colors use.
+        int color_bits; ///< Bits of an endpoint color channel.
+        int alpha_bits; ///< Bits of an endpoint alpha, 0 for opaque blocks.
+        bool has_endpoint_pbits; ///< Every endpoint has its own low bit.
+        bool has_shared_pbits; ///< Both endpoints of a subset share a low bit.
+        int index_bits; ///< Bits of a primary index.
+        int index2_bits; ///< Bits of a secondary index, 0 without a second set.
+    };
+
+    static constexpr Bc7Mode bc7_modes[8] =
+    {
+        {3, 4, 0, 0, 4, 0, true, false, 3, 0},
+        {2, 6, 0, 0, 6, 0, false, true, 3, 0},
+        {3, 6, 0, 0, 5, 0, false, false, 2, 0},
+        {2, 6, 0, 0, 7, 0, true, false, 2, 0},
+        {1, 0, 2, 1, 5, 6, false, false, 2, 3},
+        {1, 0, 2, 0, 7, 8, false, false, 2, 2},
+        {1, 0, 0, 0, 7, 7, true, false, 4, 0},
+        {2, 6, 0, 0, 5, 5, true, false, 2, 0}
+    };
+
+    /// @brief Pixels of subset 1 in the 2 subset layouts, one bit per pixel.
+    static constexpr uint16_t bc7_partitions2[64] =
+    {
+        0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+        0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+        0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+        0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+        0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+        0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+        0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+        0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22
+    };
+
+    /// @brief Subset of every pixel in the 3 subset layouts.
+    static constexpr uint8_t bc7_partitions3[64][16] =
+    {
+        {0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2},
+        {0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1},
+        {0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+        {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1},
+        {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2},
+        {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2},
+        {0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1},
+        {0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1},
+        {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2},
+        {0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2},
+        {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+        {0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2},
+        {0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2},
+        {0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2},
+        {0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+        {0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0},
+        {0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2},
+        {0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0},
+        {0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2},
+        {0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1},
+        {0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2},
+        {0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1},
+        {0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2},
+        {0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0},
+        {0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0},
+        {0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2},
+        {0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0},
+        {0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1},
+        {0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2},
+        {0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2},
+        {0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1},
+        {0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1},
+        {0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2},
+        {0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1},
+        {0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2},
+        {0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0},
+        {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0},
+        {0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0},
+        {0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0},
+        {0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1},
+        {0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1},
+        {0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2},
+        {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1},
+        {0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2},
+        {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1},
+        {0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1},
+        {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1},
+        {0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1},
+        {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2},
+        {0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1},
+        {0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2},
+        {0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},
+        {0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2},
+        {0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2},
+        {0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2},
+        {0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2},
+        {0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2},
+        {0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2},
+        {0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2},
+        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2},
+        {0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1},
+        {0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2},
+        {0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},
+        {0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0}
+    };
+
+    /// @brief Anchor pixel of subset 1 in the 2 subset layouts.
+    static constexpr uint8_t bc7_anchors2[64] =
+    {
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+        15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+         6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+    };
+
+    /// @brief Anchor pixel of subset 1 in the 3 subset layouts.
+    static constexpr uint8_t bc7_anchors3a[64] =
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+    };
+
+    /// @brief Anchor pixel of subset 2 in the 3 subset layouts.
+    static constexpr uint8_t bc7_anchors3b[64] =
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+    };
+
+    static constexpr uint8_t bc7_weights2[4] = {0, 21, 43, 64};
+    static constexpr uint8_t bc7_weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+    static constexpr uint8_t bc7_weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    /// @brief Intensity modifiers of the ETC1 and ETC2 subblock tables.
+    static constexpr int etc_modifiers[8][2] =
+    {
+        {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    };
+
+    /// @brief Distances of the ETC2 T and H modes.
+    static constexpr int etc2_distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+    /// @brief Alpha modifiers of the EAC tables.
+    static constexpr int eac_modifiers[16][8] =
+    {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+
+    /// @brief Clamps a decoded channel to 8 bits.
+    /// @param value[in] Channel value
+    /// @return Clamped value
+    static inline uint8_t clamp_channel(int value) noexcept
+    {
+        return static_cast<uint8_t>(std::min(std::max(value, 0), 255));
+    }
+
+    /// @brief Expands a channel to 8 bits by repeating its high bits.
+    /// @param value[in] Channel value
+    /// @param bit_count[in] Bits of the value, 4 to 8
+    /// @return 8 bit channel value
+    static inline int expand_channel(int value, int bit_count) noexcept
+    {
+        value <<= 8 - bit_count;
+        return value | (value >> bit_count);
+    }
+
+    /// @brief Decodes the RGB565 endpoints and the 2 bit indices of a BC1
+    ///        block, also the color half of a BC3 block.
+    /// @param block_ptr[in] 8 byte color block
+    /// @param has_alpha_mode[in] Endpoints in ascending order select 3
+    ///        colors and transparent black, BC3 always uses 4 colors
+    /// @param pixels[out] Decoded block
+    static void decode_bc1_block(const uint8_t* block_ptr,
+                                 bool has_alpha_mode,
+                                 BlockPixels& pixels) noexcept
+    {
+        const int color0 = block_ptr[0] | (block_ptr[1] << 8);
+        const int color1 = block_ptr[2] | (block_ptr[3] << 8);
+
+        uint8_t palette[4][4];
+
+        for (int idx = 0; idx < 2; ++idx)
+        {
+            const int color = (0 == idx) ? color0 : color1;
+            palette[idx][0] = static_cast<uint8_t>(expand_channel(color >> 11, 5));
+            palette[idx][1] = static_cast<uint8_t>(expand_channel((color >> 5) & 0x3F, 6));
+            palette[idx][2] = static_cast<uint8_t>(expand_channel(color & 0x1F, 5));
+            palette[idx][3] = 255;
+        }
+
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            if (color0 > color1 || !has_alpha_mode)
+            {
+                palette[2][channel] = static_cast<uint8_t>((2 * palette[0][channel] + palette[1][channel]) / 3);
+                palette[3][channel] = static_cast<uint8_t>((palette[0][channel] + 2 * palette[1][channel]) / 3);
+            }
+            else
+            {
+                palette[2][channel] = static_cast<uint8_t>((palette[0][channel] + palette[1][channel]) / 2);
+                palette[3][channel] = 0;
+            }
+        }
+
+        palette[2][3] = 255;
+        palette[3][3] = (color0 > color1 || !has_alpha_mode) ? 255 : 0;
+
+        const uint32_t indices = static_cast<uint32_t>(block_ptr[4])
+                                 | (static_cast<uint32_t>(block_ptr[5]) << 8)
+                                 | (static_cast<uint32_t>(block_ptr[6]) << 16)
+                                 | (static_cast<uint32_t>(block_ptr[7]) << 24);
+
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            std::memcpy(pixels[pixel], palette[(indices >> (2 * pixel)) & 3], 4);
+        }
+    }
+
+    /// @brief Decodes the alpha half of a BC3 block, two endpoints and 3 bit
+    ///        indices into 8 interpolated or 6 interpolated and 2 fixed values.
+    /// @param block_ptr[in] 8 byte alpha block
+    /// @param pixels[out] Decoded block, only alpha is written
+    static void decode_bc3_alpha_block(const uint8_t* block_ptr, BlockPixels& pixels) noexcept
+    {
+        const int alpha0 = block_ptr[0];
+        const int alpha1 = block_ptr[1];
+
+        int palette[8] = {alpha0, alpha1, 0, 0, 0, 0, 0, 255};
+
+        if (alpha0 > alpha1)
+        {
+            for (int idx = 1; idx < 7; ++idx)
+            {
+                palette[idx + 1] = ((7 - idx) * alpha0 + idx * alpha1) / 7;
+            }
+        }
+        else
+        {
+            for (int idx = 1; idx < 5; ++idx)
+            {
+                palette[idx + 1] = ((5 - idx) * alpha0 + idx * alpha1) / 5;
+            }
+        }
+
+        uint64_t indices = 0;
+
+        for (int idx = 7; idx >= 2; --idx)
+        {
+            indices = (indices << 8) | block_ptr[idx];
+        }
+
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            pixels[pixel][3] = static_cast<uint8_t>(palette[(indices >> (3 * pixel)) & 7]);
+        }
+    }
+
+    /// @class Bc7BitReader
+    /// @brief Reads the fields of a 128 bit BC7 block from the least
+    ///        significant bit on.
+    class Bc7BitReader final
+    {
+    public:
+        explicit Bc7BitReader(const uint8_t* block_ptr) noexcept :
+            m_low{0},
+            m_high{0},
+            m_position{0}
+        {
+            for (int idx = 7; idx >= 0; --idx)
+            {
+                this->m_low = (this->m_low << 8) | block_ptr[idx];
+                this->m_high = (this->m_high << 8) | block_ptr[idx + 8];
+            }
+        }
+
+        uint32_t read(int bit_count) noexcept
+        {
+            if (0 == bit_count)
+            {
+                return 0;
+            }
+
+            uint64_t value;
+
+            if (this->m_position >= 64)
+            {
+                value = this->m_high >> (this->m_position - 64);
+            }
+            else if (this->m_position + bit_count <= 64)
+            {
+                value = this->m_low >> this->m_position;
+            }
+            else
+            {
+                value = (this->m_low >> this->m_position) | (this->m_high << (64 - this->m_position));
+            }
+
+            this->m_position += bit_count;
+
+            return static_cast<uint32_t>(value & ((uint64_t{1} << bit_count) - 1));
+        }
+
+    private:
+        uint64_t m_low; ///< Bits 0 to 63.
+        uint64_t m_high; ///< Bits 64 to 127.
+        int m_position; ///< Next bit to read.
+    };
+
+    /// @brief Returns the interpolation weights of an index bit count.
+    /// @param index_bits[in] 2, 3 or 4
+    /// @return Weight table
+    static const uint8_t* get_bc7_weights(int index_bits) noexcept
+    {
+        switch (index_bits)
+        {
+            case 2:
+                return bc7_weights2;
+            case 3:
+                return bc7_weights3;
+            default:
+                return bc7_weights4;
+        }
+    }
+
+    /// @brief Decodes a BC7 block. Reserved mode blocks decode to
+    ///        transparent black as the format requires.
+    /// @param block_ptr[in] 16 byte block
+    /// @param pixels[out] Decoded block
+    static void decode_bc7_block(const uint8_t* block_ptr, BlockPixels& pixels) noexcept
+    {
+        int mode = 0;
+
+        while (mode < 8 && 0 == (block_ptr[0] & (1 << mode)))
+        {
+            ++mode;
+        }
+
+        if (8 == mode)
+        {
+            std::memset(pixels, 0, sizeof(BlockPixels));
+            return;
+        }
+
+        const Bc7Mode& info = bc7_modes[mode];
+        Bc7BitReader reader(block_ptr);
+        reader.read(mode + 1);
+
+        const uint32_t partition = reader.read(info.partition_bits);
+        const uint32_t rotation = reader.read(info.rotation_bits);
+        const uint32_t index_selection = reader.read(info.index_selection_bits);
+
+        const int endpoint_count = 2 * info.subset_count;
+        int endpoints[6][4];
+
+        // Channels are stored one after another for every endpoint
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            for (int endpoint = 0; endpoint < endpoint_count; ++endpoint)
+            {
+                endpoints[endpoint][channel] = static_cast<int>(reader.read(info.color_bits));
+            }
+        }
+
+        for (int endpoint = 0; endpoint < endpoint_count; ++endpoint)
+        {
+            endpoints[endpoint][3] = static_cast<int>(reader.read(info.alpha_bits));
+        }
+
+        int pbits[6] = {};
+
+        if (info.has_endpoint_pbits)
+        {
+            for (int endpoint = 0; endpoint < endpoint_count; ++endpoint)
+            {
+                pbits[endpoint] = static_cast<int>(reader.read(1));
+            }
+        }
+        else if (info.has_shared_pbits)
+        {
+            for (int subset = 0; subset < info.subset_count; ++subset)
+            {
+                pbits[2 * subset] = pbits[2 * subset + 1] = static_cast<int>(reader.read(1));
+            }
+        }
+
+        const bool has_pbits = info.has_endpoint_pbits || info.has_shared_pbits;
+
+        for (int endpoint = 0; endpoint < endpoint_count; ++endpoint)
+        {
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                int bit_count = (channel < 3) ? info.color_bits : info.alpha_bits;
+
+                if (0 == bit_count)
+                {
+                    endpoints[endpoint][channel] = 255;
+                    continue;
+                }
+
+                int value = endpoints[endpoint][channel];
+
+                if (has_pbits)
+                {
+                    value = (value << 1) | pbits[endpoint];
+                    ++bit_count;
+                }
+
+                endpoints[endpoint][channel] = expand_channel(value, bit_count);
+            }
+        }
+
+        uint8_t subsets[16] = {};
+        bool is_anchor[16] = {true};
+
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            if (2 == info.subset_count)
+            {
+                subsets[pixel] = static_cast<uint8_t>((bc7_partitions2[partition] >> pixel) & 1);
+            }
+            else if (3 == info.subset_count)
+            {
+                subsets[pixel] = bc7_partitions3[partition][pixel];
+            }
+        }
+
+        if (2 == info.subset_count)
+        {
+            is_anchor[bc7_anchors2[partition]] = true;
+        }
+        else if (3 == info.subset_count)
+        {
+            is_anchor[bc7_anchors3a[partition]] = true;
+            is_anchor[bc7_anchors3b[partition]] = true;
+        }
+
+        // Anchor indices drop their high bit, the encoder keeps it zero
+        uint8_t indices[16];
+        uint8_t indices2[16] = {};
+
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            indices[pixel] = static_cast<uint8_t>(reader.read(info.index_bits - (is_anchor[pixel] ? 1 : 0)));
+        }
+
+        if (info.index2_bits > 0)
+        {
+            for (int pixel = 0; pixel < 16; ++pixel)
+            {
+                indices2[pixel] = static_cast<uint8_t>(reader.read(info.index2_bits - ((0 == pixel) ? 1 : 0)));
+            }
+        }
+
+        const uint8_t* color_weights = get_bc7_weights(info.index_bits);
+        const uint8_t* alpha_weights = color_weights;
+        const uint8_t* color_indices = indices;
+        const uint8_t* alpha_indices = indices;
+
+        if (info.index2_bits > 0)
+        {
+            alpha_weights = get_bc7_weights(info.index2_bits);
+            alpha_indices = indices2;
+
+            if (1 == index_selection)
+            {
+                std::swap(color_weights, alpha_weights);
+                std::swap(color_indices, alpha_indices);
+            }
+        }
+
+        for (int pixel = 0; pixel < 16; ++pixel)
+        {
+            const int* endpoint0 = endpoints[2 * subsets[pixel]];
+            const int* endpoint1 = endpoints[2 * subsets[pixel] + 1];
+
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                const int weight = (channel < 3)
+                                   ? color_weights[color_indices[pixel]]
+                                   : alpha_weights[alpha_indices[pixel]];
+
+                pixels[pixel][channel] = static_cast<uint8_t>(((64 - weight) * endpoint0[channel]
+                                                               + weight * endpoint1[channel]
+                                                               + 32) >> 6);
+            }
+
+            if (rotation > 0)
+            {
+                std::swap(pixels[pixel][3], pixels[pixel][rotation - 1]);
+            }
+        }
+    }
+
+    /// @brief Decodes an ETC2 RGB block in the individual, differential, T,
+    ///        H or planar mode. Alpha is set to opaque.
+    /// @param block_ptr[in] 8 byte block
+    /// @param pixels[out] Decoded block
+    static void decode_etc2_block(const uint8_t* block_ptr, BlockPixels& pixels) noexcept
+    {
+        const uint8_t* bytes = block_ptr;
+
+        // Pixels are numbered in column major order, index bit 1 of every
+        // pixel is in the high half.
+        const uint32_t index_bits = (static_cast<uint32_t>(bytes[4]) << 24)
+                                    | (static_cast<uint32_t>(bytes[5]) << 16)
+                                    | (static_cast<uint32_t>(bytes[6]) << 8)
+                                    | static_cast<uint32_t>(bytes[7]);
+
+        const auto get_index = [index_bits](int x, int y) noexcept
+        {
+            const int bit = x * 4 + y;
+            return static_cast<int>((((index_bits >> (16 + bit)) & 1) << 1) | ((index_bits >> bit) & 1));
+        };
+
+        const auto set_pixel = [&pixels](int x, int y, int red, int green, int blue) noexcept
+        {
+            uint8_t* pixel = pixels[y * 4 + x];
+            pixel[0] = clamp_channel(red);
+            pixel[1] = clamp_channel(green);
+            pixel[2] = clamp_channel(blue);
+            pixel[3] = 255;
+        };
+
+        const bool is_differential = 0 != (bytes[3] & 2);
+
+        int base_colors[2][3];
+
+        if (is_differential)
+        {
+            int deltas[3];
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                base_colors[0][channel] = bytes[channel] >> 3;
+                deltas[channel] = ((bytes[channel] & 7) ^ 4) - 4;
+            }
+
+            const int red = base_colors[0][0] + deltas[0];
+            const int green = base_colors[0][1] + deltas[1];
+            const int blue = base_colors[0][2] + deltas[2];
+
+            if (red < 0 || red > 31)
+            {
+                // T mode, one color and a pair spread by a distance
+                const int colors[2][3] =
+                {
+                    {expand_channel((((bytes[0] >> 3) & 3) << 2) | (bytes[0] & 3), 4),
+                     expand_channel(bytes[1] >> 4, 4),
+                     expand_channel(bytes[1] & 15, 4)},
+                    {expand_channel(bytes[2] >> 4, 4),
+                     expand_channel(bytes[2] & 15, 4),
+                     expand_channel(bytes[3] >> 4, 4)}
+                };
+
+                const int distance = etc2_distances[(((bytes[3] >> 2) & 3) << 1) | (bytes[3] & 1)];
+                const int offsets[4] = {0, distance, 0, -distance};
+
+                for (int x = 0; x < 4; ++x)
+                {
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        const int index = get_index(x, y);
+                        const int* color = colors[(0 == index) ? 0 : 1];
+                        set_pixel(x, y, color[0] + offsets[index], color[1] + offsets[index], color[2] + offsets[index]);
+                    }
+                }
+
+                return;
+            }
+
+            if (green < 0 || green > 31)
+            {
+                // H mode, two pairs spread by a distance
+                const int colors4[2][3] =
+                {
+                    {(bytes[0] >> 3) & 15,
+                     ((bytes[0] & 7) << 1) | ((bytes[1] >> 4) & 1),
+                     (((bytes[1] >> 3) & 1) << 3) | ((bytes[1] & 3) << 1) | (bytes[2] >> 7)},
+                    {(bytes[2] >> 3) & 15,
+                     ((bytes[2] & 7) << 1) | (bytes[3] >> 7),
+                     (bytes[3] >> 3) & 15}
+                };
+
+                const int value0 = (colors4[0][0] << 8) | (colors4[0][1] << 4) | colors4[0][2];
+                const int value1 = (colors4[1][0] << 8) | (colors4[1][1] << 4) | colors4[1][2];
+
+                // The order of the colors stores the lowest distance bit
+                const int distance = etc2_distances[(bytes[3] & 4)
+                                                    | ((bytes[3] & 1) << 1)
+                                                    | ((value0 >= value1) ? 1 : 0)];
+
+                for (int x = 0; x < 4; ++x)
+                {
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        const int index = get_index(x, y);
+                        const int* color = colors4[index >> 1];
+                        const int offset = (0 == (index & 1)) ? distance : -distance;
+                        set_pixel(x,
+                                  y,
+                                  expand_channel(color[0], 4) + offset,
+                                  expand_channel(color[1], 4) + offset,
+                                  expand_channel(color[2], 4) + offset);
+                    }
+                }
+
+                return;
+            }
+
+            if (blue < 0 || blue > 31)
+            {
+                // Planar mode, a gradient through three corner colors
+                const int origin[3] =
+                {
+                    expand_channel((bytes[0] >> 1) & 63, 6),
+                    expand_channel(((bytes[0] & 1) << 6) | ((bytes[1] >> 1) & 63), 7),
+                    expand_channel(((bytes[1] & 1) << 5) | (((bytes[2] >> 3) & 3) << 3) | ((bytes[2] & 3) << 1) | (bytes[3] >> 7), 6)
+                };
+
+                const int horizontal[3] =
+                {
+                    expand_channel((((bytes[3] >> 2) & 31) << 1) | (bytes[3] & 1), 6),
+                    expand_channel(bytes[4] >> 1, 7),
+                    expand_channel(((bytes[4] & 1) << 5) | (bytes[5] >> 3), 6)
+                };
+
+                const int vertical[3] =
+                {
+                    expand_channel(((bytes[5] & 7) << 3) | (bytes[6] >> 5), 6),
+                    expand_channel(((bytes[6] & 31) << 2) | (bytes[7] >> 6), 7),
+                    expand_channel(bytes[7] & 63, 6)
+                };
+
+                int values[3];
+
+                for (int x = 0; x < 4; ++x)
+                {
+                    for (int y = 0; y < 4; ++y)
+                    {
+                        for (int channel = 0; channel < 3; ++channel)
+                        {
+                            values[channel] = (x * (horizontal[channel] - origin[channel])
+                                               + y * (vertical[channel] - origin[channel])
+                                               + 4 * origin[channel]
+                                               + 2) >> 2;
+                        }
+
+                        set_pixel(x, y, values[0], values[1], values[2]);
+                    }
+                }
+
+                return;
+            }
+
+            base_colors[1][0] = red;
+            base_colors[1][1] = green;
+            base_colors[1][2] = blue;
+
+            for (int subblock = 0; subblock < 2; ++subblock)
+            {
+                for (int channel = 0; channel < 3; ++channel)
+                {
+                    base_colors[subblock][channel] = expand_channel(base_colors[subblock][channel], 5);
+                }
+            }
+        }
+        else
+        {
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                base_colors[0][channel] = expand_channel(bytes[channel] >> 4, 4);
+                base_colors[1][channel] = expand_channel(bytes[channel] & 15, 4);
+            }
+        }
+
+        const int tables[2] = {bytes[3] >> 5, (bytes[3] >> 2) & 7};
+        const bool is_flipped = 0 != (bytes[3] & 1);
+
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                // Subblocks are 2x4 side by side, or 4x2 on top of each other when flipped
+                const int subblock = is_flipped ? (y >> 1) : (x >> 1);
+                const int index = get_index(x, y);
+                const int magnitude = etc_modifiers[tables[subblock]][index & 1];
+                const int modifier = (0 == (index & 2)) ? magnitude : -magnitude;
+                const int* color = base_colors[subblock];
+
+                set_pixel(x, y, color[0] + modifier, color[1] + modifier, color[2] + modifier);
+            }
+        }
+    }
+
+    /// @brief Decodes the EAC alpha half of an ETC2 RGBA block.
+    /// @param block_ptr[in] 8 byte alpha block
+    /// @param pixels[out] Decoded block, only alpha is written
+    static void decode_eac_alpha_block(const uint8_t* block_ptr, BlockPixels& pixels) noexcept
+    {
+        const int base = block_ptr[0];
+        const int multiplier = block_ptr[1] >> 4;
+        const int* modifiers = eac_modifiers[block_ptr[1] & 15];
+
+        uint64_t indices = 0;
+
+        for (int idx = 2; idx < 8; ++idx)
+        {
+            indices = (indices << 8) | block_ptr[idx];
+        }
+
+        // 3 bit indices from the most significant bit on, column major
+        for (int x = 0; x < 4; ++x)
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                const int index = static_cast<int>((indices >> (45 - 3 * (x * 4 + y))) & 7);
+                pixels[y * 4 + x][3] = clamp_channel(base + modifiers[index] * multiplier);
+            }
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    CompressedLayout get_compressed_layout(CompressedFormat format,
+                                           int frame_width,
+                                           int frame_height) noexcept
+    {
+        CompressedLayout layout{};
+        layout.block_size = 16;
+
+        switch (format)
+        {
+            case CompressedFormat::BC1:
+                layout.internal_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                layout.block_size = 8;
+            break;
+            case CompressedFormat::BC3:
+                layout.internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            break;
+            case CompressedFormat::BC7:
+                layout.internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM;
+            break;
+            case CompressedFormat::ETC2RGB:
+                layout.internal_format = GL_COMPRESSED_RGB8_ETC2;
+                layout.block_size = 8;
+            break;
+            case CompressedFormat::ETC2RGBA:
+                layout.internal_format = GL_COMPRESSED_RGBA8_ETC2_EAC;
+            break;
+            default:
+            break;
+        }
+
+        layout.block_columns = (std::max(frame_width, 0) + 3) / 4;
+        layout.block_rows = (std::max(frame_height, 0) + 3) / 4;
+        layout.image_size = static_cast<size_t>(layout.block_columns)
+                            * static_cast<size_t>(layout.block_rows)
+                            * static_cast<size_t>(layout.block_size);
+
+        return layout;
+    }
+
+    bool is_compressed_format_supported(CompressedFormat format) noexcept
+    {
+        switch (format)
+        {
+            case CompressedFormat::BC1:
+            case CompressedFormat::BC3:
+                return GLExtensions::has_s3tc;
+            case CompressedFormat::BC7:
+                return GLExtensions::has_bptc;
+            case CompressedFormat::ETC2RGB:
+            case CompressedFormat::ETC2RGBA:
+                return GLExtensions::has_etc2;
+            default:
+                return false;
+        }
+    }
+
+    void decompress_image(const uint8_t* data_ptr,
+                          CompressedFormat format,
+                          int frame_width,
+                          int frame_height,
+                          uint8_t* rgba_ptr) noexcept
+    {
+        const CompressedLayout layout = get_compressed_layout(format, frame_width, frame_height);
+        const size_t rgba_pitch = static_cast<size_t>(frame_width) * 4;
+
+        BlockPixels pixels;
+
+        for (int block_y = 0; block_y < layout.block_rows; ++block_y)
+        {
+            for (int block_x = 0; block_x < layout.block_columns; ++block_x)
+            {
+                const uint8_t* block_ptr = data_ptr
+                                           + (static_cast<size_t>(block_y) * layout.block_columns + block_x)
+                                           * layout.block_size;
+
+                switch (format)
+                {
+                    case CompressedFormat::BC1:
+                        decode_bc1_block(block_ptr, true, pixels);
+                    break;
+                    case CompressedFormat::BC3:
+                        decode_bc1_block(block_ptr + 8, false, pixels);
+                        decode_bc3_alpha_block(block_ptr, pixels);
+                    break;
+                    case CompressedFormat::BC7:
+                        decode_bc7_block(block_ptr, pixels);
+                    break;
+                    case CompressedFormat::ETC2RGB:
+                        decode_etc2_block(block_ptr, pixels);
+                    break;
+                    case CompressedFormat::ETC2RGBA:
+                        decode_etc2_block(block_ptr + 8, pixels);
+                        decode_eac_alpha_block(block_ptr, pixels);
+                    break;
+                    default:
+                        std::memset(pixels, 0, sizeof(BlockPixels));
+                    break;
+                }
+
+                // Edge blocks are cut at the image border
+                const int column_count = std::min(4, frame_width - block_x * 4);
+                const int row_count = std::min(4, frame_height - block_y * 4);
+
+                for (int row = 0; row < row_count; ++row)
+                {
+                    std::memcpy(rgba_ptr + (static_cast<size_t>(block_y) * 4 + row) * rgba_pitch
+                                         + static_cast<size_t>(block_x) * 16,
+                                pixels[row * 4],
+                                static_cast<size_t>(column_count) * 4);
+                }
+            }
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
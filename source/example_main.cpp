@@ -7,23 +7,45 @@
 /// @copyright Copyright (c) 2024
 /// 
 
+#include <chrono>
+#include <cstring>
+#include <iostream>
 #include <window_creator.hpp>
+#include <window_group.hpp>
+#include <window_manager.hpp>
 
-int main()
+int main(int argc, char** argv)
 {
     int window_width=200;
     int window_height=200;
 
+    // Run with "pbo" argument to upload frames through the pixel buffer ring
+    // Run with "group" argument to present all windows with one vsync wait
+    YB::UploadMode upload_mode = YB::UploadMode::Direct;
+    bool use_window_group = false;
+
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        if (0 == std::strcmp(argv[idx], "pbo"))
+        {
+            upload_mode = YB::UploadMode::PixelBufferRing;
+        }
+        else if (0 == std::strcmp(argv[idx], "group"))
+        {
+            use_window_group = true;
+        }
+    }
+
     std::unique_ptr<YB::WindowCreator> window1{
-        new YB::WindowCreator("test window 1", 2 * window_width, 2 * window_height, true)
+        new YB::WindowCreator("test window 1", 2 * window_width, 2 * window_height, true, upload_mode)
     };
 
     std::unique_ptr<YB::WindowCreator> window2{
-        new YB::WindowCreator("test window 2", 3 * window_width, 3 * window_height, true)
+        new YB::WindowCreator("test window 2", 3 * window_width, 3 * window_height, true, upload_mode)
     };
 
     std::unique_ptr<YB::WindowCreator> window3{
-        new YB::WindowCreator("test window 3", 4 * window_width, 4 * window_height, true)
+        new YB::WindowCreator("test window 3", 4 * window_width, 4 * window_height, true, upload_mode)
     };
 
     int frame_width = 1600;
@@ -58,14 +80,82 @@ int main()
         blue_image[idx+3] = 255;
     }
 
+    std::unique_ptr<YB::WindowGroup> window_group;
+
+    if (use_window_group)
+    {
+        window_group = std::make_unique<YB::WindowGroup>(true);
+        window_group->add_window(*window1);
+        window_group->add_window(*window2);
+        window_group->add_window(*window3);
+    }
+
+    // Events of all windows are pumped once per loop instead of in every image_show
+    YB::WindowManager window_manager;
+
     volatile bool exit_status = false;
 
+    using clock = std::chrono::steady_clock;
+    std::chrono::duration<double, std::micro> time_in_image_show{0};
+    int frame_count = 0;
+
     // Press ESC to close the window
     while (!exit_status)
     {
-        window1->image_show(red_image, frame_width, frame_height, exit_status);
-        window2->image_show(green_image, frame_width, frame_height, exit_status);
-        window3->image_show(blue_image, frame_width, frame_height, exit_status);
+        window_manager.poll_events();
+
+        YB::WindowEvent event{};
+        while (window1->pop_event(event))
+        {
+            if (YB::WindowEventType::Resize == event.type)
+            {
+                std::cout << "window 1 resized to " << event.width << "x" << event.height << "\n";
+            }
+        }
+
+        auto begin = clock::now();
+        if (window_group)
+        {
+            window_group->set_frame(*window1, red_image, frame_width, frame_height);
+            window_group->set_frame(*window2, green_image, frame_width, frame_height);
+            window_group->set_frame(*window3, blue_image, frame_width, frame_height);
+            window_group->present(exit_status);
+        }
+        else
+        {
+            window1->image_show(red_image, frame_width, frame_height, exit_status);
+            window2->image_show(green_image, frame_width, frame_height, exit_status);
+            window3->image_show(blue_image, frame_width, frame_height, exit_status);
+        }
+        time_in_image_show += clock::now() - begin;
+
+        // Report how long the caller's thread was blocked per image_show call
+        if (++frame_count == 300)
+        {
+            std::cout << "average image_show time: "
+                      << time_in_image_show.count() / (3 * frame_count)
+                      << " us\n";
+
+            if (window_group)
+            {
+                std::cout << "window fps: "
+                          << window_group->get_window_frame_rate(*window1) << " "
+                          << window_group->get_window_frame_rate(*window2) << " "
+                          << window_group->get_window_frame_rate(*window3) << "\n";
+            }
+
+            const YB::FrameStatistics statistics = window1->get_stats();
+            std::cout << "window 1 upload p50/p99: "
+                      << statistics.upload.p50_ms << "/" << statistics.upload.p99_ms << " ms cpu, "
+                      << statistics.gpu_upload.p50_ms << "/" << statistics.gpu_upload.p99_ms << " ms gpu, "
+                      << "swap p50/p99: "
+                      << statistics.swap.p50_ms << "/" << statistics.swap.p99_ms << " ms, "
+                      << statistics.gl_call_count << " gl calls ("
+                      << statistics.gl_skipped_call_count << " skipped)\n";
+
+            time_in_image_show = time_in_image_show.zero();
+            frame_count = 0;
+        }
     }
 
     delete[] red_image;
@@ -0,0 +1,556 @@
+///
+/// @file frame_capture.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `FrameCapture` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include "frame_capture.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    FrameCapture::~FrameCapture() noexcept
+    {
+        this->stop();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    bool FrameCapture::start(const CaptureSettings& settings)
+    {
+        if (this->m_worker.joinable()
+            || (!settings.callback && !settings.file_path))
+        {
+            return false;
+        }
+
+        if (!settings.callback)
+        {
+            this->m_file = std::fopen(settings.file_path, "wb");
+
+            if (!this->m_file)
+            {
+                return false;
+            }
+        }
+
+        this->m_stream_width = 0;
+        this->m_stream_height = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_settings = settings;
+            this->m_settings.frames_in_flight = std::clamp(settings.frames_in_flight, 2, m_max_frames_in_flight);
+            this->m_statistics = {0, 0};
+            this->m_is_active = true;
+            ++this->m_session;
+        }
+
+        this->m_worker = std::thread(&FrameCapture::run_worker, this);
+
+        return true;
+    }
+
+    void FrameCapture::flush() noexcept
+    {
+        if (this->m_readback_count != 0)
+        {
+            this->collect(true);
+        }
+    }
+
+    void FrameCapture::stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_is_active = false;
+        }
+
+        this->m_condition.notify_one();
+
+        if (this->m_worker.joinable())
+        {
+            this->m_worker.join();
+        }
+
+        if (this->m_file)
+        {
+            std::fclose(this->m_file);
+            this->m_file = nullptr;
+        }
+    }
+
+    void FrameCapture::capture(GLStateCache& gl_state) noexcept
+    {
+        bool is_active = false;
+        uint32_t session = 0;
+        int frames_in_flight = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            is_active = this->m_is_active;
+            session = this->m_session;
+            frames_in_flight = this->m_settings.frames_in_flight;
+        }
+
+        // Readbacks of an earlier capture are not delivered
+        if (session != this->m_readback_session || !is_active)
+        {
+            this->release();
+            this->m_readback_session = session;
+            this->m_next_frame_index = 0;
+        }
+
+        if (!is_active)
+        {
+            return;
+        }
+
+        if (0 == this->m_readback_count)
+        {
+            for (int index = 0; index < frames_in_flight; ++index)
+            {
+                glGenBuffers(1, &this->m_readbacks[index].buffer);
+            }
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            gl_state.count_calls(static_cast<uint32_t>(frames_in_flight) + 1);
+            this->m_readback_count = frames_in_flight;
+        }
+
+        this->collect(false);
+
+        const uint64_t frame_index = this->m_next_frame_index++;
+
+        if (this->m_pending_count == this->m_readback_count)
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            ++this->m_statistics.dropped_frame_count;
+
+            return;
+        }
+
+        // The viewport covers the drawn part of the bound framebuffer
+        GLint viewport[4] = {0, 0, 0, 0};
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        Readback& readback = this->m_readbacks[(this->m_first_pending + this->m_pending_count)
+                                               % this->m_readback_count];
+        const size_t size = static_cast<size_t>(viewport[2]) * viewport[3] * 4;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+
+        if (size > readback.capacity)
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER,
+                         static_cast<GLsizeiptr>(size),
+                         nullptr,
+                         GL_STREAM_READ);
+            readback.capacity = size;
+            gl_state.count_calls();
+        }
+
+        glReadPixels(viewport[0],
+                     viewport[1],
+                     viewport[2],
+                     viewport[3],
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     nullptr);
+        readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        gl_state.count_calls(5);
+
+        readback.width = viewport[2];
+        readback.height = viewport[3];
+        readback.frame_index = frame_index;
+        ++this->m_pending_count;
+    }
+
+    void FrameCapture::release() noexcept
+    {
+        {
+            // Queued frames are copied even after a stop, so the worker
+            // is done with every mapping once it drained its queue.
+            std::unique_lock<std::mutex> lock(this->m_mutex);
+            this->m_copy_condition.wait(lock, [this]
+            {
+                return std::none_of(this->m_is_copy_pending.begin(),
+                                    this->m_is_copy_pending.end(),
+                                    [](bool is_pending) { return is_pending; });
+            });
+        }
+
+        for (int index = 0; index < this->m_readback_count; ++index)
+        {
+            Readback& readback = this->m_readbacks[index];
+
+            if (readback.fence)
+            {
+                glDeleteSync(readback.fence);
+            }
+
+            if (readback.is_mapped)
+            {
+                unmap(readback);
+            }
+
+            glDeleteBuffers(1, &readback.buffer);
+            readback = Readback{};
+        }
+
+        this->m_readback_count = 0;
+        this->m_first_pending = 0;
+        this->m_pending_count = 0;
+    }
+
+    CaptureStatistics FrameCapture::get_statistics() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+
+        return this->m_statistics;
+    }
+
+    bool FrameCapture::is_active() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+
+        return this->m_is_active;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void FrameCapture::collect(bool is_blocking) noexcept
+    {
+        constexpr GLuint64 timeout_ns = 1000000000;
+
+        for (int offset = 0; offset < this->m_pending_count; ++offset)
+        {
+            const int index = (this->m_first_pending + offset) % this->m_readback_count;
+            Readback& readback = this->m_readbacks[index];
+
+            // Handed to the worker already
+            if (!readback.fence)
+            {
+                continue;
+            }
+
+            const GLenum status = is_blocking
+                                  ? glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns)
+                                  : glClientWaitSync(readback.fence, 0, 0);
+
+            if (GL_TIMEOUT_EXPIRED == status && !is_blocking)
+            {
+                break;
+            }
+
+            readback.is_mapped = (GL_ALREADY_SIGNALED == status || GL_CONDITION_SATISFIED == status)
+                                 && this->deliver(index);
+
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+
+        // Buffers are reused in order once the worker copied them
+        while (this->m_pending_count > 0)
+        {
+            Readback& readback = this->m_readbacks[this->m_first_pending];
+
+            if (readback.fence)
+            {
+                break;
+            }
+
+            if (readback.is_mapped)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(this->m_mutex);
+
+                    if (this->m_is_copy_pending[this->m_first_pending])
+                    {
+                        break;
+                    }
+                }
+
+                unmap(readback);
+            }
+
+            this->m_first_pending = (this->m_first_pending + 1) % this->m_readback_count;
+            --this->m_pending_count;
+        }
+    }
+
+    bool FrameCapture::deliver(int readback_index) noexcept
+    {
+        Readback& readback = this->m_readbacks[readback_index];
+        const size_t size = static_cast<size_t>(readback.width) * readback.height * 4;
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+
+            if (this->m_queue.size() >= m_max_queued_frames)
+            {
+                ++this->m_statistics.dropped_frame_count;
+
+                return false;
+            }
+        }
+
+        // The worker copies straight out of the mapping, the frame is not
+        // copied on the drawing thread.
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        const void* mapped_ptr = glMapBufferRange(GL_PIXEL_PACK_BUFFER,
+                                                  0,
+                                                  static_cast<GLsizeiptr>(size),
+                                                  GL_MAP_READ_BIT);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+
+        // The capture can be stopped by another thread meanwhile
+        if (!mapped_ptr || !this->m_is_active || this->m_readback_session != this->m_session)
+        {
+            ++this->m_statistics.dropped_frame_count;
+
+            if (mapped_ptr)
+            {
+                unmap(readback);
+            }
+
+            return false;
+        }
+
+        this->m_is_copy_pending[readback_index] = true;
+        this->m_queue.push_back({{},
+                                 static_cast<const uint8_t*>(mapped_ptr),
+                                 readback_index,
+                                 readback.width,
+                                 readback.height,
+                                 readback.frame_index});
+        this->m_condition.notify_one();
+
+        return true;
+    }
+
+    void FrameCapture::unmap(Readback& readback) noexcept
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        readback.is_mapped = false;
+    }
+
+    void FrameCapture::run_worker() noexcept
+    {
+        for (;;)
+        {
+            CapturedFrame frame;
+
+            {
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                this->m_condition.wait(lock, [this]
+                {
+                    return !this->m_queue.empty() || !this->m_is_active;
+                });
+
+                // Queued frames are still delivered after a stop
+                if (this->m_queue.empty())
+                {
+                    return;
+                }
+
+                frame = std::move(this->m_queue.front());
+                this->m_queue.pop_front();
+
+                if (!this->m_free_buffers.empty())
+                {
+                    frame.pixels = std::move(this->m_free_buffers.back());
+                    this->m_free_buffers.pop_back();
+                }
+            }
+
+            const size_t size = static_cast<size_t>(frame.width) * frame.height * 4;
+            frame.pixels.resize(size);
+            std::memcpy(frame.pixels.data(), frame.mapped_ptr, size);
+
+            {
+                // The drawing thread unmaps the buffer from now on
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                this->m_is_copy_pending[frame.readback_index] = false;
+            }
+
+            this->m_copy_condition.notify_all();
+
+            const bool is_written = this->write_frame(frame);
+
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+
+            if (is_written)
+            {
+                ++this->m_statistics.captured_frame_count;
+            }
+            else
+            {
+                ++this->m_statistics.dropped_frame_count;
+            }
+
+            this->m_free_buffers.push_back(std::move(frame.pixels));
+        }
+    }
+
+    bool FrameCapture::write_frame(CapturedFrame& frame) noexcept
+    {
+        const size_t row_size = static_cast<size_t>(frame.width) * 4;
+
+        if (this->m_settings.callback)
+        {
+            // OpenGL returns the bottom row first
+            std::vector<uint8_t>& pixels = frame.pixels;
+
+            for (int top = 0, bottom = frame.height - 1; top < bottom; ++top, --bottom)
+            {
+                std::swap_ranges(pixels.begin() + top * row_size,
+                                 pixels.begin() + (top + 1) * row_size,
+                                 pixels.begin() + bottom * row_size);
+            }
+
+            this->m_settings.callback(pixels.data(),
+                                      frame.width,
+                                      frame.height,
+                                      frame.frame_index,
+                                      this->m_settings.user_data);
+
+            return true;
+        }
+
+        if (CaptureFileFormat::Y4M == this->m_settings.file_format)
+        {
+            return this->write_y4m_frame(frame);
+        }
+
+        for (int row = frame.height - 1; row >= 0; --row)
+        {
+            if (std::fwrite(frame.pixels.data() + row * row_size, 1, row_size, this->m_file) != row_size)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool FrameCapture::write_y4m_frame(const CapturedFrame& frame) noexcept
+    {
+        if (0 == this->m_stream_width)
+        {
+            const double frame_rate = this->m_settings.frame_rate > 0.0 ? this->m_settings.frame_rate : 30.0;
+            const long numerator = std::lround(frame_rate * 1000.0);
+            const long divisor = std::gcd(numerator, 1000L);
+
+            std::fprintf(this->m_file,
+                         "YUV4MPEG2 W%d H%d F%ld:%ld Ip A1:1 C420jpeg\n",
+                         frame.width,
+                         frame.height,
+                         numerator / divisor,
+                         1000L / divisor);
+
+            this->m_stream_width = frame.width;
+            this->m_stream_height = frame.height;
+        }
+
+        // A Y4M stream has a single frame size
+        if (frame.width != this->m_stream_width || frame.height != this->m_stream_height)
+        {
+            return false;
+        }
+
+        const int width = frame.width;
+        const int height = frame.height;
+        const int chroma_width = (width + 1) / 2;
+        const int chroma_height = (height + 1) / 2;
+        const size_t luma_size = static_cast<size_t>(width) * height;
+        const size_t chroma_size = static_cast<size_t>(chroma_width) * chroma_height;
+
+        this->m_converted.resize(luma_size + 2 * chroma_size);
+        uint8_t* y_plane = this->m_converted.data();
+        uint8_t* u_plane = y_plane + luma_size;
+        uint8_t* v_plane = u_plane + chroma_size;
+
+        // Rows are read bottom up, BT.601 limited range like the display shader
+        const auto pixel_at = [&](int x, int y)
+        {
+            return frame.pixels.data() + ((static_cast<size_t>(height - 1 - y) * width) + x) * 4;
+        };
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const uint8_t* rgba = pixel_at(x, y);
+                y_plane[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>(
+                    ((66 * rgba[0] + 129 * rgba[1] + 25 * rgba[2] + 128) >> 8) + 16);
+            }
+        }
+
+        for (int y = 0; y < chroma_height; ++y)
+        {
+            for (int x = 0; x < chroma_width; ++x)
+            {
+                int red = 0;
+                int green = 0;
+                int blue = 0;
+                int count = 0;
+
+                for (int dy = 0; dy < 2 && 2 * y + dy < height; ++dy)
+                {
+                    for (int dx = 0; dx < 2 && 2 * x + dx < width; ++dx)
+                    {
+                        const uint8_t* rgba = pixel_at(2 * x + dx, 2 * y + dy);
+                        red += rgba[0];
+                        green += rgba[1];
+                        blue += rgba[2];
+                        ++count;
+                    }
+                }
+
+                red /= count;
+                green /= count;
+                blue /= count;
+
+                const size_t index = static_cast<size_t>(y) * chroma_width + x;
+                u_plane[index] = static_cast<uint8_t>(((-38 * red - 74 * green + 112 * blue + 128) >> 8) + 128);
+                v_plane[index] = static_cast<uint8_t>(((112 * red - 94 * green - 18 * blue + 128) >> 8) + 128);
+            }
+        }
+
+        return std::fputs("FRAME\n", this->m_file) >= 0
+               && std::fwrite(this->m_converted.data(), 1, this->m_converted.size(), this->m_file)
+                  == this->m_converted.size();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,335 @@
+///
+/// @file frame_pacer.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `FramePacer` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <thread>
+#include "frame_pacer.hpp"
+
+#ifdef _WIN32
+// Keeps std::min and std::max usable after the Windows headers
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    FramePacer::FramePacer(PacingMode mode) noexcept :
+        m_pending_settings{mode, 0.0},
+        m_swap_interval{(PacingMode::VSync == mode) ? 1 : 0},
+        m_settings{mode, 0.0}
+    {
+#ifdef _WIN32
+        // Sleeps are rounded up to the system timer tick, which defaults to
+        // 15.6 ms and would leave the limiter spinning for whole frames.
+        timeBeginPeriod(1);
+#endif
+    }
+
+    FramePacer::~FramePacer() noexcept
+    {
+#ifdef _WIN32
+        timeEndPeriod(1);
+#endif
+    }
+
+    void FramePacer::set_settings(const PacingSettings& settings) noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_settings_mutex);
+
+        this->m_pending_settings = settings;
+        this->m_has_pending_settings.store(true, std::memory_order_release);
+    }
+
+    void FramePacer::set_swap_interval(int interval) noexcept
+    {
+        glfwSwapInterval(interval);
+
+        std::lock_guard<std::mutex> lock(this->m_statistics_mutex);
+        this->m_swap_interval = interval;
+    }
+
+    void FramePacer::set_grouped(bool is_grouped) noexcept
+    {
+        if (is_grouped)
+        {
+            {
+                // The settings in use come back when the window leaves the group
+                std::lock_guard<std::mutex> lock(this->m_settings_mutex);
+
+                if (!this->m_has_pending_settings.load(std::memory_order_relaxed))
+                {
+                    this->m_pending_settings = this->m_settings;
+                    this->m_has_pending_settings.store(true, std::memory_order_release);
+                }
+            }
+
+            this->m_settings = {PacingMode::Unlimited, 0.0};
+            this->m_target_period = clock::duration::zero();
+            this->m_release_time = clock::time_point{};
+        }
+
+        this->m_is_grouped.store(is_grouped, std::memory_order_release);
+    }
+
+    void FramePacer::begin_swap() noexcept
+    {
+        if (!this->m_is_grouped.load(std::memory_order_acquire)
+            && this->m_has_pending_settings.exchange(false, std::memory_order_acquire))
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->m_settings_mutex);
+                this->m_settings = this->m_pending_settings;
+            }
+
+            int interval = 0;
+
+            switch (this->m_settings.mode)
+            {
+                case PacingMode::VSync:
+                case PacingMode::LowLatency:
+                    interval = 1;
+                break;
+                case PacingMode::AdaptiveVSync:
+                    interval = (glfwExtensionSupported("WGL_EXT_swap_control_tear")
+                                || glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+                               ? -1
+                               : 1;
+                break;
+                default:
+                break;
+            }
+
+            this->set_swap_interval(interval);
+
+            this->m_target_period = clock::duration::zero();
+
+            if (PacingMode::TargetRate == this->m_settings.mode
+                && this->m_settings.target_frame_rate > 0.0)
+            {
+                this->m_target_period = std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(1.0 / this->m_settings.target_frame_rate));
+            }
+
+            this->m_display_period = clock::duration::zero();
+            this->m_frame_work = clock::duration::zero();
+            this->m_next_present = clock::time_point{};
+            this->m_last_present = clock::time_point{};
+            this->m_release_time = clock::time_point{};
+
+            // Jitter of the previous mode says nothing about this one
+            std::lock_guard<std::mutex> lock(this->m_statistics_mutex);
+            this->m_intervals = RollingPercentiles{};
+            this->m_late_frame_count = 0;
+        }
+
+        if (PacingMode::LowLatency == this->m_settings.mode
+            && this->m_release_time != clock::time_point{})
+        {
+            const clock::duration work = clock::now() - this->m_release_time;
+
+            // Longer frames count at once, a single short one must not make
+            // the next frame miss its vertical blank.
+            this->m_frame_work = (work > this->m_frame_work)
+                                 ? work
+                                 : (this->m_frame_work * 7 + work) / 8;
+        }
+
+        if (this->m_target_period > clock::duration::zero())
+        {
+            const clock::time_point now = clock::now();
+
+            if (this->m_next_present == clock::time_point{}
+                || now > this->m_next_present + this->m_target_period)
+            {
+                // A whole period behind, the schedule restarts instead of
+                // presenting a burst of frames to catch up.
+                this->m_next_present = now;
+            }
+            else
+            {
+                this->wait_until(this->m_next_present);
+            }
+
+            this->m_next_present += this->m_target_period;
+        }
+    }
+
+    void FramePacer::end_swap() noexcept
+    {
+        if (PacingMode::LowLatency == this->m_settings.mode)
+        {
+            // Drivers return from the swap while they still queue frames,
+            // finishing waits until this one is really presented.
+            glFinish();
+        }
+
+        const clock::time_point now = clock::now();
+
+        if (this->m_last_present != clock::time_point{} && !this->m_has_skipped_present)
+        {
+            const clock::duration interval = now - this->m_last_present;
+            const clock::duration expected_period = (this->m_target_period > clock::duration::zero())
+                                                    ? this->m_target_period
+                                                    : this->m_display_period;
+
+            const bool is_late = expected_period > clock::duration::zero()
+                                 && interval > expected_period * 3 / 2;
+
+            if (this->m_swap_interval != 0)
+            {
+                // Intervals of missed blanks are multiples of the period and
+                // are left out, a shorter interval means a faster display.
+                if (this->m_display_period == clock::duration::zero()
+                    || interval < this->m_display_period * 3 / 4)
+                {
+                    this->m_display_period = interval;
+                }
+                else if (interval < this->m_display_period * 3 / 2)
+                {
+                    this->m_display_period = (this->m_display_period * 15 + interval) / 16;
+                }
+            }
+
+            const std::chrono::duration<float, std::milli> interval_ms = interval;
+
+            std::lock_guard<std::mutex> lock(this->m_statistics_mutex);
+            this->m_intervals.add(interval_ms.count());
+
+            if (is_late)
+            {
+                ++this->m_late_frame_count;
+            }
+        }
+
+        this->m_last_present = now;
+        this->m_has_skipped_present = false;
+    }
+
+    void FramePacer::delay_next_frame() noexcept
+    {
+        if (PacingMode::LowLatency == this->m_settings.mode
+            && this->m_display_period > clock::duration::zero())
+        {
+            this->wait_until(this->m_last_present
+                             + this->m_display_period
+                             - this->m_frame_work
+                             - m_low_latency_margin);
+        }
+
+        this->m_release_time = clock::now();
+    }
+
+    void FramePacer::skip_present() noexcept
+    {
+        this->m_has_skipped_present = true;
+
+        if (this->m_target_period > clock::duration::zero())
+        {
+            this->begin_swap();
+            return;
+        }
+
+        if (0 == this->m_swap_interval)
+        {
+            return;
+        }
+
+        const clock::time_point now = clock::now();
+
+        if (this->m_display_period > clock::duration::zero()
+            && this->m_last_present != clock::time_point{})
+        {
+            // The vertical blank the present would have waited for
+            const auto elapsed_periods = (now - this->m_last_present) / this->m_display_period;
+            this->wait_until(this->m_last_present + this->m_display_period * (elapsed_periods + 1));
+        }
+        else
+        {
+            // The display period is not measured yet
+            this->wait_until(now + std::chrono::microseconds(16667));
+        }
+    }
+
+    PacingStatistics FramePacer::get_statistics() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_statistics_mutex);
+
+        PacingStatistics statistics{};
+        statistics.frame_interval = this->m_intervals.get_percentiles();
+        this->m_intervals.get_spread(statistics.mean_interval_ms, statistics.jitter_ms);
+        statistics.late_frame_count = this->m_late_frame_count;
+        statistics.swap_interval = this->m_swap_interval;
+
+        return statistics;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void FramePacer::wait_until(clock::time_point deadline) noexcept
+    {
+        for (;;)
+        {
+            const clock::time_point now = clock::now();
+
+            if (now >= deadline)
+            {
+                return;
+            }
+
+            const clock::duration remaining = deadline - now;
+
+            if (remaining > this->m_sleep_overshoot + m_spin_margin)
+            {
+                const clock::duration requested = remaining - this->m_sleep_overshoot - m_spin_margin;
+                std::this_thread::sleep_for(requested);
+
+                const clock::duration overshoot = std::clamp<clock::duration>(clock::now() - now - requested,
+                                                                              clock::duration::zero(),
+                                                                              std::chrono::milliseconds(20));
+
+                // Grows at once and shrinks slowly, an early wake up only costs spinning
+                this->m_sleep_overshoot = (overshoot > this->m_sleep_overshoot)
+                                          ? overshoot
+                                          : (this->m_sleep_overshoot * 15 + overshoot) / 16;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,264 @@
+///
+/// @file frame_profiler.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `FrameProfiler` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include "frame_profiler.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void RollingPercentiles::add(float milliseconds) noexcept
+    {
+        this->m_samples[this->m_next_index] = milliseconds;
+        this->m_next_index = (this->m_next_index + 1) % m_capacity;
+        this->m_count = std::min(this->m_count + 1, m_capacity);
+    }
+
+    TimingPercentiles RollingPercentiles::get_percentiles() const noexcept
+    {
+        if (0 == this->m_count)
+        {
+            return {0.0, 0.0, 0.0};
+        }
+
+        std::array<float, m_capacity> sorted = this->m_samples;
+        std::sort(sorted.begin(), sorted.begin() + this->m_count);
+
+        const auto at = [&](double percentile)
+        {
+            return static_cast<double>(
+                sorted[static_cast<size_t>(percentile * (this->m_count - 1) + 0.5)]);
+        };
+
+        return {at(0.50), at(0.95), at(0.99)};
+    }
+
+    void RollingPercentiles::get_spread(double& mean, double& standard_deviation) const noexcept
+    {
+        mean = 0.0;
+        standard_deviation = 0.0;
+
+        if (0 == this->m_count)
+        {
+            return;
+        }
+
+        for (size_t idx = 0; idx < this->m_count; ++idx)
+        {
+            mean += this->m_samples[idx];
+        }
+
+        mean /= static_cast<double>(this->m_count);
+
+        for (size_t idx = 0; idx < this->m_count; ++idx)
+        {
+            const double difference = this->m_samples[idx] - mean;
+            standard_deviation += difference * difference;
+        }
+
+        standard_deviation = std::sqrt(standard_deviation / static_cast<double>(this->m_count));
+    }
+
+    void FrameProfiler::create_queries() noexcept
+    {
+        glGenQueries(m_query_frame_count * m_gpu_stage_count, &this->m_queries[0][0]);
+    }
+
+    void FrameProfiler::release_queries() noexcept
+    {
+        if (this->m_queries[0][0] != 0)
+        {
+            glDeleteQueries(m_query_frame_count * m_gpu_stage_count, &this->m_queries[0][0]);
+
+            for (auto& frame_queries : this->m_queries)
+            {
+                std::fill(std::begin(frame_queries), std::end(frame_queries), 0);
+            }
+        }
+    }
+
+    void FrameProfiler::begin_stage(FrameStage stage) noexcept
+    {
+        if (FrameStage::Count != this->m_current_stage)
+        {
+            // Only one time elapsed query can be active
+            ++this->m_nested_stage_count;
+            return;
+        }
+
+        this->m_current_stage = stage;
+        this->m_stage_begin = clock::now();
+
+        const int gpu_stage = (FrameStage::Upload == stage) ? 0
+                              : (FrameStage::Draw == stage) ? 1
+                              : -1;
+
+        if (gpu_stage >= 0
+            && this->m_queries[0][0] != 0
+            && !this->m_is_query_issued[gpu_stage])
+        {
+            // A result which is still not available after
+            // `m_query_frame_count` frames is dropped.
+            this->m_is_query_pending[this->m_query_frame_index][gpu_stage] = true;
+            this->m_is_query_issued[gpu_stage] = true;
+            this->m_is_query_active = true;
+            glBeginQuery(GL_TIME_ELAPSED,
+                         this->m_queries[this->m_query_frame_index][gpu_stage]);
+        }
+    }
+
+    void FrameProfiler::end_stage() noexcept
+    {
+        if (FrameStage::Count == this->m_current_stage)
+        {
+            return;
+        }
+
+        if (this->m_nested_stage_count > 0)
+        {
+            --this->m_nested_stage_count;
+            return;
+        }
+
+        const int stage_idx = static_cast<int>(this->m_current_stage);
+        const std::chrono::duration<float, std::milli> elapsed = clock::now() - this->m_stage_begin;
+
+        // Stages can run more than once in a frame, e.g. a released acquire
+        this->m_frame_times[stage_idx] += elapsed.count();
+        this->m_is_stage_measured[stage_idx] = true;
+
+        if (this->m_is_query_active)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+            this->m_is_query_active = false;
+        }
+
+        this->m_current_stage = FrameStage::Count;
+    }
+
+    void FrameProfiler::end_frame() noexcept
+    {
+        float gpu_times[m_query_frame_count * m_gpu_stage_count];
+        int gpu_stages[m_query_frame_count * m_gpu_stage_count];
+        int gpu_time_count = 0;
+
+        for (int frame_idx = 0; frame_idx < m_query_frame_count; ++frame_idx)
+        {
+            // The current frame's queries are too fresh to be ready
+            if (frame_idx == this->m_query_frame_index)
+            {
+                continue;
+            }
+
+            for (int stage_idx = 0; stage_idx < m_gpu_stage_count; ++stage_idx)
+            {
+                if (!this->m_is_query_pending[frame_idx][stage_idx])
+                {
+                    continue;
+                }
+
+                GLint is_available = GL_FALSE;
+                glGetQueryObjectiv(this->m_queries[frame_idx][stage_idx],
+                                   GL_QUERY_RESULT_AVAILABLE,
+                                   &is_available);
+
+                if (GL_TRUE == is_available)
+                {
+                    GLuint64 nanoseconds = 0;
+                    glGetQueryObjectui64v(this->m_queries[frame_idx][stage_idx],
+                                          GL_QUERY_RESULT,
+                                          &nanoseconds);
+
+                    gpu_times[gpu_time_count] = static_cast<float>(nanoseconds) * 1.0e-6f;
+                    gpu_stages[gpu_time_count] = stage_idx;
+                    ++gpu_time_count;
+
+                    this->m_is_query_pending[frame_idx][stage_idx] = false;
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+
+            for (int stage_idx = 0; stage_idx < m_stage_count; ++stage_idx)
+            {
+                if (this->m_is_stage_measured[stage_idx])
+                {
+                    this->m_cpu_percentiles[stage_idx].add(this->m_frame_times[stage_idx]);
+                }
+            }
+
+            for (int idx = 0; idx < gpu_time_count; ++idx)
+            {
+                this->m_gpu_percentiles[gpu_stages[idx]].add(gpu_times[idx]);
+            }
+
+            ++this->m_presented_frame_count;
+        }
+
+        this->m_frame_times.fill(0.0f);
+        this->m_is_stage_measured.fill(false);
+        this->m_is_query_issued.fill(false);
+        this->m_query_frame_index = (this->m_query_frame_index + 1) % m_query_frame_count;
+    }
+
+    void FrameProfiler::discard_frame() noexcept
+    {
+        this->m_frame_times.fill(0.0f);
+        this->m_is_stage_measured.fill(false);
+        this->m_is_query_issued.fill(false);
+
+        // The slot is reused by the next frame, its results are never read
+        std::fill(std::begin(this->m_is_query_pending[this->m_query_frame_index]),
+                  std::end(this->m_is_query_pending[this->m_query_frame_index]),
+                  false);
+    }
+
+    FrameStatistics FrameProfiler::get_statistics() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+
+        FrameStatistics statistics{};
+        statistics.poll_events = this->m_cpu_percentiles[static_cast<int>(FrameStage::PollEvents)].get_percentiles();
+        statistics.upload = this->m_cpu_percentiles[static_cast<int>(FrameStage::Upload)].get_percentiles();
+        statistics.draw = this->m_cpu_percentiles[static_cast<int>(FrameStage::Draw)].get_percentiles();
+        statistics.swap = this->m_cpu_percentiles[static_cast<int>(FrameStage::Swap)].get_percentiles();
+        statistics.gpu_upload = this->m_gpu_percentiles[0].get_percentiles();
+        statistics.gpu_draw = this->m_gpu_percentiles[1].get_percentiles();
+        statistics.presented_frame_count = this->m_presented_frame_count;
+        statistics.dropped_frame_count = 0;
+
+        return statistics;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
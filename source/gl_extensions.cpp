@@ -0,0 +1,131 @@
+///
+/// @file gl_extensions.cpp
+/// @author Yasin BASAR
+/// @brief Implements the optional OpenGL entry point loader.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "gl_extensions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <GLFW/glfw3.h>
+
+namespace YB
+{
+    GLExtensions::TexStorage2DProc GLExtensions::tex_storage_2d{nullptr};
+    GLExtensions::BufferStorageProc GLExtensions::buffer_storage{nullptr};
+    GLExtensions::DebugMessageCallbackProc GLExtensions::debug_message_callback{nullptr};
+    GLExtensions::ClearTexImageProc GLExtensions::clear_tex_image{nullptr};
+    bool GLExtensions::has_s3tc{false};
+    bool GLExtensions::has_bptc{false};
+    bool GLExtensions::has_etc2{false};
+    bool GLExtensions::is_software_renderer{false};
+    bool GLExtensions::m_is_loaded{false};
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void GLExtensions::load() noexcept
+    {
+        if (m_is_loaded)
+        {
+            return;
+        }
+
+        if (is_supported(4, 2, "GL_ARB_texture_storage"))
+        {
+            tex_storage_2d = reinterpret_cast<TexStorage2DProc>(
+                glfwGetProcAddress("glTexStorage2D"));
+        }
+
+        if (is_supported(4, 4, "GL_ARB_buffer_storage"))
+        {
+            buffer_storage = reinterpret_cast<BufferStorageProc>(
+                glfwGetProcAddress("glBufferStorage"));
+        }
+
+        if (is_supported(4, 3, "GL_KHR_debug"))
+        {
+            debug_message_callback = reinterpret_cast<DebugMessageCallbackProc>(
+                glfwGetProcAddress("glDebugMessageCallback"));
+        }
+
+        if (is_supported(4, 4, "GL_ARB_clear_texture"))
+        {
+            clear_tex_image = reinterpret_cast<ClearTexImageProc>(
+                glfwGetProcAddress("glClearTexImage"));
+        }
+
+        // S3TC never became core, only the extension tells
+        has_s3tc = GLFW_TRUE == glfwExtensionSupported("GL_EXT_texture_compression_s3tc");
+        has_bptc = is_supported(4, 2, "GL_ARB_texture_compression_bptc");
+        has_etc2 = is_supported(4, 3, "GL_ARB_ES3_compatibility");
+
+        const GLubyte* renderer = glGetString(GL_RENDERER);
+
+        if (renderer)
+        {
+            const char* name = reinterpret_cast<const char*>(renderer);
+
+            // Mesa, Chrome and Windows software rasterizers
+            constexpr const char* software_names[] =
+            {
+                "llvmpipe",
+                "softpipe",
+                "SwiftShader",
+                "Microsoft Basic Render Driver",
+                "GDI Generic"
+            };
+
+            for (const char* software_name : software_names)
+            {
+                if (std::strstr(name, software_name))
+                {
+                    is_software_renderer = true;
+                }
+            }
+        }
+
+        m_is_loaded = true;
+    }
+
+    bool GLExtensions::is_supported(int major,
+                                    int minor,
+                                    const char* extension) noexcept
+    {
+        GLint context_major = 0;
+        GLint context_minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &context_major);
+        glGetIntegerv(GL_MINOR_VERSION, &context_minor);
+
+        if (context_major > major
+            || (context_major == major && context_minor >= minor))
+        {
+            return true;
+        }
+
+        return GLFW_TRUE == glfwExtensionSupported(extension);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,283 @@
+///
+/// @file gl_state_cache.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `GLStateCache` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gl_state_cache.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    GLStateCache::GLStateCache() noexcept :
+        m_program{m_unknown},
+        m_active_unit{-1},
+        m_textures{},
+        m_vertex_array{m_unknown},
+        m_framebuffer{m_unknown},
+        m_pixel_unpack_buffer{m_unknown},
+        m_unpack_parameters{},
+        m_is_unpack_parameter_known{},
+        m_uniforms{},
+        m_is_uniform_known{},
+        m_issued_count{0},
+        m_skipped_count{0}
+    {
+        this->invalidate();
+    }
+
+    void GLStateCache::use_program(GLuint program) noexcept
+    {
+        if (this->count(program == this->m_program))
+        {
+            glUseProgram(program);
+            this->m_program = program;
+        }
+    }
+
+    void GLStateCache::bind_texture(int unit, GLenum target, GLuint texture) noexcept
+    {
+        const int target_index = get_target_index(target);
+
+        if (unit >= m_unit_count || target_index < 0)
+        {
+            // Not tracked, forward it and forget the active unit
+            this->count(false);
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            this->m_active_unit = -1;
+            return;
+        }
+
+        if (this->m_textures[unit][target_index] == texture)
+        {
+            this->count(true);
+            return;
+        }
+
+        if (this->count(unit == this->m_active_unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            this->m_active_unit = unit;
+        }
+
+        this->count(false);
+        glBindTexture(target, texture);
+        this->m_textures[unit][target_index] = texture;
+    }
+
+    void GLStateCache::bind_vertex_array(GLuint vertex_array) noexcept
+    {
+        if (this->count(vertex_array == this->m_vertex_array))
+        {
+            glBindVertexArray(vertex_array);
+            this->m_vertex_array = vertex_array;
+        }
+    }
+
+    void GLStateCache::bind_framebuffer(GLuint framebuffer) noexcept
+    {
+        if (this->count(framebuffer == this->m_framebuffer))
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            this->m_framebuffer = framebuffer;
+        }
+    }
+
+    void GLStateCache::bind_pixel_unpack_buffer(GLuint buffer) noexcept
+    {
+        if (this->count(buffer == this->m_pixel_unpack_buffer))
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+            this->m_pixel_unpack_buffer = buffer;
+        }
+    }
+
+    void GLStateCache::set_unpack_parameter(GLenum parameter, GLint value) noexcept
+    {
+        int index = -1;
+
+        switch (parameter)
+        {
+            case GL_UNPACK_ALIGNMENT: index = 0; break;
+            case GL_UNPACK_ROW_LENGTH: index = 1; break;
+            case GL_UNPACK_SKIP_PIXELS: index = 2; break;
+            case GL_UNPACK_SKIP_ROWS: index = 3; break;
+            default: break;
+        }
+
+        const bool is_redundant = index >= 0
+                                  && this->m_is_unpack_parameter_known[index]
+                                  && this->m_unpack_parameters[index] == value;
+
+        if (this->count(is_redundant))
+        {
+            glPixelStorei(parameter, value);
+
+            if (index >= 0)
+            {
+                this->m_unpack_parameters[index] = value;
+                this->m_is_unpack_parameter_known[index] = true;
+            }
+        }
+    }
+
+    void GLStateCache::set_uniform(GLint location, GLint value) noexcept
+    {
+        const bool is_tracked = location >= 0 && location < m_uniform_count;
+        const GLfloat stored = static_cast<GLfloat>(value);
+
+        if (this->count(is_tracked
+                        && this->m_is_uniform_known[location]
+                        && this->m_uniforms[location][0] == stored))
+        {
+            glUniform1i(location, value);
+
+            if (is_tracked)
+            {
+                this->m_uniforms[location][0] = stored;
+                this->m_is_uniform_known[location] = true;
+            }
+        }
+    }
+
+    void GLStateCache::set_uniform(GLint location, GLfloat x, GLfloat y) noexcept
+    {
+        const bool is_tracked = location >= 0 && location < m_uniform_count;
+
+        if (this->count(is_tracked
+                        && this->m_is_uniform_known[location]
+                        && this->m_uniforms[location][0] == x
+                        && this->m_uniforms[location][1] == y))
+        {
+            glUniform2f(location, x, y);
+
+            if (is_tracked)
+            {
+                this->m_uniforms[location][0] = x;
+                this->m_uniforms[location][1] = y;
+                this->m_is_uniform_known[location] = true;
+            }
+        }
+    }
+
+    void GLStateCache::set_uniform(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w) noexcept
+    {
+        const bool is_tracked = location >= 0 && location < m_uniform_count;
+
+        if (this->count(is_tracked
+                        && this->m_is_uniform_known[location]
+                        && this->m_uniforms[location][0] == x
+                        && this->m_uniforms[location][1] == y
+                        && this->m_uniforms[location][2] == z
+                        && this->m_uniforms[location][3] == w))
+        {
+            glUniform4f(location, x, y, z, w);
+
+            if (is_tracked)
+            {
+                this->m_uniforms[location][0] = x;
+                this->m_uniforms[location][1] = y;
+                this->m_uniforms[location][2] = z;
+                this->m_uniforms[location][3] = w;
+                this->m_is_uniform_known[location] = true;
+            }
+        }
+    }
+
+    void GLStateCache::invalidate_uniforms() noexcept
+    {
+        for (bool& is_known : this->m_is_uniform_known)
+        {
+            is_known = false;
+        }
+    }
+
+    void GLStateCache::invalidate() noexcept
+    {
+        this->m_program = m_unknown;
+        this->m_active_unit = -1;
+
+        for (auto& unit_textures : this->m_textures)
+        {
+            for (GLuint& texture : unit_textures)
+            {
+                texture = m_unknown;
+            }
+        }
+
+        this->m_vertex_array = m_unknown;
+        this->m_framebuffer = m_unknown;
+        this->m_pixel_unpack_buffer = m_unknown;
+
+        for (bool& is_known : this->m_is_unpack_parameter_known)
+        {
+            is_known = false;
+        }
+
+        this->invalidate_uniforms();
+    }
+
+    void GLStateCache::count_calls(uint32_t count) noexcept
+    {
+        this->m_issued_count += count;
+    }
+
+    void GLStateCache::take_call_counts(uint32_t& issued_count, uint32_t& skipped_count) noexcept
+    {
+        issued_count = this->m_issued_count;
+        skipped_count = this->m_skipped_count;
+
+        this->m_issued_count = 0;
+        this->m_skipped_count = 0;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    int GLStateCache::get_target_index(GLenum target) noexcept
+    {
+        switch (target)
+        {
+            case GL_TEXTURE_1D: return 0;
+            case GL_TEXTURE_2D: return 1;
+            case GL_TEXTURE_2D_ARRAY: return 2;
+            default: return -1;
+        }
+    }
+
+    bool GLStateCache::count(bool is_redundant) noexcept
+    {
+        if (is_redundant)
+        {
+            ++this->m_skipped_count;
+            return false;
+        }
+
+        ++this->m_issued_count;
+        return true;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,266 @@
+///
+/// @file mosaic_texture.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `MosaicTexture` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+#include "mosaic_texture.hpp"
+#include "gl_extensions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    MosaicTexture::MosaicTexture() noexcept :
+        m_layout{},
+        m_tile_layout{},
+        m_texture{0},
+        m_is_mipmap_filter{false},
+        m_are_mipmaps_dirty{false}
+    {
+    }
+
+    bool MosaicTexture::configure(const MosaicLayout& layout, GLStateCache& gl_state)
+    {
+        this->release();
+
+        // Deleting unbinds the array and its name can be reused
+        gl_state.invalidate();
+
+        if (layout.columns <= 0)
+        {
+            return true;
+        }
+
+        GLint max_texture_size = 0;
+        GLint max_layer_count = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layer_count);
+
+        if (layout.rows <= 0
+            || layout.tile_width <= 0
+            || layout.tile_height <= 0
+            || layout.tile_width > max_texture_size
+            || layout.tile_height > max_texture_size
+            || static_cast<int64_t>(layout.columns) * layout.rows > max_layer_count)
+        {
+            return false;
+        }
+
+        const ImageLayout tile_layout = get_image_layout(layout.format,
+                                                         layout.tile_width,
+                                                         layout.tile_height);
+
+        // Layers hold a single texture each
+        if (1 != tile_layout.plane_count
+            || SamplingLayout::PackedYuyv == tile_layout.sampling_layout)
+        {
+            return false;
+        }
+
+        const PlaneLayout& plane = tile_layout.planes[0];
+        const int layer_count = layout.columns * layout.rows;
+
+        int level_count = 1;
+
+        for (int size = std::max(plane.width, plane.height); size > 1; size /= 2)
+        {
+            ++level_count;
+        }
+
+        glGenTextures(1, &this->m_texture);
+        gl_state.bind_texture(texture_unit, GL_TEXTURE_2D_ARRAY, this->m_texture);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+
+        // Lower levels are allocated by the first mipmap build
+        gl_state.bind_pixel_unpack_buffer(0);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY,
+                     0,
+                     plane.internal_format,
+                     plane.width,
+                     plane.height,
+                     layer_count,
+                     0,
+                     plane.upload_format,
+                     plane.upload_type,
+                     nullptr);
+        gl_state.count_calls(7);
+
+        // Streams which did not deliver a frame yet show black
+        if (GLExtensions::clear_tex_image)
+        {
+            // Null data clears to zero without any client memory
+            GLExtensions::clear_tex_image(this->m_texture,
+                                          0,
+                                          plane.upload_format,
+                                          plane.upload_type,
+                                          nullptr);
+            gl_state.count_calls();
+        }
+        else
+        {
+            // One zeroed layer is uploaded into every layer, a buffer of the
+            // whole array can reach gigabytes for large grids.
+            const int row_size = plane.width * plane.bytes_per_texel;
+            const std::vector<uint8_t> black(static_cast<size_t>(row_size) * plane.height, 0);
+
+            gl_state.set_unpack_parameter(GL_UNPACK_ALIGNMENT, (row_size % 4 == 0) ? 4 : 1);
+            gl_state.set_unpack_parameter(GL_UNPACK_ROW_LENGTH, 0);
+            gl_state.set_unpack_parameter(GL_UNPACK_SKIP_PIXELS, 0);
+            gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, 0);
+
+            for (int layer = 0; layer < layer_count; ++layer)
+            {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                                0,
+                                0,
+                                0,
+                                layer,
+                                plane.width,
+                                plane.height,
+                                1,
+                                plane.upload_format,
+                                plane.upload_type,
+                                black.data());
+            }
+
+            gl_state.count_calls(static_cast<uint32_t>(layer_count));
+        }
+
+        this->m_layout = layout;
+        this->m_tile_layout = tile_layout;
+        this->m_is_mipmap_filter = false;
+        this->m_are_mipmaps_dirty = true;
+
+        return true;
+    }
+
+    void MosaicTexture::release() noexcept
+    {
+        if (this->m_texture != 0)
+        {
+            glDeleteTextures(1, &this->m_texture);
+            this->m_texture = 0;
+        }
+
+        this->m_layout = MosaicLayout{};
+        this->m_tile_layout = ImageLayout{};
+    }
+
+    bool MosaicTexture::is_enabled() const noexcept
+    {
+        return this->m_texture != 0;
+    }
+
+    const MosaicLayout& MosaicTexture::get_layout() const noexcept
+    {
+        return this->m_layout;
+    }
+
+    const ImageLayout& MosaicTexture::get_tile_layout() const noexcept
+    {
+        return this->m_tile_layout;
+    }
+
+    GLuint MosaicTexture::get_texture() const noexcept
+    {
+        return this->m_texture;
+    }
+
+    bool MosaicTexture::update_tile(int tile_index,
+                                    const uint8_t* data_ptr,
+                                    GLStateCache& gl_state) noexcept
+    {
+        if (!this->is_enabled()
+            || !data_ptr
+            || tile_index < 0
+            || tile_index >= this->m_layout.columns * this->m_layout.rows)
+        {
+            return false;
+        }
+
+        const PlaneLayout& plane = this->m_tile_layout.planes[0];
+        const int row_size = plane.width * plane.bytes_per_texel;
+
+        gl_state.bind_pixel_unpack_buffer(0);
+        gl_state.set_unpack_parameter(GL_UNPACK_ALIGNMENT, (row_size % 4 == 0) ? 4 : 1);
+        gl_state.set_unpack_parameter(GL_UNPACK_ROW_LENGTH, 0);
+        gl_state.set_unpack_parameter(GL_UNPACK_SKIP_PIXELS, 0);
+        gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, 0);
+        gl_state.bind_texture(texture_unit, GL_TEXTURE_2D_ARRAY, this->m_texture);
+
+        gl_state.count_calls();
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                        0,
+                        0,
+                        0,
+                        tile_index,
+                        plane.width,
+                        plane.height,
+                        1,
+                        plane.upload_format,
+                        plane.upload_type,
+                        data_ptr + plane.offset);
+
+        this->m_are_mipmaps_dirty = true;
+
+        return true;
+    }
+
+    void MosaicTexture::update_mipmaps(bool is_minified, GLStateCache& gl_state) noexcept
+    {
+        if (is_minified != this->m_is_mipmap_filter)
+        {
+            gl_state.bind_texture(texture_unit, GL_TEXTURE_2D_ARRAY, this->m_texture);
+            gl_state.count_calls();
+            glTexParameteri(GL_TEXTURE_2D_ARRAY,
+                            GL_TEXTURE_MIN_FILTER,
+                            is_minified ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+            this->m_is_mipmap_filter = is_minified;
+        }
+
+        if (!is_minified || !this->m_are_mipmaps_dirty)
+        {
+            return;
+        }
+
+        // Every layer is rebuilt, a wall of streams updates most of them each frame
+        gl_state.bind_texture(texture_unit, GL_TEXTURE_2D_ARRAY, this->m_texture);
+        gl_state.count_calls();
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+        this->m_are_mipmaps_dirty = false;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,279 @@
+///
+/// @file overlay.cpp
+/// @author Yasin BASAR
+/// @brief Implements the overlay instance builder and the glyph atlas.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "overlay.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @brief Public domain 8x8 font of ASCII 32 to 126, one byte per row
+    ///        from the top, the lowest bit is the leftmost pixel.
+    static const uint8_t glyph_rows[95][glyph_size] =
+    {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+        {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // !
+        {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // "
+        {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00}, // #
+        {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00}, // $
+        {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00}, // %
+        {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00}, // &
+        {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00}, // '
+        {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00}, // (
+        {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00}, // )
+        {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // *
+        {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00}, // +
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ,
+        {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00}, // -
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // .
+        {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00}, // /
+        {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00}, // 0
+        {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00}, // 1
+        {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00}, // 2
+        {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00}, // 3
+        {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00}, // 4
+        {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00}, // 5
+        {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00}, // 6
+        {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00}, // 7
+        {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00}, // 8
+        {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00}, // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // :
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06}, // ;
+        {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00}, // <
+        {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00}, // =
+        {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00}, // >
+        {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00}, // ?
+        {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00}, // @
+        {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00}, // A
+        {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00}, // B
+        {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00}, // C
+        {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00}, // D
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00}, // E
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00}, // F
+        {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00}, // G
+        {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00}, // H
+        {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // I
+        {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00}, // J
+        {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00}, // K
+        {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00}, // L
+        {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00}, // M
+        {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00}, // N
+        {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00}, // O
+        {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00}, // P
+        {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00}, // Q
+        {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00}, // R
+        {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00}, // S
+        {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // T
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00}, // U
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // V
+        {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00}, // W
+        {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00}, // X
+        {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00}, // Y
+        {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00}, // Z
+        {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00}, // [
+        {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00}, // backslash
+        {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00}, // ]
+        {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00}, // ^
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}, // _
+        {0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00}, // `
+        {0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00}, // a
+        {0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00}, // b
+        {0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00}, // c
+        {0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00}, // d
+        {0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00}, // e
+        {0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00}, // f
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // g
+        {0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00}, // h
+        {0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // i
+        {0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E}, // j
+        {0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00}, // k
+        {0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // l
+        {0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00}, // m
+        {0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00}, // n
+        {0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00}, // o
+        {0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F}, // p
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78}, // q
+        {0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00}, // r
+        {0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00}, // s
+        {0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00}, // t
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00}, // u
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // v
+        {0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00}, // w
+        {0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00}, // x
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F}, // y
+        {0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00}, // z
+        {0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00}, // {
+        {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00}, // |
+        {0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00}, // }
+        {0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}  // ~
+    };
+
+    /// @brief Atlas cell of the solid block behind text.
+    constexpr int solid_glyph = 127 - 32;
+
+    /// @brief Unpacks a 0xRRGGBBAA color.
+    static void unpack_color(uint32_t color, uint8_t* rgba) noexcept
+    {
+        rgba[0] = static_cast<uint8_t>(color >> 24);
+        rgba[1] = static_cast<uint8_t>(color >> 16);
+        rgba[2] = static_cast<uint8_t>(color >> 8);
+        rgba[3] = static_cast<uint8_t>(color);
+    }
+
+    /// @brief Appends one instance.
+    static void append_instance(std::vector<OverlayInstance>& instances,
+                                OverlayKind kind,
+                                float position_x0,
+                                float position_y0,
+                                float position_x1,
+                                float position_y1,
+                                float extent_x,
+                                float extent_y,
+                                float extent_z,
+                                uint32_t color)
+    {
+        OverlayInstance instance{{position_x0, position_y0, position_x1, position_y1},
+                                 {extent_x, extent_y, extent_z, static_cast<float>(kind)},
+                                 {0, 0, 0, 0}};
+        unpack_color(color, instance.color);
+
+        instances.push_back(instance);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    std::vector<uint8_t> make_glyph_atlas()
+    {
+        const int atlas_width = glyph_atlas_columns * glyph_size;
+        std::vector<uint8_t> atlas(static_cast<size_t>(atlas_width) * glyph_atlas_rows * glyph_size, 0);
+
+        for (int glyph = 0; glyph <= solid_glyph; ++glyph)
+        {
+            const int cell_x = (glyph % glyph_atlas_columns) * glyph_size;
+            const int cell_y = (glyph / glyph_atlas_columns) * glyph_size;
+
+            for (int row = 0; row < glyph_size; ++row)
+            {
+                const uint8_t bits = (solid_glyph == glyph) ? 0xFF : glyph_rows[glyph][row];
+                uint8_t* texel = atlas.data() + static_cast<size_t>(cell_y + row) * atlas_width + cell_x;
+
+                for (int column = 0; column < glyph_size; ++column)
+                {
+                    texel[column] = ((bits >> column) & 1) ? 255 : 0;
+                }
+            }
+        }
+
+        return atlas;
+    }
+
+    void append_overlay_instances(const Overlay& overlay,
+                                  std::vector<OverlayInstance>& instances)
+    {
+        for (int idx = 0; idx < overlay.box_count; ++idx)
+        {
+            const OverlayBox& box = overlay.boxes[idx];
+            const float right = box.x + box.width;
+            const float bottom = box.y + box.height;
+
+            if (box.thickness <= 0.0f)
+            {
+                append_instance(instances, OverlayKind::Rect, box.x, box.y, right, bottom, 0.0f, 0.0f, 0.0f, box.color);
+                continue;
+            }
+
+            // Line caps extend by half the thickness, so the corners close
+            append_instance(instances, OverlayKind::Line, box.x, box.y, right, box.y, box.thickness, 0.0f, 0.0f, box.color);
+            append_instance(instances, OverlayKind::Line, right, box.y, right, bottom, box.thickness, 0.0f, 0.0f, box.color);
+            append_instance(instances, OverlayKind::Line, right, bottom, box.x, bottom, box.thickness, 0.0f, 0.0f, box.color);
+            append_instance(instances, OverlayKind::Line, box.x, bottom, box.x, box.y, box.thickness, 0.0f, 0.0f, box.color);
+        }
+
+        for (int idx = 0; idx < overlay.line_count; ++idx)
+        {
+            const OverlayLine& line = overlay.lines[idx];
+            append_instance(instances, OverlayKind::Line, line.x0, line.y0, line.x1, line.y1, line.thickness, 0.0f, 0.0f, line.color);
+        }
+
+        for (int idx = 0; idx < overlay.point_count; ++idx)
+        {
+            const OverlayPoint& point = overlay.points[idx];
+            append_instance(instances, OverlayKind::Point, point.x, point.y, point.x, point.y, point.size, 0.0f, 0.0f, point.color);
+        }
+
+        for (int idx = 0; idx < overlay.text_count; ++idx)
+        {
+            const OverlayText& text = overlay.texts[idx];
+
+            if (!text.text)
+            {
+                continue;
+            }
+
+            const size_t length = std::strlen(text.text);
+
+            if (text.background_color != 0 && length != 0)
+            {
+                append_instance(instances,
+                                OverlayKind::Glyph,
+                                text.x,
+                                text.y,
+                                0.0f,
+                                0.0f,
+                                text.size * length,
+                                text.size,
+                                static_cast<float>(solid_glyph),
+                                text.background_color);
+            }
+
+            for (size_t character = 0; character < length; ++character)
+            {
+                const unsigned char code = static_cast<unsigned char>(text.text[character]);
+
+                if (' ' == code)
+                {
+                    continue;
+                }
+
+                const int glyph = (code > ' ' && code < 127) ? code - ' ' : '?' - ' ';
+
+                append_instance(instances,
+                                OverlayKind::Glyph,
+                                text.x,
+                                text.y,
+                                text.size * character,
+                                0.0f,
+                                text.size,
+                                text.size,
+                                static_cast<float>(glyph),
+                                text.color);
+            }
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,414 @@
+///
+/// @file pixel_format.cpp
+/// @author Yasin BASAR
+/// @brief Implements texture layouts of pixel formats.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "pixel_format.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    /// @brief Converts an IEEE 754 half precision value to float.
+    /// @param half[in] Half precision bits
+    /// @return Converted value
+    static float half_to_float(uint16_t half) noexcept
+    {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x3FFu;
+        uint32_t bits;
+
+        if (0 == exponent)
+        {
+            if (0 == mantissa)
+            {
+                bits = sign;
+            }
+            else
+            {
+                // Subnormal, normalize it
+                exponent = 127 - 15 + 1;
+                while (0 == (mantissa & 0x400u))
+                {
+                    mantissa <<= 1;
+                    --exponent;
+                }
+                bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+            }
+        }
+        else if (0x1F == exponent)
+        {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        }
+        else
+        {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    ImageLayout get_image_layout(PixelFormat format,
+                                 int frame_width,
+                                 int frame_height,
+                                 size_t row_pitch) noexcept
+    {
+        ImageLayout layout{};
+        layout.sampling_layout = SamplingLayout::Interleaved;
+        layout.value_scale = 1.0f;
+        layout.default_minimum = 0.0f;
+        layout.default_maximum = 1.0f;
+
+        const int chroma_width = (frame_width + 1) / 2;
+        const int chroma_height = (frame_height + 1) / 2;
+
+        switch (format)
+        {
+            case PixelFormat::RGBA:
+                layout.planes[0] = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, frame_width, frame_height, 4, 0, 0};
+                layout.plane_count = 1;
+            break;
+            case PixelFormat::BGRA:
+                layout.planes[0] = {GL_RGBA8, GL_BGRA, GL_UNSIGNED_BYTE, frame_width, frame_height, 4, 0, 0};
+                layout.plane_count = 1;
+            break;
+            case PixelFormat::RGB:
+                layout.planes[0] = {GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, frame_width, frame_height, 3, 0, 0};
+                layout.plane_count = 1;
+            break;
+            case PixelFormat::BGR:
+                layout.planes[0] = {GL_RGB8, GL_BGR, GL_UNSIGNED_BYTE, frame_width, frame_height, 3, 0, 0};
+                layout.plane_count = 1;
+            break;
+            case PixelFormat::Gray:
+                layout.planes[0] = {GL_R8, GL_RED, GL_UNSIGNED_BYTE, frame_width, frame_height, 1, 0, 0};
+                layout.plane_count = 1;
+                layout.sampling_layout = SamplingLayout::Scalar;
+                layout.value_scale = 1.0f / 255.0f;
+                layout.default_maximum = 255.0f;
+            break;
+            case PixelFormat::NV12:
+                layout.planes[0] = {GL_R8, GL_RED, GL_UNSIGNED_BYTE, frame_width, frame_height, 1, 0, 0};
+                layout.planes[1] = {GL_RG8, GL_RG, GL_UNSIGNED_BYTE, chroma_width, chroma_height, 2, 0, 0};
+                layout.plane_count = 2;
+                layout.sampling_layout = SamplingLayout::SemiPlanarYuv;
+            break;
+            case PixelFormat::I420:
+                layout.planes[0] = {GL_R8, GL_RED, GL_UNSIGNED_BYTE, frame_width, frame_height, 1, 0, 0};
+                layout.planes[1] = {GL_R8, GL_RED, GL_UNSIGNED_BYTE, chroma_width, chroma_height, 1, 0, 0};
+                layout.planes[2] = {GL_R8, GL_RED, GL_UNSIGNED_BYTE, chroma_width, chroma_height, 1, 0, 0};
+                layout.plane_count = 3;
+                layout.sampling_layout = SamplingLayout::PlanarYuv;
+            break;
+            case PixelFormat::YUYV:
+                if (frame_width % 2 != 0)
+                {
+                    // Pixel pairs can not be split, a row of an odd width
+                    // would end in the middle of a texel.
+                    break;
+                }
+
+                // Every texel holds a pixel pair, the shader picks the Y of
+                // the pixel it shades.
+                layout.planes[0] = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, chroma_width, frame_height, 4, 0, 0};
+                layout.plane_count = 1;
+                layout.sampling_layout = SamplingLayout::PackedYuyv;
+            break;
+            case PixelFormat::R16:
+                layout.planes[0] = {GL_R16, GL_RED, GL_UNSIGNED_SHORT, frame_width, frame_height, 2, 0, 0};
+                layout.plane_count = 1;
+                layout.sampling_layout = SamplingLayout::Scalar;
+                layout.value_scale = 1.0f / 65535.0f;
+                layout.default_maximum = 65535.0f;
+            break;
+            case PixelFormat::R16F:
+                layout.planes[0] = {GL_R16F, GL_RED, GL_HALF_FLOAT, frame_width, frame_height, 2, 0, 0};
+                layout.plane_count = 1;
+                layout.sampling_layout = SamplingLayout::Scalar;
+            break;
+            case PixelFormat::R32F:
+                layout.planes[0] = {GL_R32F, GL_RED, GL_FLOAT, frame_width, frame_height, 4, 0, 0};
+                layout.plane_count = 1;
+                layout.sampling_layout = SamplingLayout::Scalar;
+            break;
+            default:
+            break;
+        }
+
+        size_t offset = 0;
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            PlaneLayout& plane = layout.planes[idx];
+
+            const size_t row_size = static_cast<size_t>(plane.width)
+                                    * static_cast<size_t>(plane.bytes_per_texel);
+
+            if (0 == row_pitch)
+            {
+                plane.row_pitch = row_size;
+            }
+            else if (PixelFormat::I420 == format && idx > 0)
+            {
+                // U and V rows are half as long as Y rows, so are their
+                // pitches. Rounded up like the chroma width of odd frames.
+                plane.row_pitch = (row_pitch + 1) / 2;
+            }
+            else
+            {
+                // NV12 interleaves UV, its chroma rows are as long as Y rows
+                plane.row_pitch = row_pitch;
+            }
+
+            plane.offset = offset;
+            offset += plane.row_pitch * static_cast<size_t>(plane.height);
+
+            // Padding after the last row does not have to be in the buffer
+            if (plane.height > 0)
+            {
+                layout.frame_size = plane.offset
+                                    + plane.row_pitch * static_cast<size_t>(plane.height - 1)
+                                    + row_size;
+            }
+        }
+
+        return layout;
+    }
+
+    Rect get_plane_region(const PlaneLayout& plane,
+                          const Rect& region,
+                          int frame_width,
+                          int frame_height) noexcept
+    {
+        const int x_begin = region.x * plane.width / frame_width;
+        const int y_begin = region.y * plane.height / frame_height;
+        const int x_end = ((region.x + region.width) * plane.width + frame_width - 1) / frame_width;
+        const int y_end = ((region.y + region.height) * plane.height + frame_height - 1) / frame_height;
+
+        return {x_begin, y_begin, x_end - x_begin, y_end - y_begin};
+    }
+
+    bool get_view_layout(const FrameView& view, ImageLayout& layout) noexcept
+    {
+        Rect region = view.region;
+
+        if (region.width <= 0 || region.height <= 0)
+        {
+            region = {0, 0, view.buffer_width, view.buffer_height};
+        }
+
+        if (!view.data_ptr
+            || region.x < 0
+            || region.y < 0
+            || region.width <= 0
+            || region.height <= 0
+            || region.x + region.width > view.buffer_width
+            || region.y + region.height > view.buffer_height)
+        {
+            return false;
+        }
+
+        const ImageLayout buffer_layout = get_image_layout(view.format,
+                                                           view.buffer_width,
+                                                           view.buffer_height,
+                                                           view.row_pitch);
+
+        layout = get_image_layout(view.format, region.width, region.height);
+
+        if (0 == buffer_layout.plane_count || 0 == layout.plane_count)
+        {
+            return false;
+        }
+
+        layout.frame_size = 0;
+
+        for (int idx = 0; idx < buffer_layout.plane_count; ++idx)
+        {
+            const PlaneLayout& buffer_plane = buffer_layout.planes[idx];
+            PlaneLayout& plane = layout.planes[idx];
+
+            const size_t row_size = static_cast<size_t>(plane.width)
+                                    * static_cast<size_t>(plane.bytes_per_texel);
+
+            if (buffer_plane.row_pitch < static_cast<size_t>(buffer_plane.width)
+                                         * static_cast<size_t>(buffer_plane.bytes_per_texel))
+            {
+                return false;
+            }
+
+            // Subsampled planes hold one texel for 2 pixels, a region must
+            // not start in the middle of one.
+            const int subsampling_x = (buffer_plane.width < view.buffer_width) ? 2 : 1;
+            const int subsampling_y = (buffer_plane.height < view.buffer_height) ? 2 : 1;
+
+            if (region.x % subsampling_x != 0 || region.y % subsampling_y != 0)
+            {
+                return false;
+            }
+
+            plane.row_pitch = buffer_plane.row_pitch;
+            plane.offset = buffer_plane.offset
+                           + static_cast<size_t>(region.y / subsampling_y) * buffer_plane.row_pitch
+                           + static_cast<size_t>(region.x / subsampling_x) * buffer_plane.bytes_per_texel;
+
+            layout.frame_size = std::max(layout.frame_size,
+                                         plane.offset
+                                         + plane.row_pitch * static_cast<size_t>(plane.height - 1)
+                                         + row_size);
+        }
+
+        return true;
+    }
+
+    bool is_same_storage(const ImageLayout& lhs, const ImageLayout& rhs) noexcept
+    {
+        if (lhs.plane_count != rhs.plane_count)
+        {
+            return false;
+        }
+
+        for (int idx = 0; idx < lhs.plane_count; ++idx)
+        {
+            if (lhs.planes[idx].offset != rhs.planes[idx].offset
+                || lhs.planes[idx].row_pitch != rhs.planes[idx].row_pitch)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool get_unpack_row_length(const PlaneLayout& plane,
+                               int& row_length,
+                               int& alignment) noexcept
+    {
+        const size_t texel_size = static_cast<size_t>(plane.bytes_per_texel);
+        const size_t row_size = (plane.row_pitch / texel_size) * texel_size;
+
+        // OpenGL rounds a row of `row_length` texels up to the alignment,
+        // so pitches which are not a whole number of texels work as long
+        // as the padding is shorter than the alignment (e.g. 24 bit rows
+        // padded to 4 bytes).
+        for (const int candidate : {8, 4, 2, 1})
+        {
+            const size_t aligned_row_size = (row_size + candidate - 1) / candidate * candidate;
+
+            if (aligned_row_size == plane.row_pitch)
+            {
+                row_length = static_cast<int>(plane.row_pitch / texel_size);
+                alignment = candidate;
+                return true;
+            }
+        }
+
+        row_length = plane.width;
+        alignment = 1;
+        return false;
+    }
+
+    bool find_value_range(const uint8_t* data_ptr,
+                          PixelFormat format,
+                          int frame_width,
+                          int frame_height,
+                          size_t row_pitch,
+                          float& minimum,
+                          float& maximum) noexcept
+    {
+        constexpr int step = 4;
+
+        float (*read_value)(const uint8_t* data_ptr, size_t index) = nullptr;
+
+        switch (format)
+        {
+            case PixelFormat::Gray:
+                read_value = [](const uint8_t* ptr, size_t index)
+                {
+                    return static_cast<float>(ptr[index]);
+                };
+            break;
+            case PixelFormat::R16:
+                read_value = [](const uint8_t* ptr, size_t index)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, ptr + 2 * index, sizeof(value));
+                    return static_cast<float>(value);
+                };
+            break;
+            case PixelFormat::R16F:
+                read_value = [](const uint8_t* ptr, size_t index)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, ptr + 2 * index, sizeof(value));
+                    return half_to_float(value);
+                };
+            break;
+            case PixelFormat::R32F:
+                read_value = [](const uint8_t* ptr, size_t index)
+                {
+                    float value;
+                    std::memcpy(&value, ptr + 4 * index, sizeof(value));
+                    return value;
+                };
+            break;
+            default:
+                return false;
+        }
+
+        minimum = std::numeric_limits<float>::max();
+        maximum = std::numeric_limits<float>::lowest();
+
+        for (int y = 0; y < frame_height; y += step)
+        {
+            const uint8_t* row_ptr = data_ptr + static_cast<size_t>(y) * row_pitch;
+
+            for (int x = 0; x < frame_width; x += step)
+            {
+                const float value = read_value(row_ptr, x);
+
+                // NaN compares false and is skipped
+                if (value < minimum)
+                {
+                    minimum = value;
+                }
+                if (value > maximum)
+                {
+                    maximum = value;
+                }
+            }
+        }
+
+        return minimum <= maximum;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,644 @@
+///
+/// @file playback_source.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `PlaybackSource` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "playback_source.hpp"
+#include "pixel_format.hpp"
+
+#ifdef _WIN32
+// Keeps std::min and std::max usable after the Windows headers
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    class PlaybackSource::Impl
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        Impl(Impl &&) noexcept = delete;
+        Impl &operator=(Impl &&) noexcept = delete;
+        Impl(const Impl &) noexcept = delete;
+        Impl &operator=(Impl const &) noexcept = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        explicit Impl(const char* file_path)
+        {
+            this->map_file(file_path);
+
+            try
+            {
+                this->parse_y4m_header();
+            }
+            catch (...)
+            {
+                this->unmap_file();
+                throw;
+            }
+        }
+
+        Impl(const char* file_path, const RawFileLayout& layout)
+        {
+            if (layout.frame_width <= 0
+                || layout.frame_height <= 0
+                || 0 == get_image_layout(layout.format, layout.frame_width, layout.frame_height).plane_count)
+            {
+                throw std::runtime_error("Invalid raw frame size");
+            }
+
+            this->map_file(file_path);
+
+            this->m_first_frame_offset = layout.file_header_size;
+            this->m_frame_header_size = layout.frame_header_size;
+            this->m_has_timestamps = layout.frame_header_size >= 8;
+            this->m_frame_duration = layout.frame_rate > 0.0 ? 1.0 / layout.frame_rate : 0.0;
+            this->set_frame_layout(layout.frame_width, layout.frame_height, layout.format);
+        }
+
+        ~Impl() noexcept
+        {
+            this->unmap_file();
+        }
+
+        int get_frame_width() const noexcept
+        {
+            return this->m_frame_width;
+        }
+
+        int get_frame_height() const noexcept
+        {
+            return this->m_frame_height;
+        }
+
+        PixelFormat get_format() const noexcept
+        {
+            return this->m_format;
+        }
+
+        size_t get_frame_count() const noexcept
+        {
+            return this->m_frame_count;
+        }
+
+        double get_timestamp(size_t frame_index) const noexcept
+        {
+            if (frame_index >= this->m_frame_count)
+            {
+                return 0.0;
+            }
+
+            if (!this->m_has_timestamps)
+            {
+                return static_cast<double>(frame_index) * this->m_frame_duration;
+            }
+
+            // Capture clocks can step back, a frame recorded before the
+            // first one is shown at the start instead of wrapping around.
+            const int64_t microseconds = static_cast<int64_t>(this->read_microseconds(frame_index)
+                                                              - this->read_microseconds(0));
+
+            return static_cast<double>(std::max<int64_t>(microseconds, 0)) * 1e-6;
+        }
+
+        const uint8_t* get_frame(size_t frame_index) noexcept
+        {
+            if (frame_index >= this->m_frame_count)
+            {
+                return nullptr;
+            }
+
+            const size_t header_offset = this->get_header_offset(frame_index);
+
+            // Frame headers of Y4M files are assumed to be uniform
+            if (this->m_is_y4m && 0 != std::memcmp(this->m_data + header_offset, "FRAME", 5))
+            {
+                return nullptr;
+            }
+
+            // The pages of the next frames are read while this one is shown
+            const size_t read_ahead_end = std::min(frame_index + 1 + m_read_ahead_frame_count,
+                                                   this->m_frame_count);
+
+            if (read_ahead_end > frame_index + 1)
+            {
+                const size_t begin = this->get_header_offset(frame_index + 1);
+                this->advise(begin,
+                             this->get_header_offset(read_ahead_end - 1) + this->m_frame_stride - begin,
+                             true);
+            }
+
+            // Played frames only cost address space. The uploader can still
+            // read the previous frame, so the one before it is dropped.
+            if (frame_index >= 2 && frame_index == this->m_last_frame_index + 1)
+            {
+                this->advise(this->get_header_offset(frame_index - 2), this->m_frame_stride, false);
+            }
+
+            this->m_last_frame_index = frame_index;
+
+            return this->m_data + header_offset + this->m_frame_header_size;
+        }
+
+        void seek(size_t frame_index) noexcept
+        {
+            this->m_next_frame_index = std::min(frame_index, this->m_frame_count);
+            this->m_is_pacing_started = false;
+        }
+
+        void set_speed(double speed) noexcept
+        {
+            if (speed > 0.0)
+            {
+                this->m_speed = speed;
+                this->m_is_pacing_started = false;
+            }
+        }
+
+        const uint8_t* next_frame() noexcept
+        {
+            if (this->m_next_frame_index >= this->m_frame_count)
+            {
+                return nullptr;
+            }
+
+            const double timestamp = this->get_timestamp(this->m_next_frame_index);
+            const clock::time_point now = clock::now();
+
+            if (this->m_is_pacing_started)
+            {
+                const clock::time_point present_time = this->get_present_time(timestamp);
+
+                if (now > present_time + m_max_lag)
+                {
+                    // Stalled, e.g. by a debugger, continue from here
+                    this->m_is_pacing_started = false;
+                }
+                else
+                {
+                    std::this_thread::sleep_until(present_time);
+                }
+            }
+
+            if (!this->m_is_pacing_started)
+            {
+                this->m_pacing_start = now;
+                this->m_pacing_origin = timestamp;
+                this->m_is_pacing_started = true;
+            }
+
+            return this->get_frame(this->m_next_frame_index++);
+        }
+
+        void play(const WindowCreator& window, volatile bool& t_exit_status) noexcept
+        {
+            while (!t_exit_status)
+            {
+                const uint8_t* frame = this->next_frame();
+
+                if (!frame)
+                {
+                    break;
+                }
+
+                window.image_show(frame,
+                                  this->m_frame_width,
+                                  this->m_frame_height,
+                                  this->m_format,
+                                  t_exit_status);
+            }
+        }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        using clock = std::chrono::steady_clock;
+
+        void map_file(const char* file_path)
+        {
+#ifdef _WIN32
+            this->m_file = CreateFileA(file_path,
+                                       GENERIC_READ,
+                                       FILE_SHARE_READ,
+                                       nullptr,
+                                       OPEN_EXISTING,
+                                       FILE_FLAG_SEQUENTIAL_SCAN,
+                                       nullptr);
+
+            LARGE_INTEGER file_size{};
+
+            if (INVALID_HANDLE_VALUE == this->m_file
+                || !GetFileSizeEx(this->m_file, &file_size)
+                || 0 == file_size.QuadPart)
+            {
+                this->unmap_file();
+                throw std::runtime_error("Could not open playback file");
+            }
+
+            this->m_file_size = static_cast<size_t>(file_size.QuadPart);
+            this->m_mapping = CreateFileMappingA(this->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (this->m_mapping)
+            {
+                this->m_data = static_cast<const uint8_t*>(
+                    MapViewOfFile(this->m_mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+#else
+            this->m_file = open(file_path, O_RDONLY);
+
+            struct stat file_status{};
+
+            if (this->m_file < 0
+                || 0 != fstat(this->m_file, &file_status)
+                || 0 == file_status.st_size)
+            {
+                this->unmap_file();
+                throw std::runtime_error("Could not open playback file");
+            }
+
+            this->m_file_size = static_cast<size_t>(file_status.st_size);
+
+            void* data = mmap(nullptr, this->m_file_size, PROT_READ, MAP_SHARED, this->m_file, 0);
+
+            if (MAP_FAILED != data)
+            {
+                this->m_data = static_cast<const uint8_t*>(data);
+
+                // Doubles the kernel's read-ahead window for the whole file
+                madvise(data, this->m_file_size, MADV_SEQUENTIAL);
+            }
+#endif
+
+            if (!this->m_data)
+            {
+                this->unmap_file();
+                throw std::runtime_error("Could not map playback file");
+            }
+        }
+
+        void unmap_file() noexcept
+        {
+#ifdef _WIN32
+            if (this->m_data)
+            {
+                UnmapViewOfFile(this->m_data);
+            }
+
+            if (this->m_mapping)
+            {
+                CloseHandle(this->m_mapping);
+            }
+
+            if (INVALID_HANDLE_VALUE != this->m_file)
+            {
+                CloseHandle(this->m_file);
+            }
+
+            this->m_mapping = nullptr;
+            this->m_file = INVALID_HANDLE_VALUE;
+#else
+            if (this->m_data)
+            {
+                munmap(const_cast<uint8_t*>(this->m_data), this->m_file_size);
+            }
+
+            if (this->m_file >= 0)
+            {
+                close(this->m_file);
+            }
+
+            this->m_file = -1;
+#endif
+            this->m_data = nullptr;
+        }
+
+        void parse_y4m_header()
+        {
+            const char* header = reinterpret_cast<const char*>(this->m_data);
+            const size_t search_size = std::min<size_t>(this->m_file_size, 4096);
+            const void* header_end = std::memchr(header, '\n', search_size);
+
+            if (!header_end || 0 != std::strncmp(header, "YUV4MPEG2 ", 10))
+            {
+                throw std::runtime_error("Not a YUV4MPEG2 file");
+            }
+
+            const std::string header_line(header, static_cast<const char*>(header_end));
+
+            int frame_width = 0;
+            int frame_height = 0;
+            double frame_rate = 25.0;
+            std::string colorspace = "420jpeg";
+
+            size_t position = 10;
+
+            while (position < header_line.size())
+            {
+                size_t token_end = header_line.find(' ', position);
+                token_end = (std::string::npos == token_end) ? header_line.size() : token_end;
+
+                const std::string token = header_line.substr(position, token_end - position);
+
+                if (token.size() > 1)
+                {
+                    const char* value = token.c_str() + 1;
+
+                    switch (token[0])
+                    {
+                        case 'W':
+                            frame_width = std::atoi(value);
+                        break;
+                        case 'H':
+                            frame_height = std::atoi(value);
+                        break;
+                        case 'F':
+                        {
+                            const char* separator = std::strchr(value, ':');
+                            const double denominator = separator ? std::atof(separator + 1) : 0.0;
+
+                            if (denominator > 0.0)
+                            {
+                                frame_rate = std::atof(value) / denominator;
+                            }
+                        }
+                        break;
+                        case 'C':
+                            colorspace = value;
+                        break;
+                        default:
+                            break;
+                    }
+                }
+
+                position = token_end + 1;
+            }
+
+            PixelFormat format = PixelFormat::I420;
+
+            // Only 8 bit samples, colorspaces with a `p<depth>` suffix such
+            // as 420p10 store 2 bytes per sample.
+            if ("mono" == colorspace)
+            {
+                format = PixelFormat::Gray;
+            }
+            else if ("420" != colorspace
+                     && "420jpeg" != colorspace
+                     && "420paldv" != colorspace
+                     && "420mpeg2" != colorspace)
+            {
+                throw std::runtime_error("Unsupported Y4M colorspace " + colorspace);
+            }
+
+            if (frame_width <= 0
+                || frame_height <= 0
+                || 0 == get_image_layout(format, frame_width, frame_height).plane_count)
+            {
+                throw std::runtime_error("Y4M header has no valid frame size");
+            }
+
+            // The first frame header gives the header size of every frame
+            this->m_first_frame_offset = header_line.size() + 1;
+
+            const size_t remaining_size = this->m_file_size - std::min(this->m_first_frame_offset,
+                                                                      this->m_file_size);
+            const void* frame_header_end = std::memchr(header + this->m_first_frame_offset,
+                                                       '\n',
+                                                       std::min<size_t>(remaining_size, 256));
+
+            if (!frame_header_end && remaining_size > 0)
+            {
+                throw std::runtime_error("Y4M frame header is missing");
+            }
+
+            this->m_frame_header_size = frame_header_end
+                ? static_cast<size_t>(static_cast<const char*>(frame_header_end)
+                                      - (header + this->m_first_frame_offset)) + 1
+                : 0;
+
+            this->m_is_y4m = true;
+            this->m_frame_duration = 1.0 / frame_rate;
+            this->set_frame_layout(frame_width, frame_height, format);
+        }
+
+        void set_frame_layout(int frame_width, int frame_height, PixelFormat format) noexcept
+        {
+            this->m_frame_width = frame_width;
+            this->m_frame_height = frame_height;
+            this->m_format = format;
+            this->m_frame_size = get_image_layout(format, frame_width, frame_height).frame_size;
+            this->m_frame_stride = this->m_frame_header_size + this->m_frame_size;
+
+            this->m_frame_count = (this->m_first_frame_offset < this->m_file_size)
+                                  ? (this->m_file_size - this->m_first_frame_offset) / this->m_frame_stride
+                                  : 0;
+        }
+
+        size_t get_header_offset(size_t frame_index) const noexcept
+        {
+            return this->m_first_frame_offset + frame_index * this->m_frame_stride;
+        }
+
+        uint64_t read_microseconds(size_t frame_index) const noexcept
+        {
+            const uint8_t* header = this->m_data + this->get_header_offset(frame_index);
+            uint64_t microseconds = 0;
+
+            for (int idx = 7; idx >= 0; --idx)
+            {
+                microseconds = (microseconds << 8) | header[idx];
+            }
+
+            return microseconds;
+        }
+
+        clock::time_point get_present_time(double timestamp) const noexcept
+        {
+            const std::chrono::duration<double> delay((timestamp - this->m_pacing_origin) / this->m_speed);
+
+            return this->m_pacing_start + std::chrono::duration_cast<clock::duration>(delay);
+        }
+
+        void advise(size_t offset, size_t size, bool will_need) const noexcept
+        {
+            // Advice works on whole pages
+            static const size_t page_size = get_page_size();
+
+            const size_t begin = offset - offset % page_size;
+            const size_t end = std::min(offset + size, this->m_file_size);
+
+            if (end <= begin)
+            {
+                return;
+            }
+
+#ifdef _WIN32
+#if defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0602)
+            if (will_need)
+            {
+                WIN32_MEMORY_RANGE_ENTRY range{const_cast<uint8_t*>(this->m_data + begin), end - begin};
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+            }
+#else
+            (void)will_need;
+#endif
+#else
+            madvise(const_cast<uint8_t*>(this->m_data + begin),
+                    end - begin,
+                    will_need ? MADV_WILLNEED : MADV_DONTNEED);
+#endif
+        }
+
+        static size_t get_page_size() noexcept
+        {
+#ifdef _WIN32
+            SYSTEM_INFO system_info{};
+            GetSystemInfo(&system_info);
+            return system_info.dwAllocationGranularity;
+#else
+            return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        }
+
+        static constexpr size_t m_read_ahead_frame_count = 4; ///< Frames read ahead of the current one.
+        static constexpr std::chrono::seconds m_max_lag{1}; ///< Delay after which pacing restarts.
+
+#ifdef _WIN32
+        HANDLE m_file{INVALID_HANDLE_VALUE}; ///< Mapped file.
+        HANDLE m_mapping{nullptr}; ///< File mapping object.
+#else
+        int m_file{-1}; ///< Mapped file descriptor.
+#endif
+        const uint8_t* m_data{nullptr}; ///< Start of the mapping.
+        size_t m_file_size{0}; ///< Size of the file and the mapping.
+        bool m_is_y4m{false}; ///< Set when frames start with a Y4M frame header.
+        int m_frame_width{0}; ///< Image Width
+        int m_frame_height{0}; ///< Image Height
+        PixelFormat m_format{PixelFormat::RGBA}; ///< Memory layout of the frames.
+        size_t m_first_frame_offset{0}; ///< Offset of the first frame header.
+        size_t m_frame_header_size{0}; ///< Bytes before every frame.
+        size_t m_frame_size{0}; ///< Bytes of a frame without its header.
+        size_t m_frame_stride{0}; ///< Bytes from one frame header to the next.
+        size_t m_frame_count{0}; ///< Number of complete frames.
+        bool m_has_timestamps{false}; ///< Set when frame headers hold capture times.
+        double m_frame_duration{0.0}; ///< Seconds per frame without timestamps.
+        size_t m_last_frame_index{0}; ///< Frame returned by the last `get_frame`.
+        size_t m_next_frame_index{0}; ///< Frame `next_frame` returns next.
+        double m_speed{1.0}; ///< Playback speed factor.
+        bool m_is_pacing_started{false}; ///< Set once `m_pacing_start` is valid.
+        clock::time_point m_pacing_start{}; ///< Time the pacing origin frame was returned.
+        double m_pacing_origin{0.0}; ///< Timestamp of the pacing origin frame.
+
+    }; // class PlaybackSource::Impl
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    PlaybackSource::PlaybackSource(const char* file_path)
+    {
+        this->p_impl = std::make_unique<Impl>(file_path);
+    }
+
+    PlaybackSource::PlaybackSource(const char* file_path, const RawFileLayout& layout)
+    {
+        this->p_impl = std::make_unique<Impl>(file_path, layout);
+    }
+
+    PlaybackSource::~PlaybackSource() noexcept = default;
+
+    int PlaybackSource::get_frame_width() const noexcept
+    {
+        return this->p_impl->get_frame_width();
+    }
+
+    int PlaybackSource::get_frame_height() const noexcept
+    {
+        return this->p_impl->get_frame_height();
+    }
+
+    PixelFormat PlaybackSource::get_format() const noexcept
+    {
+        return this->p_impl->get_format();
+    }
+
+    size_t PlaybackSource::get_frame_count() const noexcept
+    {
+        return this->p_impl->get_frame_count();
+    }
+
+    double PlaybackSource::get_timestamp(size_t frame_index) const noexcept
+    {
+        return this->p_impl->get_timestamp(frame_index);
+    }
+
+    const uint8_t* PlaybackSource::get_frame(size_t frame_index) noexcept
+    {
+        return this->p_impl->get_frame(frame_index);
+    }
+
+    void PlaybackSource::seek(size_t frame_index) noexcept
+    {
+        this->p_impl->seek(frame_index);
+    }
+
+    void PlaybackSource::set_speed(double speed) noexcept
+    {
+        this->p_impl->set_speed(speed);
+    }
+
+    const uint8_t* PlaybackSource::next_frame() noexcept
+    {
+        return this->p_impl->next_frame();
+    }
+
+    void PlaybackSource::play(const WindowCreator& window, volatile bool& exit_status) noexcept
+    {
+        this->p_impl->play(window, exit_status);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
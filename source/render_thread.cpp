@@ -0,0 +1,223 @@
+///
+/// @file render_thread.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `RenderThread` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include "render_thread.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    RenderThread::RenderThread(IWindowProperties& window_properties,
+                               PresentPolicy policy) :
+        m_window_properties{window_properties},
+        m_policy{policy},
+        m_is_running{true},
+        m_dropped_frame_count{0},
+        m_mailbox_frame{},
+        m_has_mailbox_frame{false},
+        m_is_refresh_requested{false}
+    {
+        // A context can only be current on one thread at a time
+        this->m_window_properties.release_context();
+
+        // Resizes and setting changes arrive while the thread sleeps
+        this->m_window_properties.set_redraw_listener(&RenderThread::request_refresh, this);
+
+        this->m_thread = std::thread(&RenderThread::run, this);
+    }
+
+    RenderThread::~RenderThread() noexcept
+    {
+        this->m_window_properties.set_redraw_listener(nullptr, nullptr);
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_wake_mutex);
+            this->m_is_running.store(false, std::memory_order_release);
+        }
+
+        this->m_wake_condition.notify_one();
+
+        if (this->m_thread.joinable())
+        {
+            this->m_thread.join();
+        }
+
+        FrameSlot frame{};
+        while (this->take_frame(frame))
+        {
+            release(frame);
+        }
+    }
+
+    bool RenderThread::submit(const uint8_t* data_ptr,
+                              int frame_width,
+                              int frame_height,
+                              PixelFormat format,
+                              FrameReleaseCallback release_callback,
+                              void* user_data) noexcept
+    {
+        const FrameSlot frame{data_ptr,
+                              frame_width,
+                              frame_height,
+                              format,
+                              release_callback,
+                              user_data};
+
+        if (PresentPolicy::Mailbox == this->m_policy)
+        {
+            // Producer is never throttled in mailbox mode, the oldest pending
+            // frame is the one the display will never show.
+            FrameSlot replaced_frame{};
+            bool is_replaced = false;
+
+            {
+                std::lock_guard<std::mutex> lock(this->m_wake_mutex);
+
+                replaced_frame = this->m_mailbox_frame;
+                is_replaced = this->m_has_mailbox_frame;
+                this->m_mailbox_frame = frame;
+                this->m_has_mailbox_frame = true;
+            }
+
+            this->m_wake_condition.notify_one();
+
+            if (is_replaced)
+            {
+                release(replaced_frame);
+                this->m_dropped_frame_count.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            return true;
+        }
+
+        if (!this->m_queue.push(frame))
+        {
+            return false;
+        }
+
+        {
+            // Pushes are lock-free. Taking the mutex orders the push after
+            // the render thread's empty check, so the notification is not lost.
+            std::lock_guard<std::mutex> lock(this->m_wake_mutex);
+        }
+
+        this->m_wake_condition.notify_one();
+
+        return true;
+    }
+
+    uint64_t RenderThread::get_dropped_frame_count() const noexcept
+    {
+        return this->m_dropped_frame_count.load(std::memory_order_relaxed);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void RenderThread::run() noexcept
+    {
+        this->m_window_properties.make_context_current();
+
+        FrameSlot frame{};
+
+        while (this->m_is_running.load(std::memory_order_acquire))
+        {
+            if (!this->take_frame(frame))
+            {
+                // Resizes and setting changes are drawn without a new frame
+                this->m_window_properties.refresh();
+
+                std::unique_lock<std::mutex> lock(this->m_wake_mutex);
+                this->m_wake_condition.wait(lock, [this] { return this->is_awake(); });
+                this->m_is_refresh_requested = false;
+                continue;
+            }
+
+            this->m_window_properties.render_frame(frame.data_ptr,
+                                                   frame.frame_width,
+                                                   frame.frame_height,
+                                                   frame.format);
+
+            release(frame);
+        }
+
+        this->m_window_properties.release_context();
+    }
+
+    bool RenderThread::take_frame(FrameSlot& frame) noexcept
+    {
+        if (PresentPolicy::Fifo == this->m_policy)
+        {
+            return this->m_queue.pop(frame);
+        }
+
+        std::lock_guard<std::mutex> lock(this->m_wake_mutex);
+
+        if (!this->m_has_mailbox_frame)
+        {
+            return false;
+        }
+
+        frame = this->m_mailbox_frame;
+        this->m_has_mailbox_frame = false;
+
+        return true;
+    }
+
+    bool RenderThread::is_awake() const noexcept
+    {
+        if (!this->m_is_running.load(std::memory_order_acquire) || this->m_is_refresh_requested)
+        {
+            return true;
+        }
+
+        return PresentPolicy::Fifo == this->m_policy
+            ? !this->m_queue.is_empty()
+            : this->m_has_mailbox_frame;
+    }
+
+    void RenderThread::request_refresh(void* user_data) noexcept
+    {
+        RenderThread* instance = static_cast<RenderThread*>(user_data);
+
+        {
+            std::lock_guard<std::mutex> lock(instance->m_wake_mutex);
+            instance->m_is_refresh_requested = true;
+        }
+
+        instance->m_wake_condition.notify_one();
+    }
+
+    void RenderThread::release(const FrameSlot& frame) noexcept
+    {
+        if (frame.release_callback)
+        {
+            frame.release_callback(frame.data_ptr, frame.user_data);
+        }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,315 @@
+///
+/// @file tile_cache.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `TileCache` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include "tile_cache.hpp"
+#include "gl_extensions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    TileCache::TileCache() noexcept :
+        m_source{},
+        m_tile_layout{},
+        m_capacity{0},
+        m_tiles{},
+        m_index{},
+        m_staging{}
+    {
+    }
+
+    bool TileCache::configure(const TileSource& source, size_t memory_budget)
+    {
+        this->release();
+
+        if (!source.read_tile)
+        {
+            return true;
+        }
+
+        GLint max_texture_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+        if (source.width <= 0
+            || source.height <= 0
+            || source.tile_size <= 0
+            || source.tile_size > max_texture_size
+            || source.level_count <= 0
+            || source.level_count > 32)
+        {
+            return false;
+        }
+
+        const ImageLayout layout = get_image_layout(source.format,
+                                                    source.tile_size,
+                                                    source.tile_size);
+
+        // Tiles are drawn one texture at a time
+        if (1 != layout.plane_count
+            || SamplingLayout::PackedYuyv == layout.sampling_layout)
+        {
+            return false;
+        }
+
+        this->m_source = source;
+        this->m_tile_layout = layout;
+        this->m_capacity = std::max<size_t>(1, memory_budget / layout.frame_size);
+        this->m_staging.resize(layout.frame_size);
+
+        return true;
+    }
+
+    void TileCache::release() noexcept
+    {
+        for (const Tile& tile : this->m_tiles)
+        {
+            glDeleteTextures(1, &tile.texture);
+        }
+
+        this->m_tiles.clear();
+        this->m_index.clear();
+        this->m_staging = std::vector<uint8_t>{};
+        this->m_source = TileSource{};
+        this->m_capacity = 0;
+    }
+
+    bool TileCache::is_enabled() const noexcept
+    {
+        return nullptr != this->m_source.read_tile;
+    }
+
+    const TileSource& TileCache::get_source() const noexcept
+    {
+        return this->m_source;
+    }
+
+    const ImageLayout& TileCache::get_tile_layout() const noexcept
+    {
+        return this->m_tile_layout;
+    }
+
+    GLuint TileCache::find(int level, int tile_x, int tile_y, uint64_t frame_index) noexcept
+    {
+        const auto found = this->m_index.find(make_key(level, tile_x, tile_y));
+
+        if (this->m_index.end() == found)
+        {
+            return 0;
+        }
+
+        // Most recently used tiles are kept at the front
+        this->m_tiles.splice(this->m_tiles.begin(), this->m_tiles, found->second);
+        found->second->frame_index = frame_index;
+
+        return found->second->texture;
+    }
+
+    GLuint TileCache::load(int level,
+                           int tile_x,
+                           int tile_y,
+                           uint64_t frame_index,
+                           GLStateCache& gl_state)
+    {
+        GLuint texture = 0;
+
+        if (this->m_tiles.size() < this->m_capacity)
+        {
+            texture = this->create_tile_texture(gl_state);
+            this->m_tiles.push_front(Tile{m_free_key, texture, 0});
+        }
+        else
+        {
+            if (this->m_tiles.empty())
+            {
+                return 0;
+            }
+
+            const Tile& oldest = this->m_tiles.back();
+            const bool is_free = m_free_key == oldest.key;
+
+            // Evicting a tile of this frame would leave a hole in it,
+            // free slots are reused whatever frame they were left in.
+            if (!is_free && oldest.frame_index == frame_index)
+            {
+                return 0;
+            }
+
+            if (!is_free)
+            {
+                this->m_index.erase(oldest.key);
+            }
+
+            this->m_tiles.splice(this->m_tiles.begin(), this->m_tiles, std::prev(this->m_tiles.end()));
+            texture = this->m_tiles.front().texture;
+        }
+
+        // The front slot does not hold a valid tile until the upload
+        Tile& tile = this->m_tiles.front();
+        tile.key = make_key(level, tile_x, tile_y);
+        tile.frame_index = 0;
+
+        std::memset(this->m_staging.data(), 0, this->m_staging.size());
+
+        if (!this->m_source.read_tile(level,
+                                      tile_x,
+                                      tile_y,
+                                      this->m_staging.data(),
+                                      this->m_source.user_data))
+        {
+            // Keep the texture for the next tile
+            tile.key = m_free_key;
+            this->m_tiles.splice(this->m_tiles.end(), this->m_tiles, this->m_tiles.begin());
+            return 0;
+        }
+
+        const int tile_size = this->m_source.tile_size;
+        const int valid_width = std::min(tile_size, get_level_size(this->m_source.width, level) - tile_x * tile_size);
+        const int valid_height = std::min(tile_size, get_level_size(this->m_source.height, level) - tile_y * tile_size);
+
+        this->replicate_tile_edges(valid_width, valid_height);
+
+        const PlaneLayout& plane = this->m_tile_layout.planes[0];
+        const int row_size = plane.width * plane.bytes_per_texel;
+
+        gl_state.bind_pixel_unpack_buffer(0);
+        gl_state.set_unpack_parameter(GL_UNPACK_ALIGNMENT, (row_size % 4 == 0) ? 4 : 1);
+        gl_state.set_unpack_parameter(GL_UNPACK_ROW_LENGTH, 0);
+        gl_state.set_unpack_parameter(GL_UNPACK_SKIP_PIXELS, 0);
+        gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, 0);
+        gl_state.bind_texture(0, GL_TEXTURE_2D, texture);
+        gl_state.count_calls();
+
+        glTexSubImage2D(GL_TEXTURE_2D,
+                        0,
+                        0,
+                        0,
+                        plane.width,
+                        plane.height,
+                        plane.upload_format,
+                        plane.upload_type,
+                        this->m_staging.data());
+
+        tile.frame_index = frame_index;
+        this->m_index[tile.key] = this->m_tiles.begin();
+
+        return texture;
+    }
+
+    size_t TileCache::get_tile_count() const noexcept
+    {
+        return this->m_index.size();
+    }
+
+    int TileCache::get_level_size(int size, int level) noexcept
+    {
+        return static_cast<int>((static_cast<int64_t>(size) + (int64_t{1} << level) - 1) >> level);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    uint64_t TileCache::make_key(int level, int tile_x, int tile_y) noexcept
+    {
+        return (static_cast<uint64_t>(level) << 56)
+               | (static_cast<uint64_t>(static_cast<uint32_t>(tile_y) & 0x0FFFFFFFu) << 28)
+               | (static_cast<uint64_t>(static_cast<uint32_t>(tile_x) & 0x0FFFFFFFu));
+    }
+
+    void TileCache::replicate_tile_edges(int valid_width, int valid_height) noexcept
+    {
+        const PlaneLayout& plane = this->m_tile_layout.planes[0];
+        const size_t texel_size = static_cast<size_t>(plane.bytes_per_texel);
+        uint8_t* const tile_ptr = this->m_staging.data();
+
+        if (valid_width <= 0 || valid_height <= 0)
+        {
+            return;
+        }
+
+        // One texel is enough, the quad never samples further than half a
+        // texel past the last valid one.
+        if (valid_width < plane.width)
+        {
+            for (int row = 0; row < valid_height; ++row)
+            {
+                uint8_t* last_texel = tile_ptr + row * plane.row_pitch + (valid_width - 1) * texel_size;
+                std::memcpy(last_texel + texel_size, last_texel, texel_size);
+            }
+        }
+
+        if (valid_height < plane.height)
+        {
+            const size_t copy_size = std::min(valid_width + 1, plane.width) * texel_size;
+            const uint8_t* last_row = tile_ptr + (valid_height - 1) * plane.row_pitch;
+            std::memcpy(tile_ptr + valid_height * plane.row_pitch, last_row, copy_size);
+        }
+    }
+
+    GLuint TileCache::create_tile_texture(GLStateCache& gl_state) const noexcept
+    {
+        const PlaneLayout& plane = this->m_tile_layout.planes[0];
+        GLuint texture = 0;
+
+        // Storage is specified from client memory
+        gl_state.bind_pixel_unpack_buffer(0);
+
+        glGenTextures(1, &texture);
+        gl_state.bind_texture(0, GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        // Coarser levels of the pyramid take the place of mipmaps
+        if (GLExtensions::tex_storage_2d)
+        {
+            GLExtensions::tex_storage_2d(GL_TEXTURE_2D,
+                                         1,
+                                         plane.internal_format,
+                                         plane.width,
+                                         plane.height);
+        }
+        else
+        {
+            glTexImage2D(GL_TEXTURE_2D,
+                         0,
+                         plane.internal_format,
+                         plane.width,
+                         plane.height,
+                         0,
+                         plane.upload_format,
+                         plane.upload_type,
+                         nullptr);
+        }
+
+        return texture;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -13,6 +13,8 @@
 
 #include "window_properties.hpp"
 #include "window_creator.hpp"
+#include "render_thread.hpp"
+#include "compressed_format.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Third Party Includes
@@ -27,7 +29,11 @@ namespace YB
     // Special Members
     ////////////////////////////////////////////////////////////////////////////
 
-        ~Impl() noexcept = default;
+        ~Impl() noexcept
+        {
+            // Render thread must stop before the window is destroyed
+            this->m_render_thread.reset();
+        }
         Impl(Impl &&) noexcept = default;
         Impl &operator=(Impl &&) noexcept = default;
         Impl(const Impl &) noexcept = delete;
@@ -40,32 +46,376 @@ namespace YB
         Impl(const char *window_name,
              int window_width,
              int window_height,
-             bool cap_to_screen_frame_rate)
+             bool cap_to_screen_frame_rate,
+             UploadMode upload_mode,
+             SurfaceMode surface_mode)
         {
             this->m_window_properties
                 = std::make_unique<WindowProperties>(window_name,
                                                      window_width,
                                                      window_height,
-                                                     cap_to_screen_frame_rate);
+                                                     cap_to_screen_frame_rate,
+                                                     upload_mode,
+                                                     surface_mode);
         }
 
-        void image_show(uint8_t * data_ptr,
+        void image_show(const uint8_t * data_ptr,
                         int frame_width,
                         int frame_height,
+                        PixelFormat format,
                         volatile bool& t_exit_status) const noexcept
         {
+            // The render thread owns the context, frames go to `submit_frame`
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
             this->m_window_properties->image_show(data_ptr,
                                                 frame_width,
                                                 frame_height,
+                                                format,
                                                 t_exit_status);
         }
 
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        PixelFormat format,
+                        const Rect* dirty_regions,
+                        int region_count,
+                        volatile bool& t_exit_status) const noexcept
+        {
+            // The render thread owns the context, frames go to `submit_frame`
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
+            this->m_window_properties->image_show_regions(data_ptr,
+                                                          frame_width,
+                                                          frame_height,
+                                                          format,
+                                                          dirty_regions,
+                                                          region_count,
+                                                          t_exit_status);
+        }
+
+        bool image_show(const FrameView& view, volatile bool& t_exit_status) const noexcept
+        {
+            // The render thread owns the context, frames go to `submit_frame`
+            if (this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_window_properties->image_show_view(view, t_exit_status);
+        }
+
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        PixelFormat format,
+                        uint64_t generation,
+                        volatile bool& t_exit_status) const noexcept
+        {
+            // The render thread owns the context, frames go to `submit_frame`
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
+            this->m_window_properties->image_show_generation(data_ptr,
+                                                             frame_width,
+                                                             frame_height,
+                                                             format,
+                                                             generation,
+                                                             t_exit_status);
+        }
+
+        void image_show(const uint8_t * data_ptr,
+                        int frame_width,
+                        int frame_height,
+                        CompressedFormat format,
+                        volatile bool& t_exit_status) const noexcept
+        {
+            // The render thread owns the context, frames go to `submit_frame`
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
+            this->m_window_properties->image_show_compressed(data_ptr,
+                                                             frame_width,
+                                                             frame_height,
+                                                             format,
+                                                             t_exit_status);
+        }
+
+        bool is_compressed_format_supported(CompressedFormat format) const noexcept
+        {
+            // Capabilities are read once when the first window is created
+            return YB::is_compressed_format_supported(format);
+        }
+
+        void set_compressed_upload(CompressedUpload compressed_upload) const noexcept
+        {
+            this->m_window_properties->set_compressed_upload(compressed_upload);
+        }
+
+        bool is_compressed_upload_native(CompressedFormat format) const noexcept
+        {
+            return this->m_window_properties->is_compressed_upload_native(format);
+        }
+
+        void refresh() const noexcept
+        {
+            // The render thread refreshes the window while it waits for frames
+            if (!this->m_render_thread)
+            {
+                this->m_window_properties->refresh();
+            }
+        }
+
+        void set_change_detection(bool is_enabled) const noexcept
+        {
+            this->m_window_properties->set_change_detection(is_enabled);
+        }
+
+        UploadStatistics get_upload_statistics() const noexcept
+        {
+            return this->m_window_properties->get_upload_statistics();
+        }
+
+        uint8_t* acquire_frame(int frame_width,
+                               int frame_height,
+                               PixelFormat format) const noexcept
+        {
+            // The render thread owns the context, buffers can not be mapped here
+            if (this->m_render_thread)
+            {
+                return nullptr;
+            }
+
+            return this->m_window_properties->acquire_frame(frame_width,
+                                                            frame_height,
+                                                            format);
+        }
+
+        void submit_frame(volatile bool& t_exit_status) const noexcept
+        {
+            if (!this->m_render_thread)
+            {
+                this->m_window_properties->submit_acquired_frame(t_exit_status);
+            }
+        }
+
+        void set_display_range(float minimum, float maximum) const noexcept
+        {
+            this->m_window_properties->set_display_range(minimum, maximum);
+        }
+
+        void set_auto_display_range() const noexcept
+        {
+            this->m_window_properties->set_auto_display_range();
+        }
+
+        void set_colormap(Colormap colormap) const
+        {
+            this->m_window_properties->set_colormap(colormap);
+        }
+
+        void set_custom_colormap(const uint8_t* rgba_entries, int entry_count) const
+        {
+            this->m_window_properties->set_custom_colormap(rgba_entries, entry_count);
+        }
+
+        void set_view(float zoom, float center_x, float center_y) const noexcept
+        {
+            this->m_window_properties->set_view(zoom, center_x, center_y);
+        }
+
+        bool set_tile_source(const TileSource& source, size_t memory_budget) const
+        {
+            // The render thread owns the context
+            if (this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_window_properties->set_tile_source(source, memory_budget);
+        }
+
+        void tiled_image_show(volatile bool& t_exit_status) const
+        {
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
+            this->m_window_properties->tiled_image_show(t_exit_status);
+        }
+
+        bool set_mosaic(const MosaicLayout& layout) const
+        {
+            // The render thread owns the context
+            if (this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_window_properties->set_mosaic(layout);
+        }
+
+        bool update_mosaic_tile(int tile_index, const uint8_t* data_ptr) const noexcept
+        {
+            if (this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_window_properties->update_mosaic_tile(tile_index, data_ptr);
+        }
+
+        void mosaic_show(volatile bool& t_exit_status) const
+        {
+            if (this->m_render_thread)
+            {
+                return;
+            }
+
+            this->m_window_properties->mosaic_show(t_exit_status);
+        }
+
+        void set_aspect_mode(AspectMode aspect_mode) const noexcept
+        {
+            this->m_window_properties->set_aspect_mode(aspect_mode);
+        }
+
+        void set_overlay(const Overlay& overlay) const
+        {
+            this->m_window_properties->set_overlay(overlay);
+        }
+
+        void start_render_thread(PresentPolicy policy)
+        {
+            this->m_render_thread.reset();
+            this->m_render_thread
+                = std::make_unique<RenderThread>(*this->m_window_properties,
+                                                 policy);
+        }
+
+        void stop_render_thread() noexcept
+        {
+            this->m_render_thread.reset();
+        }
+
+        bool submit_frame(const uint8_t* data_ptr,
+                          int frame_width,
+                          int frame_height,
+                          PixelFormat format,
+                          volatile bool& t_exit_status,
+                          FrameReleaseCallback release_callback,
+                          void* user_data) const noexcept
+        {
+            if (this->m_window_properties->should_close())
+            {
+                t_exit_status = true;
+                return false;
+            }
+
+            if (!this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_render_thread->submit(data_ptr,
+                                                 frame_width,
+                                                 frame_height,
+                                                 format,
+                                                 release_callback,
+                                                 user_data);
+        }
+
+        bool read_pixels(uint8_t* rgba_ptr) const noexcept
+        {
+            // The render thread owns the context
+            if (this->m_render_thread)
+            {
+                return false;
+            }
+
+            return this->m_window_properties->read_pixels(rgba_ptr);
+        }
+
+        bool start_capture(const CaptureSettings& settings) const
+        {
+            return this->m_window_properties->start_capture(settings);
+        }
+
+        void stop_capture() const noexcept
+        {
+            // The render thread owns the context, its readbacks in flight are dropped
+            if (!this->m_render_thread)
+            {
+                this->m_window_properties->flush_capture();
+            }
+
+            this->m_window_properties->stop_capture();
+        }
+
+        CaptureStatistics get_capture_statistics() const noexcept
+        {
+            return this->m_window_properties->get_capture_statistics();
+        }
+
+        void set_pacing(const PacingSettings& settings) const noexcept
+        {
+            this->m_window_properties->set_pacing(settings);
+        }
+
+        PacingStatistics get_pacing_statistics() const noexcept
+        {
+            return this->m_window_properties->get_pacing_statistics();
+        }
+
+        bool pop_event(WindowEvent& event) const noexcept
+        {
+            return this->m_window_properties->pop_event(event);
+        }
+
+        FrameStatistics get_stats() const noexcept
+        {
+            FrameStatistics statistics = this->m_window_properties->get_frame_statistics();
+            statistics.dropped_frame_count = this->get_dropped_frame_count();
+
+            return statistics;
+        }
+
+        IWindowProperties& get_window_properties() const noexcept
+        {
+            return *this->m_window_properties;
+        }
+
+        bool has_render_thread() const noexcept
+        {
+            return static_cast<bool>(this->m_render_thread);
+        }
+
+        uint64_t get_dropped_frame_count() const noexcept
+        {
+            return this->m_render_thread
+                   ? this->m_render_thread->get_dropped_frame_count()
+                   : 0;
+        }
+
     ////////////////////////////////////////////////////////////////////////////
     // Private Members
     ////////////////////////////////////////////////////////////////////////////
     private:
 
         std::unique_ptr<IWindowProperties> m_window_properties;
+        std::unique_ptr<RenderThread> m_render_thread;
 
     }; // class Window::Impl
 
@@ -76,12 +426,16 @@ namespace YB
     WindowCreator::WindowCreator(const char *window_name,
                                  int window_width,
                                  int window_height,
-                                 bool cap_to_screen_frame_rate)
+                                 bool cap_to_screen_frame_rate,
+                                 UploadMode upload_mode,
+                                 SurfaceMode surface_mode)
     {
         this->p_impl = std::make_unique<Impl>(window_name,
                                               window_width,
                                               window_height,
-                                              cap_to_screen_frame_rate);
+                                              cap_to_screen_frame_rate,
+                                              upload_mode,
+                                              surface_mode);
     }
 
     WindowCreator::~WindowCreator() noexcept = default;
@@ -94,13 +448,277 @@ namespace YB
         this->p_impl->image_show(data_ptr,
                                  frame_width,
                                  frame_height,
+                                 PixelFormat::RGBA,
+                                 exit_status);
+    }
+
+    void WindowCreator::image_show(const uint8_t *data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   PixelFormat format,
+                                   volatile bool &exit_status) const noexcept
+    {
+        this->p_impl->image_show(data_ptr,
+                                 frame_width,
+                                 frame_height,
+                                 format,
+                                 exit_status);
+    }
+
+    void WindowCreator::image_show(const uint8_t *data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   PixelFormat format,
+                                   const Rect* dirty_regions,
+                                   int region_count,
+                                   volatile bool &exit_status) const noexcept
+    {
+        this->p_impl->image_show(data_ptr,
+                                 frame_width,
+                                 frame_height,
+                                 format,
+                                 dirty_regions,
+                                 region_count,
+                                 exit_status);
+    }
+
+    bool WindowCreator::image_show(const FrameView& view,
+                                   volatile bool &exit_status) const noexcept
+    {
+        return this->p_impl->image_show(view, exit_status);
+    }
+
+    void WindowCreator::image_show(const uint8_t *data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   PixelFormat format,
+                                   uint64_t generation,
+                                   volatile bool &exit_status) const noexcept
+    {
+        this->p_impl->image_show(data_ptr,
+                                 frame_width,
+                                 frame_height,
+                                 format,
+                                 generation,
+                                 exit_status);
+    }
+
+    void WindowCreator::image_show(const uint8_t *data_ptr,
+                                   int frame_width,
+                                   int frame_height,
+                                   CompressedFormat format,
+                                   volatile bool &exit_status) const noexcept
+    {
+        this->p_impl->image_show(data_ptr,
+                                 frame_width,
+                                 frame_height,
+                                 format,
                                  exit_status);
     }
 
+    bool WindowCreator::is_compressed_format_supported(CompressedFormat format) const noexcept
+    {
+        return this->p_impl->is_compressed_format_supported(format);
+    }
+
+    void WindowCreator::set_compressed_upload(CompressedUpload compressed_upload) const noexcept
+    {
+        this->p_impl->set_compressed_upload(compressed_upload);
+    }
+
+    bool WindowCreator::is_compressed_upload_native(CompressedFormat format) const noexcept
+    {
+        return this->p_impl->is_compressed_upload_native(format);
+    }
+
+    void WindowCreator::refresh() const noexcept
+    {
+        this->p_impl->refresh();
+    }
+
+    void WindowCreator::set_change_detection(bool is_enabled) const noexcept
+    {
+        this->p_impl->set_change_detection(is_enabled);
+    }
+
+    UploadStatistics WindowCreator::get_upload_statistics() const noexcept
+    {
+        return this->p_impl->get_upload_statistics();
+    }
+
+    uint8_t* WindowCreator::acquire_frame(int frame_width,
+                                          int frame_height,
+                                          PixelFormat format) const noexcept
+    {
+        return this->p_impl->acquire_frame(frame_width, frame_height, format);
+    }
+
+    void WindowCreator::submit_frame(volatile bool& exit_status) const noexcept
+    {
+        this->p_impl->submit_frame(exit_status);
+    }
+
+    void WindowCreator::set_display_range(float minimum, float maximum) const noexcept
+    {
+        this->p_impl->set_display_range(minimum, maximum);
+    }
+
+    void WindowCreator::set_auto_display_range() const noexcept
+    {
+        this->p_impl->set_auto_display_range();
+    }
+
+    void WindowCreator::set_colormap(Colormap colormap) const
+    {
+        this->p_impl->set_colormap(colormap);
+    }
+
+    void WindowCreator::set_custom_colormap(const uint8_t* rgba_entries, int entry_count) const
+    {
+        this->p_impl->set_custom_colormap(rgba_entries, entry_count);
+    }
+
+    void WindowCreator::set_view(float zoom, float center_x, float center_y) const noexcept
+    {
+        this->p_impl->set_view(zoom, center_x, center_y);
+    }
+
+    bool WindowCreator::set_tile_source(const TileSource& source, size_t memory_budget) const
+    {
+        return this->p_impl->set_tile_source(source, memory_budget);
+    }
+
+    void WindowCreator::tiled_image_show(volatile bool& exit_status) const
+    {
+        this->p_impl->tiled_image_show(exit_status);
+    }
+
+    bool WindowCreator::set_mosaic(const MosaicLayout& layout) const
+    {
+        return this->p_impl->set_mosaic(layout);
+    }
+
+    bool WindowCreator::update_mosaic_tile(int tile_index, const uint8_t* data_ptr) const noexcept
+    {
+        return this->p_impl->update_mosaic_tile(tile_index, data_ptr);
+    }
+
+    void WindowCreator::mosaic_show(volatile bool& exit_status) const
+    {
+        this->p_impl->mosaic_show(exit_status);
+    }
+
+    void WindowCreator::set_aspect_mode(AspectMode aspect_mode) const noexcept
+    {
+        this->p_impl->set_aspect_mode(aspect_mode);
+    }
+
+    void WindowCreator::set_overlay(const Overlay& overlay) const
+    {
+        this->p_impl->set_overlay(overlay);
+    }
+
+    void WindowCreator::clear_overlay() const
+    {
+        this->p_impl->set_overlay(Overlay{});
+    }
+
+    bool WindowCreator::read_pixels(uint8_t* rgba_ptr) const noexcept
+    {
+        return this->p_impl->read_pixels(rgba_ptr);
+    }
+
+    bool WindowCreator::start_capture(const CaptureSettings& settings) const
+    {
+        return this->p_impl->start_capture(settings);
+    }
+
+    void WindowCreator::stop_capture() const noexcept
+    {
+        this->p_impl->stop_capture();
+    }
+
+    CaptureStatistics WindowCreator::get_capture_statistics() const noexcept
+    {
+        return this->p_impl->get_capture_statistics();
+    }
+
+    void WindowCreator::set_pacing(const PacingSettings& settings) const noexcept
+    {
+        this->p_impl->set_pacing(settings);
+    }
+
+    PacingStatistics WindowCreator::get_pacing_statistics() const noexcept
+    {
+        return this->p_impl->get_pacing_statistics();
+    }
+
+    void WindowCreator::start_render_thread(PresentPolicy policy)
+    {
+        this->p_impl->start_render_thread(policy);
+    }
+
+    void WindowCreator::stop_render_thread() noexcept
+    {
+        this->p_impl->stop_render_thread();
+    }
+
+    bool WindowCreator::submit_frame(const uint8_t* data_ptr,
+                                     int frame_width,
+                                     int frame_height,
+                                     PixelFormat format,
+                                     volatile bool& exit_status,
+                                     FrameReleaseCallback release_callback,
+                                     void* user_data) const noexcept
+    {
+        return this->p_impl->submit_frame(data_ptr,
+                                          frame_width,
+                                          frame_height,
+                                          format,
+                                          exit_status,
+                                          release_callback,
+                                          user_data);
+    }
+
+    uint64_t WindowCreator::get_dropped_frame_count() const noexcept
+    {
+        return this->p_impl->get_dropped_frame_count();
+    }
+
+    bool WindowCreator::pop_event(WindowEvent& event) const noexcept
+    {
+        return this->p_impl->pop_event(event);
+    }
+
+    FrameStatistics WindowCreator::get_stats() const noexcept
+    {
+        return this->p_impl->get_stats();
+    }
+
+    void WindowCreator::poll_events() noexcept
+    {
+        WindowProperties::poll_events();
+    }
+
+    void WindowCreator::set_debug_logger(DebugLogger logger, void* user_data) noexcept
+    {
+        WindowProperties::set_debug_logger(logger, user_data);
+    }
+
 ////////////////////////////////////////////////////////////////////////////////
 // Private Functions
 ////////////////////////////////////////////////////////////////////////////////
 
+    IWindowProperties& WindowCreator::get_window_properties() const noexcept
+    {
+        return this->p_impl->get_window_properties();
+    }
+
+    bool WindowCreator::has_render_thread() const noexcept
+    {
+        return this->p_impl->has_render_thread();
+    }
+
 ////////////////////////////////////////////////////////////////////////////////
 // Protected Functions
 ////////////////////////////////////////////////////////////////////////////////
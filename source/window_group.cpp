@@ -0,0 +1,293 @@
+///
+/// @file window_group.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `WindowGroup` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <vector>
+#include "window_group.hpp"
+#include "window_properties.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+    class WindowGroup::Impl
+    {
+    public:
+    ////////////////////////////////////////////////////////////////////////////
+    // Special Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        ~Impl() noexcept
+        {
+            // Pacing settings set meanwhile apply from the next present on
+            for (Member& member : this->m_members)
+            {
+                member.properties->set_grouped(false);
+            }
+        }
+
+        Impl(Impl &&) noexcept = default;
+        Impl &operator=(Impl &&) noexcept = default;
+        Impl(const Impl &) noexcept = delete;
+        Impl &operator=(Impl const &) noexcept = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Public Members
+    ////////////////////////////////////////////////////////////////////////////
+
+        explicit Impl(bool cap_to_screen_frame_rate) :
+            m_cap_to_screen_frame_rate{cap_to_screen_frame_rate},
+            m_vsync_member_index{-1}
+        {
+        }
+
+        bool add_window(WindowCreator& window)
+        {
+            // The render thread owns the context and sets its swap interval
+            if (window.has_render_thread() || this->find_member(window))
+            {
+                return false;
+            }
+
+            Member member{};
+            member.window = &window;
+            member.properties = &window.get_window_properties();
+            member.rate_window_begin = clock::now();
+
+            // Only one member waits for the vertical blank, see `present`
+            member.properties->make_context_current();
+            member.properties->set_grouped(true);
+            member.properties->set_swap_interval(0);
+
+            this->m_members.push_back(member);
+
+            return true;
+        }
+
+        void set_frame(const WindowCreator& window,
+                       const uint8_t* data_ptr,
+                       int frame_width,
+                       int frame_height,
+                       PixelFormat format) noexcept
+        {
+            Member* member = this->find_member(window);
+
+            if (member)
+            {
+                member->data_ptr = data_ptr;
+                member->frame_width = frame_width;
+                member->frame_height = frame_height;
+                member->format = format;
+                member->has_pending_frame = true;
+            }
+        }
+
+        void present(volatile bool& t_exit_status) noexcept
+        {
+            WindowProperties::poll_events_without_pump();
+
+            int last_pending_index = -1;
+
+            for (int idx = 0; idx < static_cast<int>(this->m_members.size()); ++idx)
+            {
+                Member& member = this->m_members[idx];
+
+                if (member.properties->should_close())
+                {
+                    t_exit_status = true;
+                    member.has_pending_frame = false;
+                }
+
+                if (member.window->has_render_thread())
+                {
+                    // Started after joining, the group must not touch its context
+                    member.has_pending_frame = false;
+                }
+
+                if (member.has_pending_frame)
+                {
+                    last_pending_index = idx;
+                }
+            }
+
+            if (-1 == last_pending_index)
+            {
+                return;
+            }
+
+            // Upload and draw everything before any swap can block
+            for (Member& member : this->m_members)
+            {
+                if (member.has_pending_frame)
+                {
+                    member.properties->make_context_current();
+                    member.properties->upload_frame(member.data_ptr,
+                                                    member.frame_width,
+                                                    member.frame_height,
+                                                    member.format);
+                    member.properties->draw_frame();
+                }
+            }
+
+            this->move_vsync_to(last_pending_index);
+
+            // The member which is swapped last carries the only vertical
+            // blank wait of the pass, the others are swapped immediately.
+            const auto now = clock::now();
+
+            for (Member& member : this->m_members)
+            {
+                if (member.has_pending_frame)
+                {
+                    member.properties->make_context_current();
+                    member.properties->swap_buffers();
+                    member.has_pending_frame = false;
+                    ++member.presented_frame_count;
+                }
+
+                const std::chrono::duration<double> elapsed = now - member.rate_window_begin;
+
+                if (elapsed.count() >= 1.0)
+                {
+                    member.frame_rate = member.presented_frame_count / elapsed.count();
+                    member.presented_frame_count = 0;
+                    member.rate_window_begin = now;
+                }
+            }
+        }
+
+        double get_window_frame_rate(const WindowCreator& window) const noexcept
+        {
+            for (const Member& member : this->m_members)
+            {
+                if (member.window == &window)
+                {
+                    return member.frame_rate;
+                }
+            }
+
+            return 0.0;
+        }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Private Members
+    ////////////////////////////////////////////////////////////////////////////
+    private:
+
+        using clock = std::chrono::steady_clock;
+
+        struct Member
+        {
+            const WindowCreator* window; ///< Member window.
+            IWindowProperties* properties; ///< Implementation of the member window.
+            const uint8_t* data_ptr; ///< Pending frame.
+            int frame_width; ///< Pending frame width.
+            int frame_height; ///< Pending frame height.
+            PixelFormat format; ///< Pending frame pixel format.
+            bool has_pending_frame; ///< Set by `set_frame`, cleared by `present`.
+            uint64_t presented_frame_count; ///< Frames presented since `rate_window_begin`.
+            double frame_rate; ///< Last measured presentation rate.
+            clock::time_point rate_window_begin; ///< Start of the current measurement window.
+        };
+
+        Member* find_member(const WindowCreator& window) noexcept
+        {
+            for (Member& member : this->m_members)
+            {
+                if (member.window == &window)
+                {
+                    return &member;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void move_vsync_to(int member_index) noexcept
+        {
+            if (!this->m_cap_to_screen_frame_rate
+                || member_index == this->m_vsync_member_index)
+            {
+                return;
+            }
+
+            if (this->m_vsync_member_index != -1
+                && !this->m_members[this->m_vsync_member_index].window->has_render_thread())
+            {
+                IWindowProperties* previous
+                    = this->m_members[this->m_vsync_member_index].properties;
+                previous->make_context_current();
+                previous->set_swap_interval(0);
+            }
+
+            IWindowProperties* next = this->m_members[member_index].properties;
+            next->make_context_current();
+            next->set_swap_interval(1);
+
+            this->m_vsync_member_index = member_index;
+        }
+
+        bool m_cap_to_screen_frame_rate; ///< Whether one member waits for the vertical blank.
+        int m_vsync_member_index; ///< Member whose swap interval is 1, -1 if none.
+        std::vector<Member> m_members; ///< Member windows in presentation order.
+
+    }; // class WindowGroup::Impl
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    WindowGroup::WindowGroup(bool cap_to_screen_frame_rate)
+    {
+        this->p_impl = std::make_unique<Impl>(cap_to_screen_frame_rate);
+    }
+
+    WindowGroup::~WindowGroup() noexcept = default;
+
+    bool WindowGroup::add_window(WindowCreator& window)
+    {
+        return this->p_impl->add_window(window);
+    }
+
+    void WindowGroup::set_frame(const WindowCreator& window,
+                                const uint8_t* data_ptr,
+                                int frame_width,
+                                int frame_height,
+                                PixelFormat format) noexcept
+    {
+        this->p_impl->set_frame(window, data_ptr, frame_width, frame_height, format);
+    }
+
+    void WindowGroup::present(volatile bool& exit_status) noexcept
+    {
+        this->p_impl->present(exit_status);
+    }
+
+    double WindowGroup::get_window_frame_rate(const WindowCreator& window) const noexcept
+    {
+        return this->p_impl->get_window_frame_rate(window);
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -0,0 +1,67 @@
+///
+/// @file window_manager.cpp
+/// @author Yasin BASAR
+/// @brief Implements the `WindowManager` class.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include "window_manager.hpp"
+#include "window_properties.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace YB
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    WindowManager::WindowManager()
+    {
+        if (!WindowProperties::set_event_pump(true))
+        {
+            throw std::runtime_error("Only one WindowManager can exist");
+        }
+    }
+
+    WindowManager::~WindowManager() noexcept
+    {
+        (void)WindowProperties::set_event_pump(false);
+    }
+
+    void WindowManager::poll_events() const noexcept
+    {
+        WindowProperties::poll_events();
+    }
+
+    void WindowManager::wait_events(double timeout_seconds) const noexcept
+    {
+        WindowProperties::wait_events(timeout_seconds);
+    }
+
+    void WindowManager::wake() noexcept
+    {
+        WindowProperties::wake_event_wait();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+// Protected Functions
+////////////////////////////////////////////////////////////////////////////////
+
+} // YB
+
+/* End of File */
@@ -12,11 +12,26 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <memory>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 #include "window_properties.hpp"
+#include "gl_extensions.hpp"
+#include "pixel_format.hpp"
+#include "colormap.hpp"
+#include "compressed_format.hpp"
 
 #ifdef _WIN32
+// Keeps std::min and std::max usable after the Windows headers
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
 #include <windows.h>
 #include <uxtheme.h>
 #include <dwmapi.h>
@@ -32,25 +47,36 @@
 
 namespace YB
 {
-    GLuint WindowProperties::m_VAO{};
+    GLFWwindow* WindowProperties::m_resource_window{nullptr};
     GLuint WindowProperties::m_VBO{};
     GLuint WindowProperties::m_IBO{};
-    GLuint WindowProperties::m_shader_program{};
     GLuint WindowProperties::m_vertex_shader_id{};
     GLuint WindowProperties::m_fragment_shader_id{};
-    GLuint WindowProperties::m_texture_output{};
-    GLint WindowProperties::m_location{};
-    bool WindowProperties::m_is_common_window_resources_cleared{false};
+    GLuint WindowProperties::m_overlay_vertex_shader_id{};
+    GLuint WindowProperties::m_overlay_fragment_shader_id{};
+    GLuint WindowProperties::m_glyph_atlas_texture{};
+    std::atomic<int> WindowProperties::m_glfw_user_count{0};
+    bool WindowProperties::m_is_glfw_headless{false};
+    std::atomic<bool> WindowProperties::m_has_event_pump{false};
+    DebugLogger WindowProperties::m_debug_logger{nullptr};
+    void* WindowProperties::m_debug_logger_user_data{nullptr};
 
     const char* WindowProperties::m_vertex_shader = "\n"
         "#version 330 core\n"
         "layout (location = 0) in vec2 position;\n"
         "layout (location = 1) in vec2 aTexCoord;\n"
         "out vec2 TexCoord;\n"
+        "flat out float Layer;\n"
+        "uniform vec4 u_view;\n"
+        "uniform vec4 u_texture_rect;\n"
+        "uniform vec2 u_grid;\n"
         "void main()\n"
         "{\n"
-        "   gl_Position = vec4(position.xy, 0.0, 1.0);\n"
-        "   TexCoord = aTexCoord;\n"
+        "   vec2 cell = vec2(mod(float(gl_InstanceID), u_grid.x), floor(float(gl_InstanceID) / u_grid.x));\n"
+        "   vec2 grid_position = (position.xy + 1.0 + 2.0 * cell) / u_grid - 1.0;\n"
+        "   gl_Position = vec4(grid_position * u_view.xy + u_view.zw, 0.0, 1.0);\n"
+        "   TexCoord = aTexCoord * u_texture_rect.xy + u_texture_rect.zw;\n"
+        "   Layer = float(gl_InstanceID);\n"
         "}\n"
         "\n";
 
@@ -58,57 +84,156 @@ namespace YB
         "#version 330 core\n"
         "layout (location = 0) out vec4 FragColor;\n"
         "in vec2 TexCoord;\n"
+        "flat in float Layer;\n"
         "uniform sampler2D t_Texture;\n"
+        "uniform sampler2DArray t_Layers;\n"
+        "uniform int u_is_layered;\n"
+        "uniform sampler2D t_Plane1;\n"
+        "uniform sampler2D t_Plane2;\n"
+        "uniform sampler1D t_Colormap;\n"
+        "uniform int u_sampling_layout;\n"
+        "uniform vec2 u_value_range;\n"
+        "vec4 sample_base()\n"
+        "{\n"
+        "   if (u_is_layered == 1)\n"
+        "   {\n"
+        "       return texture(t_Layers, vec3(TexCoord, Layer));\n"
+        "   }\n"
+        "   return texture(t_Texture, TexCoord);\n"
+        "}\n"
+        "vec4 yuv_to_rgba(float y, float u, float v)\n"
+        "{\n"
+        "   y = 1.164383 * (y - 0.062745);\n"
+        "   u = u - 0.501961;\n"
+        "   v = v - 0.501961;\n"
+        "   vec3 rgb = vec3(y + 1.596027 * v,\n"
+        "                   y - 0.391762 * u - 0.812968 * v,\n"
+        "                   y + 2.017232 * u);\n"
+        "   return vec4(clamp(rgb, 0.0, 1.0), 1.0);\n"
+        "}\n"
         "void main()\n"
         "{\n"
-        "   FragColor = texture(t_Texture, TexCoord);\n"
+        "   if (u_sampling_layout == 1)\n"
+        "   {\n"
+        "       vec2 uv = texture(t_Plane1, TexCoord).rg;\n"
+        "       FragColor = yuv_to_rgba(texture(t_Texture, TexCoord).r, uv.x, uv.y);\n"
+        "   }\n"
+        "   else if (u_sampling_layout == 2)\n"
+        "   {\n"
+        "       FragColor = yuv_to_rgba(texture(t_Texture, TexCoord).r,\n"
+        "                               texture(t_Plane1, TexCoord).r,\n"
+        "                               texture(t_Plane2, TexCoord).r);\n"
+        "   }\n"
+        "   else if (u_sampling_layout == 4)\n"
+        "   {\n"
+        "       float value = sample_base().r;\n"
+        "       float t = clamp((value - u_value_range.x) * u_value_range.y, 0.0, 1.0);\n"
+        "       float entry_count = float(textureSize(t_Colormap, 0));\n"
+        "       FragColor = texture(t_Colormap, (t * (entry_count - 1.0) + 0.5) / entry_count);\n"
+        "   }\n"
+        "   else if (u_sampling_layout == 3)\n"
+        "   {\n"
+        "       ivec2 size = textureSize(t_Texture, 0);\n"
+        "       ivec2 pixel = ivec2(TexCoord * vec2(size.x * 2, size.y));\n"
+        "       pixel = min(pixel, ivec2(size.x * 2 - 1, size.y - 1));\n"
+        "       vec4 pair = texelFetch(t_Texture, ivec2(pixel.x / 2, pixel.y), 0);\n"
+        "       float y = (pixel.x % 2 == 0) ? pair.r : pair.b;\n"
+        "       FragColor = yuv_to_rgba(y, pair.g, pair.a);\n"
+        "   }\n"
+        "   else\n"
+        "   {\n"
+        "       FragColor = sample_base();\n"
+        "   }\n"
         "}\n"
         "\n";
 
-    ///
-    /// @brief Checks for OpenGL errors and logs them.
-    ///
-    /// @param file The file name where the error check is performed.
-    /// @param line The line number where the error check is performed.
-    /// @return GLenum The last recorded OpenGL error code.
-    ///
-    GLenum glCheckError_(const char* file, int line)
-    {
-        GLenum error_code;
-        while ((error_code = glGetError()) != GL_NO_ERROR)
-        {
-            std::string error;
-            switch (error_code)
-            {
-                case GL_INVALID_ENUM:
-                    error = "INVALID_ENUM";
-                break;
-                case GL_INVALID_VALUE:
-                    error = "INVALID_VALUE";
-                break;
-                case GL_INVALID_OPERATION:
-                    error = "INVALID_OPERATION";
-                break;
-                case GL_STACK_OVERFLOW:
-                    error = "STACK_OVERFLOW";
-                break;
-                case GL_STACK_UNDERFLOW:
-                    error = "STACK_UNDERFLOW";
-                break;
-                case GL_OUT_OF_MEMORY:
-                    error = "OUT_OF_MEMORY";
-                break;
-                case GL_INVALID_FRAMEBUFFER_OPERATION:
-                    error = "INVALID_FRAMEBUFFER_OPERATION";
-                break;
-                default:
-                    break;
-            }
-            std::cout << error << " - error code: " << error_code << " | " << file << " (" << line << ")" << "\n";
-        }
-        return error_code;
-    }
-#define glCheckError() glCheckError_(__FILE__, __LINE__)
+    // Instances are expanded from the vertex id, kinds follow `OverlayKind`.
+    // Image pixels map to the image quad like the texture coordinates do,
+    // widths and glyph offsets are window pixels.
+    const char* WindowProperties::m_overlay_vertex_shader = "\n"
+        "#version 330 core\n"
+        "layout (location = 0) in vec4 a_position;\n"
+        "layout (location = 1) in vec4 a_extent;\n"
+        "layout (location = 2) in vec4 a_color;\n"
+        "out vec4 Color;\n"
+        "out vec2 LocalCoord;\n"
+        "flat out int Kind;\n"
+        "uniform vec4 u_view;\n"
+        "uniform vec2 u_image_size;\n"
+        "uniform vec2 u_viewport_size;\n"
+        "vec2 image_to_clip(vec2 pixel)\n"
+        "{\n"
+        "   return (pixel / u_image_size * 2.0 - 1.0) * u_view.xy + u_view.zw;\n"
+        "}\n"
+        "void main()\n"
+        "{\n"
+        "   vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+        "   vec2 pixel_to_clip = 2.0 / u_viewport_size;\n"
+        "   vec2 clip;\n"
+        "   Kind = int(a_extent.w);\n"
+        "   LocalCoord = corner * 2.0 - 1.0;\n"
+        "   if (Kind == 0)\n"
+        "   {\n"
+        "       vec2 begin = image_to_clip(a_position.xy);\n"
+        "       vec2 span = (image_to_clip(a_position.zw) - begin) / pixel_to_clip;\n"
+        "       float len = length(span);\n"
+        "       vec2 direction = len > 0.0 ? span / len : vec2(1.0, 0.0);\n"
+        "       float half_width = 0.5 * a_extent.x;\n"
+        "       vec2 pixel = direction * (corner.x * (len + 2.0 * half_width) - half_width)\n"
+        "                  + vec2(-direction.y, direction.x) * LocalCoord.y * half_width;\n"
+        "       clip = begin + pixel * pixel_to_clip;\n"
+        "   }\n"
+        "   else if (Kind == 1)\n"
+        "   {\n"
+        "       clip = image_to_clip(mix(a_position.xy, a_position.zw, corner));\n"
+        "   }\n"
+        "   else if (Kind == 2)\n"
+        "   {\n"
+        "       clip = image_to_clip(a_position.xy) + LocalCoord * 0.5 * a_extent.x * pixel_to_clip;\n"
+        "   }\n"
+        "   else\n"
+        "   {\n"
+        "       clip = image_to_clip(a_position.xy) + (a_position.zw + corner * a_extent.xy) * pixel_to_clip;\n"
+        "       vec2 cell = vec2(mod(a_extent.z, 16.0), floor(a_extent.z / 16.0));\n"
+        "       LocalCoord = (cell + corner) / vec2(16.0, 6.0);\n"
+        "   }\n"
+        "   gl_Position = vec4(clip, 0.0, 1.0);\n"
+        "   Color = a_color;\n"
+        "}\n"
+        "\n";
+
+    const char* WindowProperties::m_overlay_fragment_shader = "\n"
+        "#version 330 core\n"
+        "layout (location = 0) out vec4 FragColor;\n"
+        "in vec4 Color;\n"
+        "in vec2 LocalCoord;\n"
+        "flat in int Kind;\n"
+        "uniform sampler2D t_Glyphs;\n"
+        "void main()\n"
+        "{\n"
+        "   float coverage = 1.0;\n"
+        "   if (Kind == 2 && dot(LocalCoord, LocalCoord) > 1.0)\n"
+        "   {\n"
+        "       discard;\n"
+        "   }\n"
+        "   else if (Kind == 3)\n"
+        "   {\n"
+        "       coverage = texture(t_Glyphs, LocalCoord).r;\n"
+        "   }\n"
+        "   if (Color.a * coverage <= 0.0)\n"
+        "   {\n"
+        "       discard;\n"
+        "   }\n"
+        "   FragColor = vec4(Color.rgb, Color.a * coverage);\n"
+        "}\n"
+        "\n";
+
+// Error checks query the driver synchronously, so release builds drop them
+#ifdef GL_ERROR_CHECKS
+#define glCheckError() check_gl_error(__FILE__, __LINE__)
+#else
+#define glCheckError() ((void)0)
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Public Functions
@@ -117,158 +242,331 @@ namespace YB
     WindowProperties::WindowProperties(const char *window_name,
                                        int window_width,
                                        int window_height,
-                                       bool cap_to_screen_frame_rate) :
-        m_window{nullptr}
+                                       bool cap_to_screen_frame_rate,
+                                       UploadMode upload_mode,
+                                       SurfaceMode surface_mode) :
+        m_window{nullptr},
+        m_VAO{0},
+        m_shader_program{0},
+        m_location{-1},
+        m_plane1_location{-1},
+        m_plane2_location{-1},
+        m_sampling_layout_location{-1},
+        m_colormap_location{-1},
+        m_value_range_location{-1},
+        m_view_location{-1},
+        m_texture_rect_location{-1},
+        m_layers_location{-1},
+        m_is_layered_location{-1},
+        m_grid_location{-1},
+        m_upload_mode{upload_mode},
+        m_surface_mode{surface_mode},
+        m_framebuffer{0},
+        m_color_renderbuffer{0},
+        m_surface_width{window_width},
+        m_surface_height{window_height},
+        m_textures{},
+        m_texture_width{0},
+        m_texture_height{0},
+        m_texture_format{PixelFormat::RGBA},
+        m_is_texture_compressed{false},
+        m_texture_compression{CompressedFormat::BC1},
+        m_pbo_ids{},
+        m_pbo_fences{},
+        m_pbo_mapped_ptrs{},
+        m_acquired_ptr{nullptr},
+        m_pbo_index{0},
+        m_pbo_size{0},
+        m_viewport_width{window_width},
+        m_viewport_height{window_height},
+        m_is_viewport_dirty{false},
+        m_is_display_dirty{false},
+        m_has_display_range{false},
+        m_is_auto_display_range{false},
+        m_display_minimum{0.0f},
+        m_display_maximum{1.0f},
+        m_display_zoom{1.0f},
+        m_display_center_x{0.5f},
+        m_display_center_y{0.5f},
+        m_display_aspect_mode{AspectMode::Stretch},
+        m_pending_overlay{},
+        m_has_pending_overlay{false},
+        m_overlay_VAO{0},
+        m_overlay_program{0},
+        m_overlay_view_location{-1},
+        m_overlay_image_size_location{-1},
+        m_overlay_viewport_size_location{-1},
+        m_overlay_buffer{0},
+        m_overlay_buffer_size{0},
+        m_overlay_instance_count{0},
+        m_colormap_texture{0},
+        m_use_display_range{false},
+        m_use_auto_display_range{false},
+        m_level_minimum{0.0f},
+        m_level_maximum{1.0f},
+        m_auto_minimum{0.0f},
+        m_auto_maximum{1.0f},
+        m_zoom{1.0f},
+        m_center_x{0.5f},
+        m_center_y{0.5f},
+        m_aspect_mode{AspectMode::Stretch},
+        m_is_mipmap_filter{false},
+        m_are_mipmaps_dirty{false},
+        m_dirty_regions{},
+        m_decompressed_frame{},
+        m_change_detector{},
+        m_frame_layout{},
+        m_frame_generation{0},
+        m_shown_content{ShownContent::None},
+        m_needs_redraw{true},
+        m_redraw_listener_mutex{},
+        m_redraw_listener{nullptr},
+        m_redraw_listener_user_data{nullptr},
+        m_redundant_frame_count{0},
+        m_is_change_detection_enabled{false},
+        m_compressed_upload{CompressedUpload::Auto},
+        m_uploaded_bytes{0},
+        m_skipped_bytes{0},
+        m_frame_profiler{},
+        m_frame_capture{},
+        m_frame_pacer{cap_to_screen_frame_rate ? PacingMode::VSync : PacingMode::Unlimited},
+        m_gl_state{},
+        m_tile_cache{},
+        m_mosaic{},
+        m_tile_draws{},
+        m_fallback_tile_draws{},
+        m_tile_frame_index{0},
+        m_gl_call_count{0},
+        m_gl_skipped_call_count{0},
+        m_events{},
+        m_dropped_event_count{0},
+        m_is_debug_output_enabled{false}
     {
-        if (!glfwInit())
+        if (!acquire_glfw(SurfaceMode::Offscreen == surface_mode))
         {
             throw std::runtime_error("Could not start GLFW3");
         }
 
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        // The platform is chosen once for all windows, the null platform
+        // has no visible windows.
+        if (m_is_glfw_headless && SurfaceMode::Window == surface_mode)
+        {
+            release_glfw();
+            throw std::runtime_error("Visible windows can not be created while "
+                                     "offscreen windows run without a display server");
+        }
 
-        glfwWindowHint(GLFW_SRGB_CAPABLE, GLFW_TRUE);
-        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        set_context_hints();
 
+        // Shader and quad objects live in the resource context and are
+        // shared, so they are compiled once for all windows.
         this->m_window = glfwCreateWindow(window_width,
                                           window_height,
                                           window_name,
                                           nullptr,
-                                          nullptr);
+                                          m_resource_window);
 
         if (!this->m_window)
         {
-            glfwTerminate();
+            release_glfw();
             throw std::runtime_error("Could not create GLFW3 Window");
         }
 
-        /* Make the window's context current */
-        glfwMakeContextCurrent(this->m_window);
-
-        if (cap_to_screen_frame_rate)
-        {
-            glfwSwapInterval(1); // set 1 to limit fps to the screen's framerate
-        }
-        else
-        {
-            glfwSwapInterval(0); // set 0 for un-limited fps
-        }
-
-        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+        try
         {
-            throw std::runtime_error("Could not initialize GLAD");
-        }
+            /* Make the window's context current */
+            glfwMakeContextCurrent(this->m_window);
 
-        glfwSetWindowUserPointer(m_window, this);
-
-        glfwSetKeyCallback(this->m_window, keyboard_callback);
-        glfwSetWindowSizeCallback(this->m_window, window_resize_callback);
+            if (cap_to_screen_frame_rate)
+            {
+                glfwSwapInterval(1); // set 1 to limit fps to the screen's framerate
+            }
+            else
+            {
+                glfwSwapInterval(0); // set 0 for un-limited fps
+            }
 
-#ifdef _WIN32
-        if (is_dark_mode_enabled())
-        {
-            // Get the native GLFW window handle
-            HWND hwnd = glfwGetWin32Window(this->m_window);
+            if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+            {
+                throw std::runtime_error("Could not initialize GLAD");
+            }
 
-            // You can also use DwmSetWindowAttribute for more detailed settings
-            BOOL dark_mode = TRUE;
-            (void)DwmSetWindowAttribute(hwnd,
-                                        DWMWA_USE_IMMERSIVE_DARK_MODE,
-                                        &dark_mode,
-                                        sizeof(dark_mode));
-        }
-#endif
+            GLExtensions::load();
+            this->m_is_debug_output_enabled = enable_debug_output();
 
-        glfwShowWindow(this->m_window);
+            this->m_frame_profiler.create_queries();
 
-        set_window_properties();
-    }
+            glfwSetWindowUserPointer(m_window, this);
 
-    WindowProperties::~WindowProperties()
-    {
-        // Ensure the context is current
-        glfwMakeContextCurrent(this->m_window);
+            glfwSetKeyCallback(this->m_window, keyboard_callback);
+            glfwSetWindowSizeCallback(this->m_window, window_resize_callback);
+            glfwSetWindowCloseCallback(this->m_window, window_close_callback);
+            glfwSetWindowRefreshCallback(this->m_window, window_refresh_callback);
 
-        if (!m_is_common_window_resources_cleared)
-        {
-            if (m_VAO != 0)
+    #ifdef _WIN32
+            if (is_dark_mode_enabled())
             {
-                glDeleteVertexArrays(1, &m_VAO);
+                // Get the native GLFW window handle
+                HWND hwnd = glfwGetWin32Window(this->m_window);
+
+                // You can also use DwmSetWindowAttribute for more detailed settings
+                BOOL dark_mode = TRUE;
+                (void)DwmSetWindowAttribute(hwnd,
+                                            DWMWA_USE_IMMERSIVE_DARK_MODE,
+                                            &dark_mode,
+                                            sizeof(dark_mode));
             }
-            if (m_VBO != 0)
+    #endif
+
+            if (SurfaceMode::Offscreen == surface_mode)
             {
-                glDeleteBuffers(1, &m_VBO);
+                // Hidden windows get no resize events, the framebuffer object
+                // keeps the size the window was created with.
+                this->create_offscreen_framebuffer(window_width, window_height);
             }
-            if (m_IBO != 0)
+            else
             {
-                glDeleteBuffers(1, &m_IBO);
+                glfwShowWindow(this->m_window);
             }
 
-            if (m_shader_program != 0)
+            this->create_vertex_array();
+            this->create_shader_program();
+
+            // Single channel formats are shown through the gray ramp by default
+            const std::vector<uint8_t> gray_ramp = make_colormap(Colormap::Gray);
+
+            glGenTextures(1, &this->m_colormap_texture);
+            glBindTexture(GL_TEXTURE_1D, this->m_colormap_texture);
+            glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexImage1D(GL_TEXTURE_1D,
+                         0,
+                         GL_RGBA8,
+                         colormap_entry_count,
+                         0,
+                         GL_RGBA,
+                         GL_UNSIGNED_BYTE,
+                         gray_ramp.data());
+            glBindTexture(GL_TEXTURE_1D, 0);
+        }
+        catch (...)
+        {
+            // The destructor does not run for a partially constructed window
+            glDeleteProgram(this->m_shader_program);
+
+            if (this->m_color_renderbuffer != 0)
             {
-                if (m_vertex_shader_id != 0)
-                {
-                    glDetachShader(m_shader_program, m_vertex_shader_id);
-                }
-                if (m_fragment_shader_id != 0)
-                {
-                    glDetachShader(m_shader_program, m_fragment_shader_id);
-                }
-                glDeleteProgram(m_shader_program);
+                glDeleteRenderbuffers(1, &this->m_color_renderbuffer);
             }
 
-            m_is_common_window_resources_cleared = true;
+            glfwMakeContextCurrent(nullptr);
+            glfwDestroyWindow(this->m_window);
+            release_glfw();
+            throw;
+        }
+    }
+
+    WindowProperties::~WindowProperties()
+    {
+        // Ensure the context is current
+        this->bind_context();
+
+        this->release_pixel_buffer_ring();
+        this->m_tile_cache.release();
+        this->m_mosaic.release();
+
+        glDeleteTextures(m_max_plane_count, this->m_textures);
+        glDeleteTextures(1, &this->m_colormap_texture);
+
+        this->m_frame_profiler.release_queries();
+
+        this->m_frame_capture.stop();
+        this->m_frame_capture.release();
+
+        if (this->m_framebuffer != 0)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &this->m_framebuffer);
+            glDeleteRenderbuffers(1, &this->m_color_renderbuffer);
+        }
+
+        if (this->m_VAO != 0)
+        {
+            glDeleteVertexArrays(1, &this->m_VAO);
         }
 
+        if (this->m_overlay_VAO != 0)
+        {
+            glDeleteVertexArrays(1, &this->m_overlay_VAO);
+            glDeleteBuffers(1, &this->m_overlay_buffer);
+            glDeleteProgram(this->m_overlay_program);
+        }
+
+        glDeleteProgram(this->m_shader_program);
+
+        glfwMakeContextCurrent(nullptr);
         glfwDestroyWindow(this->m_window);
-        glfwTerminate();
+        release_glfw();
     }
 
-    void WindowProperties::image_show(uint8_t * data_ptr,
+    void WindowProperties::image_show(const uint8_t * data_ptr,
                                       int frame_width,
                                       int frame_height,
+                                      PixelFormat format,
                                       volatile bool & exit_status) noexcept
     {
 
-        glfwMakeContextCurrent(this->m_window);
+        this->bind_context();
 
         glCheckError();
 
         /* Loop until the user closes the window */
         if (!glfwWindowShouldClose(this->m_window))
         {
-            glfwPollEvents();
-
-            glClear(GL_COLOR_BUFFER_BIT);
-
-            glUseProgram(m_shader_program);
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
 
-            glActiveTexture(GL_TEXTURE0);
-            glUniform1i(m_location, 0);
-            glBindTexture(GL_TEXTURE_2D, m_texture_output);
-
-            glTexImage2D(GL_TEXTURE_2D,
-                         0,
-                         GL_RGBA8,
-                         frame_width,
-                         frame_height,
-                         0,
-                         GL_RGBA,
-                         GL_UNSIGNED_BYTE,
-                         data_ptr);
+            this->render_frame(data_ptr, frame_width, frame_height, format);
 
-            glBindVertexArray(m_VAO);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+            glCheckError();
+        }
+        else
+        {
+            exit_status = true;
+        }
+    }
 
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    void WindowProperties::image_show_regions(const uint8_t * data_ptr,
+                                              int frame_width,
+                                              int frame_height,
+                                              PixelFormat format,
+                                              const Rect* dirty_regions,
+                                              int region_count,
+                                              volatile bool & exit_status) noexcept
+    {
+        this->bind_context();
 
-            glBindTexture(GL_TEXTURE_2D, 0);
-            glUseProgram(0);
+        glCheckError();
 
-            glfwSwapBuffers(this->m_window);
+        if (!glfwWindowShouldClose(this->m_window))
+        {
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
+
+            this->m_frame_profiler.begin_stage(FrameStage::Upload);
+            const bool is_frame_changed = this->upload_frame_regions(data_ptr,
+                                                                     get_image_layout(format, frame_width, frame_height),
+                                                                     frame_width,
+                                                                     frame_height,
+                                                                     format,
+                                                                     dirty_regions,
+                                                                     region_count);
+            this->m_frame_profiler.end_stage();
+
+            this->present_frame(is_frame_changed);
 
             glCheckError();
         }
@@ -278,149 +576,2539 @@ namespace YB
         }
     }
 
-////////////////////////////////////////////////////////////////////////////////
-// Private Functions
-////////////////////////////////////////////////////////////////////////////////
-
-    void WindowProperties::set_window_properties() noexcept
+    bool WindowProperties::image_show_view(const FrameView& view,
+                                           volatile bool& exit_status) noexcept
     {
-        const float positions[16] =
-        {
-            //X    //Y   //U   //V 
-            -1.0f, -1.0f, 0.0f, 0.0f, // 0
-            1.0f, -1.0f, 1.0f, 0.0f, // 1
-            1.0f,  1.0f, 1.0f, 1.0f, // 2
-            -1.0f,  1.0f, 0.0f, 1.0f  // 3
-        };
+        ImageLayout layout{};
 
-        const uint32_t indices[] =
+        if (!get_view_layout(view, layout))
         {
-            0, 1, 2,
-            2, 3, 0
-        };
-
-        glGenVertexArrays(1, &m_VAO);
-        glGenBuffers(1, &m_VBO);
-        glBindVertexArray(m_VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferData(GL_ARRAY_BUFFER, 16 * sizeof(float), positions, GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+            return false;
+        }
 
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), reinterpret_cast<const void*>(2 * sizeof(float)));
-        
-        glGenBuffers(1, &m_IBO);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6 * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        const bool is_whole_buffer = view.region.width <= 0 || view.region.height <= 0;
+        const int frame_width = is_whole_buffer ? view.buffer_width : view.region.width;
+        const int frame_height = is_whole_buffer ? view.buffer_height : view.region.height;
 
-        m_shader_program = shader_create();
-        glUseProgram(m_shader_program);
+        this->bind_context();
 
-        glGenTextures(1, &m_texture_output);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_texture_output);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glBindTexture(GL_TEXTURE_2D, m_texture_output);
+        glCheckError();
 
-        m_location = glGetUniformLocation(m_shader_program, "t_Texture");
+        if (!glfwWindowShouldClose(this->m_window))
+        {
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
+
+            this->m_frame_profiler.begin_stage(FrameStage::Upload);
+            const bool is_frame_changed = this->upload_frame_regions(view.data_ptr,
+                                                                     layout,
+                                                                     frame_width,
+                                                                     frame_height,
+                                                                     view.format,
+                                                                     nullptr,
+                                                                     0);
+            this->m_frame_profiler.end_stage();
+
+            this->present_frame(is_frame_changed);
 
-        if (-1 == m_location)
+            glCheckError();
+        }
+        else
         {
-            printf("Uniform location could not find (texture).\n");
+            exit_status = true;
         }
 
-        glUniform1i(m_location, 0);
-
-        glBindVertexArray(0);
-        glUseProgram(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        return true;
     }
 
-    GLuint WindowProperties::shader_compile(uint32_t type,
-                                            const char *source)
+    void WindowProperties::image_show_generation(const uint8_t* data_ptr,
+                                                 int frame_width,
+                                                 int frame_height,
+                                                 PixelFormat format,
+                                                 uint64_t generation,
+                                                 volatile bool& exit_status) noexcept
     {
-        uint32_t id = glCreateShader(type);
-        glShaderSource(id, 1, &source, nullptr);
-        glCompileShader(id);
+        this->bind_context();
 
-        int result;
-        glGetShaderiv(id, GL_COMPILE_STATUS, &result);
+        glCheckError();
 
-        if (GL_FALSE == result)
+        if (!glfwWindowShouldClose(this->m_window))
         {
-            int length;
-            glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-            char* message = new char[length];
-            glGetShaderInfoLog(id, length, &length, message);
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
 
-            printf("\nFailed to compile Shader!\n%s\n", message);
-            glDeleteShader(id);
-            delete[] message;
-            
-            throw std::runtime_error("Failed to compile Shader!");
-        }
+            const ImageLayout layout = get_image_layout(format, frame_width, frame_height);
 
-        return id;
-    }
+            const bool is_resident = generation != 0
+                                     && generation == this->m_frame_generation
+                                     && this->has_texture_storage(frame_width, frame_height, format);
 
-    GLuint WindowProperties::shader_create() noexcept
-    {
-        GLuint program = glCreateProgram();
+            bool is_frame_changed = false;
 
-        m_vertex_shader_id = shader_compile(GL_VERTEX_SHADER, m_vertex_shader);
-        m_fragment_shader_id = shader_compile(GL_FRAGMENT_SHADER, m_fragment_shader);
+            this->m_frame_profiler.begin_stage(FrameStage::Upload);
 
-        glAttachShader(program, m_vertex_shader_id);
-        glAttachShader(program, m_fragment_shader_id);
-        glLinkProgram(program);
-        glValidateProgram(program);
+            if (is_resident)
+            {
+                // The textures already hold this generation, not a byte is read
+                this->m_dirty_regions.clear();
+                this->count_uploaded_bytes(layout);
+            }
+            else
+            {
+                is_frame_changed = this->upload_frame_regions(data_ptr,
+                                                              layout,
+                                                              frame_width,
+                                                              frame_height,
+                                                              format,
+                                                              nullptr,
+                                                              0);
+                this->m_frame_generation = generation;
+            }
 
-        glDeleteShader(m_vertex_shader_id);
-        glDeleteShader(m_fragment_shader_id);
+            this->m_frame_profiler.end_stage();
 
-        return program;
-    }
+            this->present_frame(is_frame_changed);
 
-    void WindowProperties::keyboard_callback(GLFWwindow* window,
-                                             int key,
-                                             int scancode,
-                                             int action,
-                                             int mode) noexcept
-    {
-        if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+            glCheckError();
+        }
+        else
         {
-            glfwSetWindowShouldClose(window, GL_TRUE);
+            exit_status = true;
         }
     }
 
-    void WindowProperties::resize_window(int width, int height) const noexcept
+    void WindowProperties::image_show_compressed(const uint8_t* data_ptr,
+                                                 int frame_width,
+                                                 int frame_height,
+                                                 CompressedFormat format,
+                                                 volatile bool& exit_status) noexcept
     {
-        glViewport(0, 0, width, height);
-    }
+        this->bind_context();
 
-    void WindowProperties::window_resize_callback(GLFWwindow* window,
-                                                  int width,
-                                                  int height) noexcept
-    {
-        // Retrieve the instance from the user pointer
-        WindowProperties* instance
-            = static_cast<WindowProperties*>(glfwGetWindowUserPointer(window));
+        glCheckError();
 
-        // Call the member function if the instance exists
-        if (instance)
+        if (!glfwWindowShouldClose(this->m_window))
         {
-            // Make the context for the window current
-            glfwMakeContextCurrent(window);
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
 
-            // Call the member function
-            instance->resize_window(width, height);
+            bool is_frame_changed = true;
+
+            this->m_frame_profiler.begin_stage(FrameStage::Upload);
+
+            if (this->is_compressed_upload_native(format))
+            {
+                this->upload_compressed_frame(data_ptr, frame_width, frame_height, format);
+            }
+            else
+            {
+                // Decoded frames are plain RGBA frames from here on,
+                // change detection and the upload ring apply to them.
+                this->m_decompressed_frame.resize(static_cast<size_t>(frame_width) * frame_height * 4);
+                decompress_image(data_ptr,
+                                 format,
+                                 frame_width,
+                                 frame_height,
+                                 this->m_decompressed_frame.data());
+
+                is_frame_changed = this->upload_frame_regions(this->m_decompressed_frame.data(),
+                                                              get_image_layout(PixelFormat::RGBA, frame_width, frame_height),
+                                                              frame_width,
+                                                              frame_height,
+                                                              PixelFormat::RGBA,
+                                                              nullptr,
+                                                              0);
+            }
+
+            this->m_frame_profiler.end_stage();
+
+            this->present_frame(is_frame_changed);
+
+            glCheckError();
+        }
+        else
+        {
+            exit_status = true;
+        }
+    }
+
+    void WindowProperties::refresh() noexcept
+    {
+        // Settings and the viewport are read by the draw, their flags stay set
+        const bool is_redraw_needed = this->m_needs_redraw.exchange(false, std::memory_order_acq_rel)
+                                      || this->m_is_display_dirty.load(std::memory_order_acquire)
+                                      || this->m_is_viewport_dirty.load(std::memory_order_acquire);
+
+        if (!is_redraw_needed)
+        {
+            return;
+        }
+
+        this->bind_context();
+
+        switch (this->m_shown_content)
+        {
+            case ShownContent::Frame:
+                this->draw_frame();
+            break;
+            case ShownContent::Tiles:
+                this->draw_tiles();
+            break;
+            case ShownContent::Mosaic:
+                this->draw_mosaic();
+            break;
+            default:
+                // Nothing was shown yet
+                return;
+        }
+
+        this->swap_buffers();
+    }
+
+    bool WindowProperties::set_tile_source(const TileSource& source, size_t memory_budget)
+    {
+        this->bind_context();
+
+        const bool is_configured = this->m_tile_cache.configure(source, memory_budget);
+
+        // Released tile textures can still be bound
+        this->m_gl_state.invalidate();
+
+        return is_configured;
+    }
+
+    void WindowProperties::tiled_image_show(volatile bool& exit_status)
+    {
+        this->bind_context();
+
+        glCheckError();
+
+        if (!glfwWindowShouldClose(this->m_window))
+        {
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
+
+            this->draw_tiles();
+            this->swap_buffers();
+
+            glCheckError();
+        }
+        else
+        {
+            exit_status = true;
+        }
+    }
+
+    bool WindowProperties::set_mosaic(const MosaicLayout& layout)
+    {
+        this->bind_context();
+
+        return this->m_mosaic.configure(layout, this->m_gl_state);
+    }
+
+    bool WindowProperties::update_mosaic_tile(int tile_index, const uint8_t* data_ptr) noexcept
+    {
+        this->bind_context();
+
+        this->m_frame_profiler.begin_stage(FrameStage::Upload);
+        const bool is_updated = this->m_mosaic.update_tile(tile_index, data_ptr, this->m_gl_state);
+        this->m_frame_profiler.end_stage();
+
+        return is_updated;
+    }
+
+    void WindowProperties::mosaic_show(volatile bool& exit_status)
+    {
+        this->bind_context();
+
+        glCheckError();
+
+        if (!glfwWindowShouldClose(this->m_window))
+        {
+            this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+            poll_events_without_pump();
+            this->m_frame_profiler.end_stage();
+
+            this->draw_mosaic();
+            this->swap_buffers();
+
+            glCheckError();
+        }
+        else
+        {
+            exit_status = true;
+        }
+    }
+
+    void WindowProperties::render_frame(const uint8_t* data_ptr,
+                                        int frame_width,
+                                        int frame_height,
+                                        PixelFormat format) noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Upload);
+        const bool is_frame_changed = this->upload_frame_regions(data_ptr,
+                                                                 get_image_layout(format, frame_width, frame_height),
+                                                                 frame_width,
+                                                                 frame_height,
+                                                                 format,
+                                                                 nullptr,
+                                                                 0);
+        this->m_frame_profiler.end_stage();
+
+        this->present_frame(is_frame_changed);
+    }
+
+    void WindowProperties::upload_frame(const uint8_t* data_ptr,
+                                        int frame_width,
+                                        int frame_height,
+                                        PixelFormat format) noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Upload);
+        this->upload_frame_regions(data_ptr,
+                                   get_image_layout(format, frame_width, frame_height),
+                                   frame_width,
+                                   frame_height,
+                                   format,
+                                   nullptr,
+                                   0);
+        this->m_frame_profiler.end_stage();
+    }
+
+    bool WindowProperties::upload_frame_regions(const uint8_t* data_ptr,
+                                                const ImageLayout& frame_layout,
+                                                int frame_width,
+                                                int frame_height,
+                                                PixelFormat format,
+                                                const Rect* dirty_regions,
+                                                int region_count) noexcept
+    {
+        if (0 == frame_layout.plane_count)
+        {
+            // The format can not store this size, the resident frame stays
+            return false;
+        }
+
+        // Frames passed without a generation can not be matched later
+        this->m_frame_generation = 0;
+
+        if (this->m_acquired_ptr)
+        {
+            // A frame passed by pointer replaces an acquired one
+            this->upload_from_pixel_buffer(false);
+            this->m_acquired_ptr = nullptr;
+        }
+
+        const bool is_reallocated = !this->has_texture_storage(frame_width, frame_height, format);
+
+        if (is_reallocated)
+        {
+            this->allocate_texture_storage(frame_width, frame_height, format);
+            this->m_change_detector.reset();
+        }
+
+        if (!is_same_storage(frame_layout, this->m_frame_layout))
+        {
+            // The detector's copy was taken with other offsets or pitches
+            this->m_change_detector.reset();
+            this->m_frame_layout = frame_layout;
+        }
+
+        this->update_auto_display_range(data_ptr,
+                                        frame_layout,
+                                        frame_width,
+                                        frame_height,
+                                        format);
+
+        this->m_dirty_regions.clear();
+
+        if (dirty_regions)
+        {
+            // The caller tracks changes, the detector's copy gets outdated
+            this->m_change_detector.reset();
+
+            if (is_reallocated)
+            {
+                this->m_dirty_regions.push_back({0, 0, frame_width, frame_height});
+            }
+
+            for (int idx = 0; idx < region_count && !is_reallocated; ++idx)
+            {
+                const Rect& region = dirty_regions[idx];
+
+                const int x_begin = std::max(region.x, 0);
+                const int y_begin = std::max(region.y, 0);
+                const int x_end = std::min(region.x + region.width, frame_width);
+                const int y_end = std::min(region.y + region.height, frame_height);
+
+                if (x_begin < x_end && y_begin < y_end)
+                {
+                    this->m_dirty_regions.push_back({x_begin,
+                                                     y_begin,
+                                                     x_end - x_begin,
+                                                     y_end - y_begin});
+                }
+            }
+        }
+        else if (this->m_is_change_detection_enabled.load(std::memory_order_relaxed))
+        {
+            this->m_change_detector.detect(data_ptr,
+                                           frame_layout,
+                                           frame_width,
+                                           frame_height,
+                                           this->m_dirty_regions);
+        }
+        else
+        {
+            this->m_change_detector.reset();
+            this->m_dirty_regions.push_back({0, 0, frame_width, frame_height});
+        }
+
+        this->count_uploaded_bytes(get_image_layout(format, frame_width, frame_height));
+
+        if (this->m_dirty_regions.empty())
+        {
+            // Nothing changed, the resident textures stay on screen
+            return false;
+        }
+
+        if (UploadMode::PixelBufferRing == this->m_upload_mode)
+        {
+            this->upload_with_pixel_buffer_ring(data_ptr, frame_layout);
+        }
+        else
+        {
+            // A buffer of the ring can still be bound from an acquired
+            // frame, the pointer would be read as an offset into it.
+            this->m_gl_state.bind_pixel_unpack_buffer(0);
+            this->upload_planes(data_ptr, frame_layout);
+        }
+
+        return true;
+    }
+
+    void WindowProperties::notify_redraw() noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_redraw_listener_mutex);
+
+        if (this->m_redraw_listener)
+        {
+            this->m_redraw_listener(this->m_redraw_listener_user_data);
+        }
+    }
+
+    void WindowProperties::present_frame(bool is_frame_changed) noexcept
+    {
+        const bool is_redraw_needed = this->m_needs_redraw.exchange(false, std::memory_order_acq_rel)
+                                      || this->m_is_display_dirty.load(std::memory_order_acquire)
+                                      || this->m_is_viewport_dirty.load(std::memory_order_acquire)
+                                      || ShownContent::Frame != this->m_shown_content
+                                      || this->m_frame_capture.is_active();
+
+        if (!is_frame_changed && !is_redraw_needed)
+        {
+            // The window already shows this frame, the draw and the swap
+            // would only reproduce it.
+            this->m_redundant_frame_count.fetch_add(1, std::memory_order_relaxed);
+            this->m_frame_profiler.discard_frame();
+            this->m_frame_pacer.skip_present();
+            return;
+        }
+
+        this->draw_frame();
+        this->swap_buffers();
+    }
+
+    void WindowProperties::draw_frame() noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Draw);
+
+        this->m_shown_content = ShownContent::Frame;
+
+        this->prepare_draw();
+
+        const ImageLayout layout = get_image_layout(this->m_texture_format,
+                                                    this->m_texture_width,
+                                                    this->m_texture_height);
+
+        float scale_x = 1.0f;
+        float scale_y = 1.0f;
+        this->get_view_scale(this->m_texture_width, this->m_texture_height, scale_x, scale_y);
+
+        // Only bars around the quad need clearing, bindings are left in
+        // place for the next frame.
+        if (scale_x < 1.0f || scale_y < 1.0f)
+        {
+            this->m_gl_state.count_calls();
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        this->update_mipmaps(layout,
+                             scale_x * this->m_viewport_width.load(std::memory_order_relaxed) < this->m_texture_width
+                             || scale_y * this->m_viewport_height.load(std::memory_order_relaxed) < this->m_texture_height);
+
+        this->bind_program(layout, false);
+
+        const float offset_x = get_view_offset(scale_x, this->m_center_x);
+        const float offset_y = get_view_offset(scale_y, this->m_center_y);
+
+        this->m_gl_state.set_uniform(this->m_view_location, scale_x, scale_y, offset_x, offset_y);
+        this->m_gl_state.set_uniform(this->m_texture_rect_location, 1.0f, 1.0f, 0.0f, 0.0f);
+        this->m_gl_state.set_uniform(this->m_grid_location, 1.0f, 1.0f);
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            this->m_gl_state.bind_texture(idx, GL_TEXTURE_2D, this->m_textures[idx]);
+        }
+
+        this->m_gl_state.count_calls();
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+
+        this->draw_overlay(this->m_texture_width,
+                           this->m_texture_height,
+                           scale_x,
+                           scale_y,
+                           offset_x,
+                           offset_y);
+
+        this->m_frame_profiler.end_stage();
+    }
+
+    void WindowProperties::swap_buffers() noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Swap);
+
+        // The back buffer is read before it is presented and becomes undefined
+        this->m_frame_capture.capture(this->m_gl_state);
+
+        this->m_frame_pacer.begin_swap();
+
+        if (SurfaceMode::Offscreen == this->m_surface_mode)
+        {
+            glFlush();
+        }
+        else
+        {
+            glfwSwapBuffers(this->m_window);
+        }
+
+        this->m_frame_pacer.end_swap();
+
+        this->m_gl_state.count_calls();
+
+        uint32_t call_count = 0;
+        uint32_t skipped_call_count = 0;
+        this->m_gl_state.take_call_counts(call_count, skipped_call_count);
+        this->m_gl_call_count.store(call_count, std::memory_order_relaxed);
+        this->m_gl_skipped_call_count.store(skipped_call_count, std::memory_order_relaxed);
+
+        this->m_frame_profiler.end_stage();
+        this->m_frame_profiler.end_frame();
+
+        // Waiting for the next frame is not part of presenting this one
+        this->m_frame_pacer.delay_next_frame();
+    }
+
+    void WindowProperties::set_swap_interval(int interval) noexcept
+    {
+        this->m_frame_pacer.set_swap_interval(interval);
+    }
+
+    void WindowProperties::set_grouped(bool is_grouped) noexcept
+    {
+        this->m_frame_pacer.set_grouped(is_grouped);
+    }
+
+    uint8_t* WindowProperties::acquire_frame(int frame_width,
+                                             int frame_height,
+                                             PixelFormat format) noexcept
+    {
+        if (0 == get_image_layout(format, frame_width, frame_height).plane_count)
+        {
+            return nullptr;
+        }
+
+        this->bind_context();
+
+        const bool is_layout_changed = !this->has_texture_storage(frame_width, frame_height, format);
+
+        if (this->m_acquired_ptr)
+        {
+            if (!is_layout_changed)
+            {
+                return this->m_acquired_ptr;
+            }
+
+            // Hand the outdated buffer back before the layout changes
+            this->upload_from_pixel_buffer(false);
+            this->m_acquired_ptr = nullptr;
+        }
+
+        if (is_layout_changed)
+        {
+            this->allocate_texture_storage(frame_width, frame_height, format);
+        }
+
+        // The buffer is written in place, its content has no generation
+        this->m_frame_generation = 0;
+
+        // A buffer which failed to map stays in the ring for the next call
+        this->m_acquired_ptr = this->map_next_pixel_buffer();
+
+        return this->m_acquired_ptr;
+    }
+
+    void WindowProperties::submit_acquired_frame(volatile bool& exit_status) noexcept
+    {
+        this->bind_context();
+
+        if (glfwWindowShouldClose(this->m_window))
+        {
+            exit_status = true;
+            return;
+        }
+
+        this->m_frame_profiler.begin_stage(FrameStage::PollEvents);
+        poll_events_without_pump();
+        this->m_frame_profiler.end_stage();
+
+        const bool is_frame_changed = nullptr != this->m_acquired_ptr;
+
+        if (this->m_acquired_ptr)
+        {
+            this->m_frame_profiler.begin_stage(FrameStage::Upload);
+
+            const ImageLayout layout = get_image_layout(this->m_texture_format,
+                                                        this->m_texture_width,
+                                                        this->m_texture_height);
+
+            // The mapping is write-only and reading it back can be
+            // uncached, so the automatic display range keeps the value
+            // of the last frame passed by pointer.
+
+            // The frame was written in place, the whole of it is new
+            this->m_change_detector.reset();
+            this->m_dirty_regions.assign(1, {0,
+                                             0,
+                                             this->m_texture_width,
+                                             this->m_texture_height});
+
+            this->count_uploaded_bytes(layout);
+
+            this->upload_from_pixel_buffer(true);
+            this->m_acquired_ptr = nullptr;
+
+            this->m_frame_profiler.end_stage();
+        }
+
+        this->present_frame(is_frame_changed);
+
+        glCheckError();
+    }
+
+    void WindowProperties::set_display_range(float minimum, float maximum) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_display_minimum = minimum;
+            this->m_display_maximum = maximum;
+            this->m_has_display_range = true;
+            this->m_is_auto_display_range = false;
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_auto_display_range() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_is_auto_display_range = true;
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_colormap(Colormap colormap)
+    {
+        std::vector<uint8_t> entries = make_colormap(colormap);
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_pending_colormap = std::move(entries);
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_view(float zoom, float center_x, float center_y) noexcept
+    {
+        if (!(zoom > 0.0f))
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_display_zoom = zoom;
+            this->m_display_center_x = std::min(std::max(center_x, 0.0f), 1.0f);
+            this->m_display_center_y = std::min(std::max(center_y, 0.0f), 1.0f);
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_aspect_mode(AspectMode aspect_mode) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_display_aspect_mode = aspect_mode;
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_overlay(const Overlay& overlay)
+    {
+        // Primitives are converted before taking the lock the drawing thread waits on
+        std::vector<OverlayInstance> instances;
+        append_overlay_instances(overlay, instances);
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_pending_overlay.swap(instances);
+            this->m_has_pending_overlay = true;
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_custom_colormap(const uint8_t* rgba_entries,
+                                               int entry_count)
+    {
+        if (!rgba_entries || entry_count < 2)
+        {
+            return;
+        }
+
+        std::vector<uint8_t> entries(rgba_entries, rgba_entries + 4 * entry_count);
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_pending_colormap = std::move(entries);
+            this->m_is_display_dirty.store(true, std::memory_order_release);
+        }
+
+        this->notify_redraw();
+    }
+
+    void WindowProperties::set_change_detection(bool is_enabled) noexcept
+    {
+        this->m_is_change_detection_enabled.store(is_enabled, std::memory_order_relaxed);
+    }
+
+    void WindowProperties::set_compressed_upload(CompressedUpload compressed_upload) noexcept
+    {
+        this->m_compressed_upload.store(compressed_upload, std::memory_order_relaxed);
+    }
+
+    bool WindowProperties::is_compressed_upload_native(CompressedFormat format) const noexcept
+    {
+        if (!is_compressed_format_supported(format))
+        {
+            return false;
+        }
+
+        switch (this->m_compressed_upload.load(std::memory_order_relaxed))
+        {
+            case CompressedUpload::Native:
+                return true;
+            case CompressedUpload::Decode:
+                return false;
+            default:
+                // Software rasterizers decode the blocks on every texture
+                // fetch, BC7 drops to a few frames per second
+                return !GLExtensions::is_software_renderer;
+        }
+    }
+
+    UploadStatistics WindowProperties::get_upload_statistics() const noexcept
+    {
+        return {this->m_uploaded_bytes.load(std::memory_order_relaxed),
+                this->m_skipped_bytes.load(std::memory_order_relaxed)};
+    }
+
+    bool WindowProperties::pop_event(WindowEvent& event) noexcept
+    {
+        return this->m_events.pop(event);
+    }
+
+    FrameStatistics WindowProperties::get_frame_statistics() const noexcept
+    {
+        FrameStatistics statistics = this->m_frame_profiler.get_statistics();
+        statistics.gl_call_count = this->m_gl_call_count.load(std::memory_order_relaxed);
+        statistics.gl_skipped_call_count = this->m_gl_skipped_call_count.load(std::memory_order_relaxed);
+        statistics.redundant_frame_count = this->m_redundant_frame_count.load(std::memory_order_relaxed);
+        statistics.dropped_event_count = this->m_dropped_event_count.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    bool WindowProperties::read_pixels(uint8_t* rgba_ptr) noexcept
+    {
+        if (SurfaceMode::Offscreen != this->m_surface_mode || !rgba_ptr)
+        {
+            return false;
+        }
+
+        this->bind_context();
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, this->m_framebuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0,
+                     0,
+                     this->m_surface_width,
+                     this->m_surface_height,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     rgba_ptr);
+
+        // OpenGL returns the bottom row first. Rows are swapped in place,
+        // no scratch row is allocated per call.
+        const size_t row_size = static_cast<size_t>(this->m_surface_width) * 4;
+
+        for (int top = 0, bottom = this->m_surface_height - 1; top < bottom; ++top, --bottom)
+        {
+            uint8_t* top_row = rgba_ptr + top * row_size;
+            uint8_t* bottom_row = rgba_ptr + bottom * row_size;
+
+            std::swap_ranges(top_row, top_row + row_size, bottom_row);
+        }
+
+        glCheckError();
+
+        return true;
+    }
+
+    bool WindowProperties::start_capture(const CaptureSettings& settings)
+    {
+        return this->m_frame_capture.start(settings);
+    }
+
+    void WindowProperties::flush_capture() noexcept
+    {
+        this->bind_context();
+
+        this->m_frame_capture.flush();
+    }
+
+    void WindowProperties::stop_capture() noexcept
+    {
+        this->m_frame_capture.stop();
+    }
+
+    CaptureStatistics WindowProperties::get_capture_statistics() const noexcept
+    {
+        return this->m_frame_capture.get_statistics();
+    }
+
+    void WindowProperties::set_pacing(const PacingSettings& settings) noexcept
+    {
+        this->m_frame_pacer.set_settings(settings);
+    }
+
+    PacingStatistics WindowProperties::get_pacing_statistics() const noexcept
+    {
+        return this->m_frame_pacer.get_statistics();
+    }
+
+    void WindowProperties::make_context_current() noexcept
+    {
+        this->bind_context();
+    }
+
+    void WindowProperties::release_context() noexcept
+    {
+        if (glfwGetCurrentContext() == this->m_window)
+        {
+            glfwMakeContextCurrent(nullptr);
+        }
+    }
+
+    void WindowProperties::set_redraw_listener(RedrawListener listener, void* user_data) noexcept
+    {
+        std::lock_guard<std::mutex> lock(this->m_redraw_listener_mutex);
+
+        this->m_redraw_listener = listener;
+        this->m_redraw_listener_user_data = user_data;
+    }
+
+    bool WindowProperties::should_close() const noexcept
+    {
+        return glfwWindowShouldClose(this->m_window);
+    }
+
+    void WindowProperties::poll_events() noexcept
+    {
+        if (m_glfw_user_count > 0)
+        {
+            glfwPollEvents();
+        }
+    }
+
+    void WindowProperties::poll_events_without_pump() noexcept
+    {
+        if (!m_has_event_pump.load(std::memory_order_acquire))
+        {
+            glfwPollEvents();
+        }
+    }
+
+    void WindowProperties::wait_events(double timeout_seconds) noexcept
+    {
+        if (m_glfw_user_count > 0)
+        {
+            glfwWaitEventsTimeout(timeout_seconds);
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(timeout_seconds));
+        }
+    }
+
+    void WindowProperties::wake_event_wait() noexcept
+    {
+        if (m_glfw_user_count > 0)
+        {
+            glfwPostEmptyEvent();
+        }
+    }
+
+    bool WindowProperties::set_event_pump(bool has_event_pump) noexcept
+    {
+        bool expected = !has_event_pump;
+
+        return m_has_event_pump.compare_exchange_strong(expected,
+                                                        has_event_pump,
+                                                        std::memory_order_acq_rel);
+    }
+
+    void WindowProperties::set_debug_logger(DebugLogger logger, void* user_data) noexcept
+    {
+        m_debug_logger = logger;
+        m_debug_logger_user_data = user_data;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Functions
+////////////////////////////////////////////////////////////////////////////////
+
+    void WindowProperties::check_gl_error(const char* file, int line) const noexcept
+    {
+        if (this->m_is_debug_output_enabled)
+        {
+            return;
+        }
+
+        GLenum error_code;
+        while ((error_code = glGetError()) != GL_NO_ERROR)
+        {
+            const char* error = "UNKNOWN";
+            switch (error_code)
+            {
+                case GL_INVALID_ENUM:
+                    error = "INVALID_ENUM";
+                break;
+                case GL_INVALID_VALUE:
+                    error = "INVALID_VALUE";
+                break;
+                case GL_INVALID_OPERATION:
+                    error = "INVALID_OPERATION";
+                break;
+                case GL_STACK_OVERFLOW:
+                    error = "STACK_OVERFLOW";
+                break;
+                case GL_STACK_UNDERFLOW:
+                    error = "STACK_UNDERFLOW";
+                break;
+                case GL_OUT_OF_MEMORY:
+                    error = "OUT_OF_MEMORY";
+                break;
+                case GL_INVALID_FRAMEBUFFER_OPERATION:
+                    error = "INVALID_FRAMEBUFFER_OPERATION";
+                break;
+                default:
+                    break;
+            }
+
+            char message[512];
+            std::snprintf(message,
+                          sizeof(message),
+                          "%s - error code: %u | %s (%d)",
+                          error,
+                          error_code,
+                          file,
+                          line);
+
+            log_message(DebugSeverity::High, message);
+        }
+    }
+
+    bool WindowProperties::enable_debug_output() noexcept
+    {
+        if (!m_debug_logger || !GLExtensions::debug_message_callback)
+        {
+            return false;
+        }
+
+        // Asynchronous output, the driver does not have to finish each call
+        // before reporting, so it costs nothing on the render path.
+        glEnable(GL_DEBUG_OUTPUT);
+        GLExtensions::debug_message_callback(debug_message_callback, nullptr);
+
+        return true;
+    }
+
+    void WindowProperties::log_message(DebugSeverity severity, const char* message) noexcept
+    {
+        if (m_debug_logger)
+        {
+            m_debug_logger(severity, message, m_debug_logger_user_data);
+        }
+        else
+        {
+            std::cout << message << "\n";
+        }
+    }
+
+    void APIENTRY WindowProperties::debug_message_callback(GLenum /*source*/,
+                                                           GLenum /*type*/,
+                                                           GLuint /*id*/,
+                                                           GLenum severity,
+                                                           GLsizei /*length*/,
+                                                           const GLchar* message,
+                                                           const void* /*user_data*/)
+    {
+        DebugSeverity debug_severity = DebugSeverity::Notification;
+
+        switch (severity)
+        {
+            case GL_DEBUG_SEVERITY_HIGH:
+                debug_severity = DebugSeverity::High;
+            break;
+            case GL_DEBUG_SEVERITY_MEDIUM:
+                debug_severity = DebugSeverity::Medium;
+            break;
+            case GL_DEBUG_SEVERITY_LOW:
+                debug_severity = DebugSeverity::Low;
+            break;
+            default:
+                break;
+        }
+
+        log_message(debug_severity, message);
+    }
+
+    void WindowProperties::create_shared_resources() noexcept
+    {
+        const float positions[16] =
+        {
+            //X    //Y   //U   //V 
+            -1.0f, -1.0f, 0.0f, 0.0f, // 0
+            1.0f, -1.0f, 1.0f, 0.0f, // 1
+            1.0f,  1.0f, 1.0f, 1.0f, // 2
+            -1.0f,  1.0f, 0.0f, 1.0f  // 3
+        };
+
+        const uint32_t indices[] =
+        {
+            0, 1, 2,
+            2, 3, 0
+        };
+
+        glGenBuffers(1, &m_VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        glBufferData(GL_ARRAY_BUFFER, 16 * sizeof(float), positions, GL_STATIC_DRAW);
+
+        // There is no vertex array in the resource context to hold an element
+        // buffer binding, buffers are typeless so it is filled as an array buffer.
+        glGenBuffers(1, &m_IBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_IBO);
+        glBufferData(GL_ARRAY_BUFFER, 6 * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+
+        // Programs are linked per window, only the compiled shaders are shared
+        m_vertex_shader_id = shader_compile(GL_VERTEX_SHADER, m_vertex_shader);
+        m_fragment_shader_id = shader_compile(GL_FRAGMENT_SHADER, m_fragment_shader);
+
+        m_overlay_vertex_shader_id = shader_compile(GL_VERTEX_SHADER, m_overlay_vertex_shader);
+        m_overlay_fragment_shader_id = shader_compile(GL_FRAGMENT_SHADER, m_overlay_fragment_shader);
+
+        const std::vector<uint8_t> glyph_atlas = make_glyph_atlas();
+
+        glGenTextures(1, &m_glyph_atlas_texture);
+        glBindTexture(GL_TEXTURE_2D, m_glyph_atlas_texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D,
+                     0,
+                     GL_R8,
+                     glyph_atlas_columns * glyph_size,
+                     glyph_atlas_rows * glyph_size,
+                     0,
+                     GL_RED,
+                     GL_UNSIGNED_BYTE,
+                     glyph_atlas.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glUseProgram(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // Objects created here must be complete before other contexts use them
+        glFinish();
+    }
+
+    void WindowProperties::release_shared_resources() noexcept
+    {
+        if (m_VBO != 0)
+        {
+            glDeleteBuffers(1, &m_VBO);
+            m_VBO = 0;
+        }
+        if (m_IBO != 0)
+        {
+            glDeleteBuffers(1, &m_IBO);
+            m_IBO = 0;
+        }
+
+        if (m_vertex_shader_id != 0)
+        {
+            glDeleteShader(m_vertex_shader_id);
+            glDeleteShader(m_fragment_shader_id);
+            m_vertex_shader_id = 0;
+            m_fragment_shader_id = 0;
+        }
+
+        if (m_overlay_vertex_shader_id != 0)
+        {
+            glDeleteShader(m_overlay_vertex_shader_id);
+            glDeleteShader(m_overlay_fragment_shader_id);
+            m_overlay_vertex_shader_id = 0;
+            m_overlay_fragment_shader_id = 0;
+        }
+
+        if (m_glyph_atlas_texture != 0)
+        {
+            glDeleteTextures(1, &m_glyph_atlas_texture);
+            m_glyph_atlas_texture = 0;
+        }
+    }
+
+    void WindowProperties::set_context_hints() noexcept
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        glfwWindowHint(GLFW_SRGB_CAPABLE, GLFW_TRUE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        // Drivers only report everything through debug output in debug contexts
+        glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, m_debug_logger ? GLFW_TRUE : GLFW_FALSE);
+
+        // Hints persist between windows, visible ones use the native API
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API,
+                       m_is_glfw_headless ? GLFW_OSMESA_CONTEXT_API : GLFW_NATIVE_CONTEXT_API);
+    }
+
+    void WindowProperties::create_vertex_array() noexcept
+    {
+        glGenVertexArrays(1, &this->m_VAO);
+        glBindVertexArray(this->m_VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), reinterpret_cast<const void*>(2 * sizeof(float)));
+
+        // The element buffer binding is recorded in the vertex array
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void WindowProperties::create_shader_program() noexcept
+    {
+        this->m_shader_program = shader_link(m_vertex_shader_id, m_fragment_shader_id);
+        glUseProgram(this->m_shader_program);
+
+        this->m_location = glGetUniformLocation(this->m_shader_program, "t_Texture");
+
+        if (-1 == this->m_location)
+        {
+            printf("Uniform location could not find (texture).\n");
+        }
+
+        glUniform1i(this->m_location, 0);
+
+        this->m_plane1_location = glGetUniformLocation(this->m_shader_program, "t_Plane1");
+        this->m_plane2_location = glGetUniformLocation(this->m_shader_program, "t_Plane2");
+        this->m_sampling_layout_location = glGetUniformLocation(this->m_shader_program, "u_sampling_layout");
+        this->m_colormap_location = glGetUniformLocation(this->m_shader_program, "t_Colormap");
+        this->m_value_range_location = glGetUniformLocation(this->m_shader_program, "u_value_range");
+        this->m_view_location = glGetUniformLocation(this->m_shader_program, "u_view");
+        this->m_texture_rect_location = glGetUniformLocation(this->m_shader_program, "u_texture_rect");
+        this->m_layers_location = glGetUniformLocation(this->m_shader_program, "t_Layers");
+        this->m_is_layered_location = glGetUniformLocation(this->m_shader_program, "u_is_layered");
+        this->m_grid_location = glGetUniformLocation(this->m_shader_program, "u_grid");
+
+        // Planes of multi-plane formats are bound to consecutive texture units
+        glUniform1i(this->m_plane1_location, 1);
+        glUniform1i(this->m_plane2_location, 2);
+        glUniform1i(this->m_colormap_location, 3);
+        glUniform4f(this->m_view_location, 1.0f, 1.0f, 0.0f, 0.0f);
+        glUniform4f(this->m_texture_rect_location, 1.0f, 1.0f, 0.0f, 0.0f);
+        glUniform1i(this->m_layers_location, MosaicTexture::texture_unit);
+        glUniform1i(this->m_is_layered_location, 0);
+        glUniform2f(this->m_grid_location, 1.0f, 1.0f);
+
+        glUseProgram(0);
+    }
+
+    void WindowProperties::bind_context() noexcept
+    {
+        // Switching contexts flushes the previous one, skip it when possible
+        if (glfwGetCurrentContext() != this->m_window)
+        {
+            glfwMakeContextCurrent(this->m_window);
+        }
+    }
+
+    bool WindowProperties::acquire_glfw(bool is_offscreen) noexcept
+    {
+        if (0 == m_glfw_user_count.load(std::memory_order_acquire))
+        {
+            m_is_glfw_headless = is_offscreen && select_headless_platform();
+
+            if (!glfwInit())
+            {
+                return false;
+            }
+
+            set_context_hints();
+
+            m_resource_window = glfwCreateWindow(1, 1, "", nullptr, nullptr);
+
+            if (!m_resource_window)
+            {
+                glfwTerminate();
+                return false;
+            }
+
+            glfwMakeContextCurrent(m_resource_window);
+
+            if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)))
+            {
+                glfwDestroyWindow(m_resource_window);
+                m_resource_window = nullptr;
+                glfwTerminate();
+                return false;
+            }
+
+            GLExtensions::load();
+            (void)enable_debug_output();
+
+            create_shared_resources();
+
+            glfwMakeContextCurrent(nullptr);
+        }
+
+        m_glfw_user_count.fetch_add(1, std::memory_order_acq_rel);
+
+        return true;
+    }
+
+    void WindowProperties::release_glfw() noexcept
+    {
+        // Terminating destroys every window, so only the last one may do it
+        if (1 == m_glfw_user_count.fetch_sub(1, std::memory_order_acq_rel))
+        {
+            glfwMakeContextCurrent(m_resource_window);
+            release_shared_resources();
+            glfwMakeContextCurrent(nullptr);
+
+            glfwDestroyWindow(m_resource_window);
+            m_resource_window = nullptr;
+
+            glfwTerminate();
+        }
+    }
+
+    bool WindowProperties::select_headless_platform() noexcept
+    {
+#if defined(GLFW_PLATFORM_NULL) && defined(__linux__)
+        // With a display server (or Xvfb) a hidden native window is enough
+        if (std::getenv("DISPLAY") || std::getenv("WAYLAND_DISPLAY"))
+        {
+            return false;
+        }
+
+        if (GLFW_TRUE == glfwPlatformSupported(GLFW_PLATFORM_NULL))
+        {
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    void WindowProperties::create_offscreen_framebuffer(int width, int height)
+    {
+        glGenRenderbuffers(1, &this->m_color_renderbuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, this->m_color_renderbuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &this->m_framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, this->m_framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                  GL_COLOR_ATTACHMENT0,
+                                  GL_RENDERBUFFER,
+                                  this->m_color_renderbuffer);
+
+        if (GL_FRAMEBUFFER_COMPLETE != glCheckFramebufferStatus(GL_FRAMEBUFFER))
+        {
+            throw std::runtime_error("Could not create the offscreen framebuffer");
+        }
+
+        glViewport(0, 0, width, height);
+    }
+
+    GLuint WindowProperties::create_texture(int level_count) noexcept
+    {
+        GLuint texture = 0;
+
+        glGenTextures(1, &texture);
+        this->m_gl_state.bind_texture(0, GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+
+        return texture;
+    }
+
+    void WindowProperties::allocate_texture_storage(int frame_width,
+                                                    int frame_height,
+                                                    PixelFormat format) noexcept
+    {
+        const ImageLayout layout = get_image_layout(format,
+                                                    frame_width,
+                                                    frame_height);
+
+        // Immutable storage can not be re-specified, so textures are
+        // re-created whenever the resolution or the format changes.
+        glDeleteTextures(m_max_plane_count, this->m_textures);
+
+        for (GLuint& texture : this->m_textures)
+        {
+            texture = 0;
+        }
+
+        // Deleting unbinds the textures and their names are reused
+        this->m_gl_state.invalidate();
+
+        // Storage is specified from client memory
+        this->m_gl_state.bind_pixel_unpack_buffer(0);
+
+        // Mipmaps are built only while the image is minified. Packed 4:2:2
+        // is fetched texel by texel, so it never samples other levels.
+        const bool has_mipmaps = SamplingLayout::PackedYuyv != layout.sampling_layout;
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            const PlaneLayout& plane = layout.planes[idx];
+
+            int level_count = 1;
+
+            if (has_mipmaps)
+            {
+                for (int size = std::max(plane.width, plane.height); size > 1; size /= 2)
+                {
+                    ++level_count;
+                }
+            }
+
+            this->m_textures[idx] = create_texture(level_count);
+
+            if (GLExtensions::tex_storage_2d)
+            {
+                GLExtensions::tex_storage_2d(GL_TEXTURE_2D,
+                                             level_count,
+                                             plane.internal_format,
+                                             plane.width,
+                                             plane.height);
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D,
+                             0,
+                             plane.internal_format,
+                             plane.width,
+                             plane.height,
+                             0,
+                             plane.upload_format,
+                             plane.upload_type,
+                             nullptr);
+            }
+        }
+
+        this->m_is_mipmap_filter = false;
+        this->m_are_mipmaps_dirty = false;
+
+        this->m_texture_width = frame_width;
+        this->m_texture_height = frame_height;
+        this->m_texture_format = format;
+        this->m_is_texture_compressed = false;
+    }
+
+    bool WindowProperties::has_texture_storage(int frame_width,
+                                              int frame_height,
+                                              PixelFormat format) const noexcept
+    {
+        return frame_width == this->m_texture_width
+               && frame_height == this->m_texture_height
+               && format == this->m_texture_format
+               && !this->m_is_texture_compressed;
+    }
+
+    void WindowProperties::allocate_compressed_storage(int frame_width,
+                                                       int frame_height,
+                                                       CompressedFormat format) noexcept
+    {
+        const CompressedLayout layout = get_compressed_layout(format,
+                                                              frame_width,
+                                                              frame_height);
+
+        glDeleteTextures(m_max_plane_count, this->m_textures);
+
+        for (GLuint& texture : this->m_textures)
+        {
+            texture = 0;
+        }
+
+        this->m_gl_state.invalidate();
+        this->m_gl_state.bind_pixel_unpack_buffer(0);
+
+        this->m_textures[0] = create_texture(1);
+
+        if (GLExtensions::tex_storage_2d)
+        {
+            GLExtensions::tex_storage_2d(GL_TEXTURE_2D,
+                                         1,
+                                         layout.internal_format,
+                                         frame_width,
+                                         frame_height);
+        }
+        else
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D,
+                                   0,
+                                   layout.internal_format,
+                                   frame_width,
+                                   frame_height,
+                                   0,
+                                   static_cast<GLsizei>(layout.image_size),
+                                   nullptr);
+        }
+
+        this->m_is_mipmap_filter = false;
+        this->m_are_mipmaps_dirty = false;
+
+        // Drawn like an RGBA frame, the texture unit decodes the blocks
+        this->m_texture_width = frame_width;
+        this->m_texture_height = frame_height;
+        this->m_texture_format = PixelFormat::RGBA;
+        this->m_is_texture_compressed = true;
+        this->m_texture_compression = format;
+    }
+
+    void WindowProperties::upload_compressed_frame(const uint8_t* data_ptr,
+                                                   int frame_width,
+                                                   int frame_height,
+                                                   CompressedFormat format) noexcept
+    {
+        this->m_frame_generation = 0;
+
+        if (this->m_acquired_ptr)
+        {
+            this->upload_from_pixel_buffer(false);
+            this->m_acquired_ptr = nullptr;
+        }
+
+        if (frame_width != this->m_texture_width
+            || frame_height != this->m_texture_height
+            || !this->m_is_texture_compressed
+            || format != this->m_texture_compression)
+        {
+            this->allocate_compressed_storage(frame_width, frame_height, format);
+        }
+
+        // Blocks are not compared, the next uncompressed frame starts over
+        this->m_change_detector.reset();
+        this->m_dirty_regions.assign(1, {0, 0, frame_width, frame_height});
+
+        const CompressedLayout layout = get_compressed_layout(format,
+                                                              frame_width,
+                                                              frame_height);
+
+        this->m_uploaded_bytes.fetch_add(layout.image_size, std::memory_order_relaxed);
+
+        // Block sizes stay 0, so the unpack row length and skips are ignored
+        this->m_gl_state.bind_pixel_unpack_buffer(0);
+        this->m_gl_state.bind_texture(0, GL_TEXTURE_2D, this->m_textures[0]);
+
+        this->m_gl_state.count_calls();
+        glCompressedTexSubImage2D(GL_TEXTURE_2D,
+                                  0,
+                                  0,
+                                  0,
+                                  frame_width,
+                                  frame_height,
+                                  layout.internal_format,
+                                  static_cast<GLsizei>(layout.image_size),
+                                  data_ptr);
+    }
+
+    void WindowProperties::prepare_draw() noexcept
+    {
+        this->m_gl_state.bind_framebuffer(this->m_framebuffer);
+
+        if (this->m_is_viewport_dirty.exchange(false, std::memory_order_acquire))
+        {
+            this->m_gl_state.count_calls();
+            glViewport(0,
+                       0,
+                       this->m_viewport_width.load(std::memory_order_relaxed),
+                       this->m_viewport_height.load(std::memory_order_relaxed));
+        }
+
+        if (this->m_is_display_dirty.exchange(false, std::memory_order_acquire))
+        {
+            this->apply_display_settings();
+        }
+    }
+
+    void WindowProperties::get_view_scale(int image_width,
+                                          int image_height,
+                                          float& scale_x,
+                                          float& scale_y) const noexcept
+    {
+        const int viewport_width = this->m_viewport_width.load(std::memory_order_relaxed);
+        const int viewport_height = this->m_viewport_height.load(std::memory_order_relaxed);
+
+        // Zoom, pan and letterbox scale and move the quad in clip space
+        scale_x = this->m_zoom;
+        scale_y = this->m_zoom;
+
+        if (AspectMode::Letterbox == this->m_aspect_mode
+            && viewport_width > 0
+            && viewport_height > 0
+            && image_height > 0)
+        {
+            const float image_aspect = static_cast<float>(image_width) / image_height;
+            const float viewport_aspect = static_cast<float>(viewport_width) / viewport_height;
+
+            if (image_aspect > viewport_aspect)
+            {
+                scale_y *= viewport_aspect / image_aspect;
+            }
+            else
+            {
+                scale_x *= image_aspect / viewport_aspect;
+            }
+        }
+    }
+
+    void WindowProperties::bind_program(const ImageLayout& layout, bool is_layered) noexcept
+    {
+        // The program belongs to this window, the cached uniforms stay valid
+        this->m_gl_state.use_program(this->m_shader_program);
+
+        this->m_gl_state.set_uniform(this->m_sampling_layout_location,
+                                     static_cast<GLint>(layout.sampling_layout));
+        this->m_gl_state.set_uniform(this->m_is_layered_location, is_layered ? 1 : 0);
+
+        if (SamplingLayout::Scalar == layout.sampling_layout)
+        {
+            float minimum = layout.default_minimum;
+            float maximum = layout.default_maximum;
+
+            if (this->m_use_auto_display_range)
+            {
+                minimum = this->m_auto_minimum;
+                maximum = this->m_auto_maximum;
+            }
+            else if (this->m_use_display_range)
+            {
+                minimum = this->m_level_minimum;
+                maximum = this->m_level_maximum;
+            }
+
+            // The shader samples normalized values for integer formats
+            const float scaled_minimum = minimum * layout.value_scale;
+            const float scaled_range = (maximum - minimum) * layout.value_scale;
+
+            this->m_gl_state.set_uniform(this->m_value_range_location,
+                                         scaled_minimum,
+                                         scaled_range > 0.0f ? 1.0f / scaled_range : 0.0f);
+
+            this->m_gl_state.bind_texture(3, GL_TEXTURE_1D, this->m_colormap_texture);
+        }
+
+        this->m_gl_state.bind_vertex_array(this->m_VAO);
+    }
+
+    void WindowProperties::draw_tiles() noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Upload);
+
+        this->m_shown_content = ShownContent::Tiles;
+
+        this->prepare_draw();
+
+        // Tiles which are not resident yet leave holes
+        this->m_gl_state.count_calls();
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        const TileSource& source = this->m_tile_cache.get_source();
+        const int viewport_width = this->m_viewport_width.load(std::memory_order_relaxed);
+        const int viewport_height = this->m_viewport_height.load(std::memory_order_relaxed);
+
+        this->m_tile_draws.clear();
+        this->m_fallback_tile_draws.clear();
+
+        if (!this->m_tile_cache.is_enabled() || viewport_width <= 0 || viewport_height <= 0)
+        {
+            this->m_frame_profiler.end_stage();
+            return;
+        }
+
+        float scale_x = 1.0f;
+        float scale_y = 1.0f;
+        this->get_view_scale(source.width, source.height, scale_x, scale_y);
+
+        const float offset_x = get_view_offset(scale_x, this->m_center_x);
+        const float offset_y = get_view_offset(scale_y, this->m_center_y);
+
+        // Coarsest level which still has a texel for every window pixel
+        const float texels_per_pixel = std::max(source.width / (scale_x * viewport_width),
+                                                source.height / (scale_y * viewport_height));
+        int level = 0;
+
+        while (level + 1 < source.level_count
+               && texels_per_pixel >= static_cast<float>(2 << level))
+        {
+            ++level;
+        }
+
+        // Visible part of the image, 0 to 1 from the first column and row
+        const float u_begin = std::max(0.5f * ((-1.0f - offset_x) / scale_x + 1.0f), 0.0f);
+        const float u_end = std::min(0.5f * ((1.0f - offset_x) / scale_x + 1.0f), 1.0f);
+        const float v_begin = std::max(0.5f * ((-1.0f - offset_y) / scale_y + 1.0f), 0.0f);
+        const float v_end = std::min(0.5f * ((1.0f - offset_y) / scale_y + 1.0f), 1.0f);
+
+        const int level_width = TileCache::get_level_size(source.width, level);
+        const int level_height = TileCache::get_level_size(source.height, level);
+        const int tile_size = source.tile_size;
+
+        const int tile_x_begin = static_cast<int>(u_begin * level_width) / tile_size;
+        const int tile_y_begin = static_cast<int>(v_begin * level_height) / tile_size;
+        const int tile_x_end = std::min(static_cast<int>(std::ceil(u_end * level_width)) + tile_size - 1,
+                                        level_width + tile_size - 1) / tile_size;
+        const int tile_y_end = std::min(static_cast<int>(std::ceil(v_end * level_height)) + tile_size - 1,
+                                        level_height + tile_size - 1) / tile_size;
+
+        const uint64_t frame_index = ++this->m_tile_frame_index;
+        int load_count = 0;
+
+        // Tiles are read on this thread, slow sources would stall the frame
+        const auto load_deadline = std::chrono::steady_clock::now() + m_tile_load_budget;
+        const auto can_load = [&load_count, &load_deadline]()
+        {
+            return 0 == load_count
+                   || (load_count < m_max_tile_loads_per_frame
+                       && std::chrono::steady_clock::now() < load_deadline);
+        };
+
+        for (int tile_y = tile_y_begin; tile_y < tile_y_end; ++tile_y)
+        {
+            for (int tile_x = tile_x_begin; tile_x < tile_x_end; ++tile_x)
+            {
+                GLuint texture = this->m_tile_cache.find(level, tile_x, tile_y, frame_index);
+
+                if (!texture && can_load())
+                {
+                    ++load_count;
+                    texture = this->m_tile_cache.load(level, tile_x, tile_y, frame_index, this->m_gl_state);
+                }
+
+                if (texture)
+                {
+                    this->m_tile_draws.push_back(TileDraw{texture, level, tile_x, tile_y});
+                    continue;
+                }
+
+                // Show the nearest resident coarser tile until this one is loaded
+                for (int coarse_level = level + 1; coarse_level < source.level_count; ++coarse_level)
+                {
+                    const int shift = coarse_level - level;
+                    TileDraw fallback{0, coarse_level, tile_x >> shift, tile_y >> shift};
+
+                    const bool is_drawn = std::any_of(this->m_fallback_tile_draws.begin(),
+                                                      this->m_fallback_tile_draws.end(),
+                                                      [&fallback](const TileDraw& drawn)
+                                                      {
+                                                          return drawn.level == fallback.level
+                                                                 && drawn.tile_x == fallback.tile_x
+                                                                 && drawn.tile_y == fallback.tile_y;
+                                                      });
+
+                    if (is_drawn)
+                    {
+                        break;
+                    }
+
+                    fallback.texture = this->m_tile_cache.find(coarse_level,
+                                                               fallback.tile_x,
+                                                               fallback.tile_y,
+                                                               frame_index);
+
+                    // The coarsest level is loaded first, it covers the
+                    // image with the fewest tiles.
+                    if (!fallback.texture
+                        && coarse_level + 1 == source.level_count
+                        && can_load())
+                    {
+                        ++load_count;
+                        fallback.texture = this->m_tile_cache.load(coarse_level,
+                                                                   fallback.tile_x,
+                                                                   fallback.tile_y,
+                                                                   frame_index,
+                                                                   this->m_gl_state);
+                    }
+
+                    if (fallback.texture)
+                    {
+                        this->m_fallback_tile_draws.push_back(fallback);
+                        break;
+                    }
+                }
+            }
+        }
+
+        this->m_frame_profiler.end_stage();
+        this->m_frame_profiler.begin_stage(FrameStage::Draw);
+
+        this->bind_program(this->m_tile_cache.get_tile_layout(), false);
+        this->m_gl_state.set_uniform(this->m_grid_location, 1.0f, 1.0f);
+
+        // Finer tiles are drawn over the coarser ones
+        for (const TileDraw& tile : this->m_fallback_tile_draws)
+        {
+            this->draw_tile(tile, scale_x, scale_y, offset_x, offset_y);
+        }
+
+        for (const TileDraw& tile : this->m_tile_draws)
+        {
+            this->draw_tile(tile, scale_x, scale_y, offset_x, offset_y);
+        }
+
+        this->draw_overlay(source.width, source.height, scale_x, scale_y, offset_x, offset_y);
+
+        this->m_frame_profiler.end_stage();
+    }
+
+    void WindowProperties::draw_mosaic() noexcept
+    {
+        this->m_frame_profiler.begin_stage(FrameStage::Draw);
+
+        this->m_shown_content = ShownContent::Mosaic;
+
+        this->prepare_draw();
+
+        if (!this->m_mosaic.is_enabled())
+        {
+            this->m_gl_state.count_calls();
+            glClear(GL_COLOR_BUFFER_BIT);
+            this->m_frame_profiler.end_stage();
+            return;
+        }
+
+        const MosaicLayout& mosaic = this->m_mosaic.get_layout();
+        const int mosaic_width = mosaic.columns * mosaic.tile_width;
+        const int mosaic_height = mosaic.rows * mosaic.tile_height;
+
+        float scale_x = 1.0f;
+        float scale_y = 1.0f;
+        this->get_view_scale(mosaic_width, mosaic_height, scale_x, scale_y);
+
+        if (scale_x < 1.0f || scale_y < 1.0f)
+        {
+            this->m_gl_state.count_calls();
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        this->m_mosaic.update_mipmaps(scale_x * this->m_viewport_width.load(std::memory_order_relaxed) < mosaic_width
+                                      || scale_y * this->m_viewport_height.load(std::memory_order_relaxed) < mosaic_height,
+                                      this->m_gl_state);
+
+        this->bind_program(this->m_mosaic.get_tile_layout(), true);
+
+        const float offset_x = get_view_offset(scale_x, this->m_center_x);
+        const float offset_y = get_view_offset(scale_y, this->m_center_y);
+
+        this->m_gl_state.set_uniform(this->m_view_location, scale_x, scale_y, offset_x, offset_y);
+        this->m_gl_state.set_uniform(this->m_texture_rect_location, 1.0f, 1.0f, 0.0f, 0.0f);
+        this->m_gl_state.set_uniform(this->m_grid_location,
+                                     static_cast<float>(mosaic.columns),
+                                     static_cast<float>(mosaic.rows));
+        this->m_gl_state.bind_texture(MosaicTexture::texture_unit,
+                                      GL_TEXTURE_2D_ARRAY,
+                                      this->m_mosaic.get_texture());
+
+        // Every tile is an instance of the image quad, its layer is the instance index
+        this->m_gl_state.count_calls();
+        glDrawElementsInstanced(GL_TRIANGLES,
+                                6,
+                                GL_UNSIGNED_INT,
+                                nullptr,
+                                mosaic.columns * mosaic.rows);
+
+        this->draw_overlay(mosaic_width, mosaic_height, scale_x, scale_y, offset_x, offset_y);
+
+        this->m_frame_profiler.end_stage();
+    }
+
+    void WindowProperties::draw_tile(const TileDraw& tile,
+                                     float scale_x,
+                                     float scale_y,
+                                     float offset_x,
+                                     float offset_y) noexcept
+    {
+        const TileSource& source = this->m_tile_cache.get_source();
+        const int tile_size = source.tile_size;
+
+        // Pixels of the tile which are inside the level
+        const int tile_width = std::min(tile_size, TileCache::get_level_size(source.width, tile.level) - tile.tile_x * tile_size);
+        const int tile_height = std::min(tile_size, TileCache::get_level_size(source.height, tile.level) - tile.tile_y * tile_size);
+
+        // Tile corners in the quad space of the whole image, -1 to 1
+        const float level_scale = static_cast<float>(1 << tile.level);
+        const float x_begin = 2.0f * tile.tile_x * tile_size * level_scale / source.width - 1.0f;
+        const float y_begin = 2.0f * tile.tile_y * tile_size * level_scale / source.height - 1.0f;
+        const float x_end = std::min(x_begin + 2.0f * tile_width * level_scale / source.width, 1.0f);
+        const float y_end = std::min(y_begin + 2.0f * tile_height * level_scale / source.height, 1.0f);
+
+        this->m_gl_state.set_uniform(this->m_view_location,
+                                     0.5f * scale_x * (x_end - x_begin),
+                                     0.5f * scale_y * (y_end - y_begin),
+                                     0.5f * scale_x * (x_begin + x_end) + offset_x,
+                                     0.5f * scale_y * (y_begin + y_end) + offset_y);
+        this->m_gl_state.set_uniform(this->m_texture_rect_location,
+                                     static_cast<float>(tile_width) / tile_size,
+                                     static_cast<float>(tile_height) / tile_size,
+                                     0.0f,
+                                     0.0f);
+        this->m_gl_state.bind_texture(0, GL_TEXTURE_2D, tile.texture);
+
+        this->m_gl_state.count_calls();
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+    }
+
+    void WindowProperties::update_mipmaps(const ImageLayout& layout,
+                                          bool is_minified) noexcept
+    {
+        const bool use_mipmaps = is_minified
+                                 && SamplingLayout::PackedYuyv != layout.sampling_layout
+                                 && !this->m_is_texture_compressed;
+
+        if (use_mipmaps != this->m_is_mipmap_filter)
+        {
+            for (int idx = 0; idx < layout.plane_count; ++idx)
+            {
+                this->m_gl_state.bind_texture(idx, GL_TEXTURE_2D, this->m_textures[idx]);
+                this->m_gl_state.count_calls();
+                glTexParameteri(GL_TEXTURE_2D,
+                                GL_TEXTURE_MIN_FILTER,
+                                use_mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            }
+
+            this->m_is_mipmap_filter = use_mipmaps;
+        }
+
+        if (!use_mipmaps || !this->m_are_mipmaps_dirty)
+        {
+            return;
+        }
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            this->m_gl_state.bind_texture(idx, GL_TEXTURE_2D, this->m_textures[idx]);
+            this->m_gl_state.count_calls();
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        this->m_are_mipmaps_dirty = false;
+    }
+
+    float WindowProperties::get_view_offset(float scale, float center) noexcept
+    {
+        const float offset = (1.0f - 2.0f * center) * scale;
+
+        // Panning stops at the image border, images smaller than the
+        // viewport stay centered.
+        const float limit = std::max(scale - 1.0f, 0.0f);
+
+        return std::min(std::max(offset, -limit), limit);
+    }
+
+    void WindowProperties::update_auto_display_range(const uint8_t* data_ptr,
+                                                     const ImageLayout& layout,
+                                                     int frame_width,
+                                                     int frame_height,
+                                                     PixelFormat format) noexcept
+    {
+        if (!this->m_use_auto_display_range)
+        {
+            return;
+        }
+
+        float minimum = 0.0f;
+        float maximum = 0.0f;
+
+        if (find_value_range(data_ptr + layout.planes[0].offset,
+                             format,
+                             frame_width,
+                             frame_height,
+                             layout.planes[0].row_pitch,
+                             minimum,
+                             maximum))
+        {
+            this->m_auto_minimum = minimum;
+            this->m_auto_maximum = maximum;
+        }
+    }
+
+    void WindowProperties::apply_display_settings() noexcept
+    {
+        std::vector<uint8_t> colormap;
+        std::vector<OverlayInstance> overlay;
+        bool has_overlay = false;
+
+        {
+            std::lock_guard<std::mutex> lock(this->m_display_mutex);
+
+            this->m_use_display_range = this->m_has_display_range;
+            this->m_use_auto_display_range = this->m_is_auto_display_range;
+            this->m_level_minimum = this->m_display_minimum;
+            this->m_level_maximum = this->m_display_maximum;
+            this->m_zoom = this->m_display_zoom;
+            this->m_center_x = this->m_display_center_x;
+            this->m_center_y = this->m_display_center_y;
+            this->m_aspect_mode = this->m_display_aspect_mode;
+
+            colormap.swap(this->m_pending_colormap);
+            overlay.swap(this->m_pending_overlay);
+            has_overlay = this->m_has_pending_overlay;
+            this->m_has_pending_overlay = false;
+        }
+
+        if (has_overlay)
+        {
+            this->upload_overlay(overlay);
+        }
+
+        if (!colormap.empty())
+        {
+            this->m_gl_state.bind_pixel_unpack_buffer(0);
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_ALIGNMENT, 4);
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_ROW_LENGTH, 0);
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_SKIP_PIXELS, 0);
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, 0);
+            this->m_gl_state.bind_texture(3, GL_TEXTURE_1D, this->m_colormap_texture);
+            glTexImage1D(GL_TEXTURE_1D,
+                         0,
+                         GL_RGBA8,
+                         static_cast<GLsizei>(colormap.size() / 4),
+                         0,
+                         GL_RGBA,
+                         GL_UNSIGNED_BYTE,
+                         colormap.data());
+        }
+    }
+
+    void WindowProperties::upload_overlay(const std::vector<OverlayInstance>& instances) noexcept
+    {
+        this->m_overlay_instance_count = static_cast<GLsizei>(instances.size());
+
+        if (instances.empty())
+        {
+            return;
+        }
+
+        if (0 == this->m_overlay_VAO)
+        {
+            // Each window links its own program, so render threads of other
+            // windows never overwrite its uniforms.
+            this->m_overlay_program = shader_link(m_overlay_vertex_shader_id, m_overlay_fragment_shader_id);
+            this->m_overlay_view_location = glGetUniformLocation(this->m_overlay_program, "u_view");
+            this->m_overlay_image_size_location = glGetUniformLocation(this->m_overlay_program, "u_image_size");
+            this->m_overlay_viewport_size_location = glGetUniformLocation(this->m_overlay_program, "u_viewport_size");
+
+            // The atlas is bound to the first unit while the overlay is drawn
+            this->m_gl_state.use_program(this->m_overlay_program);
+            glUniform1i(glGetUniformLocation(this->m_overlay_program, "t_Glyphs"), 0);
+
+            glGenVertexArrays(1, &this->m_overlay_VAO);
+            glGenBuffers(1, &this->m_overlay_buffer);
+
+            this->m_gl_state.bind_vertex_array(this->m_overlay_VAO);
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_overlay_buffer);
+
+            // One quad per instance, corners come from the vertex id
+            const GLsizei stride = sizeof(OverlayInstance);
+
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride,
+                                  reinterpret_cast<const void*>(offsetof(OverlayInstance, position)));
+            glVertexAttribDivisor(0, 1);
+
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride,
+                                  reinterpret_cast<const void*>(offsetof(OverlayInstance, extent)));
+            glVertexAttribDivisor(1, 1);
+
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                                  reinterpret_cast<const void*>(offsetof(OverlayInstance, color)));
+            glVertexAttribDivisor(2, 1);
+
+            this->m_gl_state.count_calls(12);
+        }
+        else
+        {
+            this->m_gl_state.count_calls();
+            glBindBuffer(GL_ARRAY_BUFFER, this->m_overlay_buffer);
+        }
+
+        const size_t size = instances.size() * sizeof(OverlayInstance);
+
+        // Growing reallocates, otherwise the old contents are orphaned
+        this->m_gl_state.count_calls(2);
+
+        if (size > this->m_overlay_buffer_size)
+        {
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), instances.data(), GL_DYNAMIC_DRAW);
+            this->m_overlay_buffer_size = size;
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(this->m_overlay_buffer_size), nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), instances.data());
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void WindowProperties::draw_overlay(int image_width,
+                                        int image_height,
+                                        float scale_x,
+                                        float scale_y,
+                                        float offset_x,
+                                        float offset_y) noexcept
+    {
+        if (0 == this->m_overlay_instance_count || image_width <= 0 || image_height <= 0)
+        {
+            return;
+        }
+
+        // Uniforms of the overlay program are few, they are set every frame
+        // instead of sharing the uniform cache of the image program.
+        this->m_gl_state.use_program(this->m_overlay_program);
+        this->m_gl_state.count_calls(3);
+        glUniform4f(this->m_overlay_view_location, scale_x, scale_y, offset_x, offset_y);
+        glUniform2f(this->m_overlay_image_size_location,
+                    static_cast<float>(image_width),
+                    static_cast<float>(image_height));
+        glUniform2f(this->m_overlay_viewport_size_location,
+                    static_cast<float>(std::max(this->m_viewport_width.load(std::memory_order_relaxed), 1)),
+                    static_cast<float>(std::max(this->m_viewport_height.load(std::memory_order_relaxed), 1)));
+
+        this->m_gl_state.bind_texture(0, GL_TEXTURE_2D, m_glyph_atlas_texture);
+        this->m_gl_state.bind_vertex_array(this->m_overlay_VAO);
+
+        this->m_gl_state.count_calls(4);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, this->m_overlay_instance_count);
+        glDisable(GL_BLEND);
+    }
+
+    void WindowProperties::count_uploaded_bytes(const ImageLayout& layout) noexcept
+    {
+        uint64_t uploaded_bytes = 0;
+
+        for (const Rect& region : this->m_dirty_regions)
+        {
+            for (int idx = 0; idx < layout.plane_count; ++idx)
+            {
+                const PlaneLayout& plane = layout.planes[idx];
+                const Rect plane_region = get_plane_region(plane,
+                                                           region,
+                                                           this->m_texture_width,
+                                                           this->m_texture_height);
+
+                uploaded_bytes += static_cast<uint64_t>(plane_region.width)
+                                  * plane_region.height
+                                  * plane.bytes_per_texel;
+            }
+        }
+
+        // Overlapping caller regions can add up to more than a frame
+        uploaded_bytes = std::min<uint64_t>(uploaded_bytes, layout.frame_size);
+
+        this->m_uploaded_bytes.fetch_add(uploaded_bytes, std::memory_order_relaxed);
+        this->m_skipped_bytes.fetch_add(layout.frame_size - uploaded_bytes,
+                                        std::memory_order_relaxed);
+    }
+
+    void WindowProperties::upload_planes(const uint8_t* data_ptr,
+                                         const ImageLayout& layout) noexcept
+    {
+        // Offsets into an unpack buffer are added to a null pointer, which
+        // is only defined on integers.
+        const uintptr_t base_address = reinterpret_cast<uintptr_t>(data_ptr);
+
+        for (int idx = 0; idx < layout.plane_count; ++idx)
+        {
+            const PlaneLayout& plane = layout.planes[idx];
+
+            // The pitch is expressed as a row length and an alignment, 3
+            // channel, odd width and 16 bit planes can have rows which are
+            // not a multiple of 4 bytes.
+            int row_length = 0;
+            int alignment = 1;
+            const bool is_pitch_supported = get_unpack_row_length(plane, row_length, alignment);
+
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_ALIGNMENT, alignment);
+            this->m_gl_state.set_unpack_parameter(GL_UNPACK_ROW_LENGTH, row_length);
+
+            // Any unit works for uploads, the one the plane is drawn from
+            // saves a bind before the draw.
+            this->m_gl_state.bind_texture(idx, GL_TEXTURE_2D, this->m_textures[idx]);
+
+            for (const Rect& region : this->m_dirty_regions)
+            {
+                const Rect plane_region = get_plane_region(plane,
+                                                           region,
+                                                           this->m_texture_width,
+                                                           this->m_texture_height);
+
+                this->m_gl_state.set_unpack_parameter(GL_UNPACK_SKIP_PIXELS, plane_region.x);
+                this->m_are_mipmaps_dirty = true;
+
+                if (is_pitch_supported)
+                {
+                    this->m_gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, plane_region.y);
+
+                    this->m_gl_state.count_calls();
+                    glTexSubImage2D(GL_TEXTURE_2D,
+                                    0,
+                                    plane_region.x,
+                                    plane_region.y,
+                                    plane_region.width,
+                                    plane_region.height,
+                                    plane.upload_format,
+                                    plane.upload_type,
+                                    reinterpret_cast<const void*>(base_address + plane.offset));
+                    continue;
+                }
+
+                // Odd pitches are stepped over here, one upload per row
+                this->m_gl_state.set_unpack_parameter(GL_UNPACK_SKIP_ROWS, 0);
+
+                for (int row = plane_region.y; row < plane_region.y + plane_region.height; ++row)
+                {
+                    this->m_gl_state.count_calls();
+                    glTexSubImage2D(GL_TEXTURE_2D,
+                                    0,
+                                    plane_region.x,
+                                    row,
+                                    plane_region.width,
+                                    1,
+                                    plane.upload_format,
+                                    plane.upload_type,
+                                    reinterpret_cast<const void*>(base_address
+                                                                  + plane.offset
+                                                                  + row * plane.row_pitch));
+                }
+            }
+        }
+    }
+
+    GLuint WindowProperties::shader_compile(uint32_t type,
+                                            const char *source)
+    {
+        uint32_t id = glCreateShader(type);
+        glShaderSource(id, 1, &source, nullptr);
+        glCompileShader(id);
+
+        int result;
+        glGetShaderiv(id, GL_COMPILE_STATUS, &result);
+
+        if (GL_FALSE == result)
+        {
+            int length;
+            glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+            char* message = new char[length];
+            glGetShaderInfoLog(id, length, &length, message);
+
+            printf("\nFailed to compile Shader!\n%s\n", message);
+            glDeleteShader(id);
+            delete[] message;
+            
+            throw std::runtime_error("Failed to compile Shader!");
+        }
+
+        return id;
+    }
+
+    GLuint WindowProperties::shader_link(GLuint vertex_shader_id,
+                                         GLuint fragment_shader_id) noexcept
+    {
+        GLuint program = glCreateProgram();
+
+        glAttachShader(program, vertex_shader_id);
+        glAttachShader(program, fragment_shader_id);
+        glLinkProgram(program);
+        glValidateProgram(program);
+
+        // The linked program keeps the binaries
+        glDetachShader(program, vertex_shader_id);
+        glDetachShader(program, fragment_shader_id);
+
+        return program;
+    }
+
+    void WindowProperties::upload_with_pixel_buffer_ring(const uint8_t* data_ptr,
+                                                         const ImageLayout& frame_layout) noexcept
+    {
+        uint8_t* mapped_ptr = this->map_next_pixel_buffer();
+
+        if (mapped_ptr)
+        {
+            // Buffers of the ring hold tightly packed frames, strided rows
+            // are packed while they are copied in.
+            const ImageLayout layout = get_image_layout(this->m_texture_format,
+                                                        this->m_texture_width,
+                                                        this->m_texture_height);
+
+            const Rect& first_region = this->m_dirty_regions.front();
+
+            if (1 == this->m_dirty_regions.size()
+                && first_region.width == this->m_texture_width
+                && first_region.height == this->m_texture_height
+                && is_same_storage(frame_layout, layout))
+            {
+                std::memcpy(mapped_ptr, data_ptr, this->m_pbo_size);
+            }
+            else
+            {
+                // Only the regions uploaded from this buffer must be valid,
+                // the rest of it can hold an older frame.
+                for (const Rect& region : this->m_dirty_regions)
+                {
+                    for (int idx = 0; idx < layout.plane_count; ++idx)
+                    {
+                        const PlaneLayout& plane = layout.planes[idx];
+                        const PlaneLayout& frame_plane = frame_layout.planes[idx];
+                        const Rect plane_region = get_plane_region(plane,
+                                                                   region,
+                                                                   this->m_texture_width,
+                                                                   this->m_texture_height);
+
+                        const size_t column_offset = static_cast<size_t>(plane_region.x) * plane.bytes_per_texel;
+
+                        for (int row = plane_region.y; row < plane_region.y + plane_region.height; ++row)
+                        {
+                            std::memcpy(mapped_ptr + plane.offset + row * plane.row_pitch + column_offset,
+                                        data_ptr + frame_plane.offset + row * frame_plane.row_pitch + column_offset,
+                                        static_cast<size_t>(plane_region.width) * plane.bytes_per_texel);
+                        }
+                    }
+                }
+            }
+        }
+
+        this->upload_from_pixel_buffer(nullptr != mapped_ptr);
+    }
+
+    uint8_t* WindowProperties::map_next_pixel_buffer() noexcept
+    {
+        const size_t frame_size = get_image_layout(this->m_texture_format,
+                                                   this->m_texture_width,
+                                                   this->m_texture_height).frame_size;
+
+        if (frame_size != this->m_pbo_size)
+        {
+            // Resolution changed, (re)allocate every buffer of the ring
+            this->release_pixel_buffer_ring();
+
+            glGenBuffers(m_pbo_count, this->m_pbo_ids);
+
+            for (int idx = 0; idx < m_pbo_count; ++idx)
+            {
+                this->m_gl_state.bind_pixel_unpack_buffer(this->m_pbo_ids[idx]);
+
+                if (GLExtensions::buffer_storage)
+                {
+                    // Mapped once for the lifetime of the buffer, producers
+                    // write straight into memory the GPU reads from.
+                    constexpr GLbitfield flags = GL_MAP_WRITE_BIT
+                                                 | GL_MAP_PERSISTENT_BIT
+                                                 | GL_MAP_COHERENT_BIT;
+
+                    GLExtensions::buffer_storage(GL_PIXEL_UNPACK_BUFFER,
+                                                 static_cast<GLsizeiptr>(frame_size),
+                                                 nullptr,
+                                                 flags);
+
+                    this->m_pbo_mapped_ptrs[idx] = static_cast<uint8_t*>(
+                        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                         0,
+                                         static_cast<GLsizeiptr>(frame_size),
+                                         flags));
+                }
+                else
+                {
+                    glBufferData(GL_PIXEL_UNPACK_BUFFER,
+                                 static_cast<GLsizeiptr>(frame_size),
+                                 nullptr,
+                                 GL_STREAM_DRAW);
+                }
+            }
+
+            this->m_pbo_size = frame_size;
+        }
+
+        GLsync& fence = this->m_pbo_fences[this->m_pbo_index];
+
+        // Only wait if the GPU is still reading this buffer, which can only
+        // happen when the caller is more than `m_pbo_count` frames ahead.
+        if (fence)
+        {
+            this->m_gl_state.count_calls(2);
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        uint8_t* mapped_ptr = this->m_pbo_mapped_ptrs[this->m_pbo_index];
+
+        if (!mapped_ptr)
+        {
+            this->m_gl_state.bind_pixel_unpack_buffer(this->m_pbo_ids[this->m_pbo_index]);
+            this->m_gl_state.count_calls();
+
+            // The fence above already synchronized this buffer,
+            // so the driver must not wait for it again.
+            mapped_ptr = static_cast<uint8_t*>(
+                glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                 0,
+                                 static_cast<GLsizeiptr>(frame_size),
+                                 GL_MAP_WRITE_BIT
+                                 | GL_MAP_INVALIDATE_BUFFER_BIT
+                                 | GL_MAP_UNSYNCHRONIZED_BIT));
+        }
+
+        return mapped_ptr;
+    }
+
+    void WindowProperties::upload_from_pixel_buffer(bool is_written) noexcept
+    {
+        this->m_gl_state.bind_pixel_unpack_buffer(this->m_pbo_ids[this->m_pbo_index]);
+
+        if (!this->m_pbo_mapped_ptrs[this->m_pbo_index])
+        {
+            this->m_gl_state.count_calls();
+            is_written = (GL_TRUE == glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) && is_written;
+        }
+
+        if (is_written)
+        {
+            // With a bound unpack buffer plane pointers are offsets
+            this->upload_planes(nullptr,
+                                get_image_layout(this->m_texture_format,
+                                                 this->m_texture_width,
+                                                 this->m_texture_height));
+
+            this->m_gl_state.count_calls();
+            this->m_pbo_fences[this->m_pbo_index]
+                = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        // The buffer stays bound, every upload from client memory binds 0 first
+
+        this->m_pbo_index = (this->m_pbo_index + 1) % m_pbo_count;
+    }
+
+    void WindowProperties::release_pixel_buffer_ring() noexcept
+    {
+        for (GLsync& fence : this->m_pbo_fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        if (this->m_pbo_ids[0] != 0)
+        {
+            // Deleting a buffer also unmaps and unbinds it
+            this->m_gl_state.bind_pixel_unpack_buffer(0);
+            glDeleteBuffers(m_pbo_count, this->m_pbo_ids);
+
+            for (int idx = 0; idx < m_pbo_count; ++idx)
+            {
+                this->m_pbo_ids[idx] = 0;
+                this->m_pbo_mapped_ptrs[idx] = nullptr;
+            }
+        }
+
+        this->m_pbo_index = 0;
+        this->m_pbo_size = 0;
+        this->m_acquired_ptr = nullptr;
+    }
+
+    void WindowProperties::keyboard_callback(GLFWwindow* window,
+                                             int key,
+                                             int scancode,
+                                             int action,
+                                             int mode) noexcept
+    {
+        WindowProperties* instance
+            = static_cast<WindowProperties*>(glfwGetWindowUserPointer(window));
+
+        if (instance)
+        {
+            instance->push_event({WindowEventType::Key, key, action, 0, 0});
+        }
+
+        if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
+        {
+            glfwSetWindowShouldClose(window, GL_TRUE);
+
+            if (instance)
+            {
+                instance->push_event({WindowEventType::Close, 0, 0, 0, 0});
+            }
+        }
+    }
+
+    void WindowProperties::resize_window(int width, int height) noexcept
+    {
+        this->m_viewport_width.store(width, std::memory_order_relaxed);
+        this->m_viewport_height.store(height, std::memory_order_relaxed);
+        this->m_is_viewport_dirty.store(true, std::memory_order_release);
+        this->notify_redraw();
+    }
+
+    void WindowProperties::window_resize_callback(GLFWwindow* window,
+                                                  int width,
+                                                  int height) noexcept
+    {
+        // Retrieve the instance from the user pointer
+        WindowProperties* instance
+            = static_cast<WindowProperties*>(glfwGetWindowUserPointer(window));
+
+        // Call the member function if the instance exists
+        if (instance)
+        {
+            // Call the member function
+            instance->resize_window(width, height);
+            instance->push_event({WindowEventType::Resize, 0, 0, width, height});
+        }
+    }
+
+    void WindowProperties::window_close_callback(GLFWwindow* window) noexcept
+    {
+        WindowProperties* instance
+            = static_cast<WindowProperties*>(glfwGetWindowUserPointer(window));
+
+        if (instance)
+        {
+            instance->push_event({WindowEventType::Close, 0, 0, 0, 0});
+        }
+    }
+
+    void WindowProperties::window_refresh_callback(GLFWwindow* window) noexcept
+    {
+        WindowProperties* instance
+            = static_cast<WindowProperties*>(glfwGetWindowUserPointer(window));
+
+        if (!instance)
+        {
+            return;
+        }
+
+        instance->m_needs_redraw.store(true, std::memory_order_release);
+        instance->notify_redraw();
+
+        // With the context current here, e.g. while Windows runs its modal
+        // resize loop inside the event poll, the resident frame is drawn at
+        // once. Otherwise the thread which presents the window redraws it.
+        if (glfwGetCurrentContext() == window)
+        {
+            // The poll stage ends here, the redraw is measured as a frame
+            instance->m_frame_profiler.end_stage();
+            instance->refresh();
+        }
+    }
+
+    void WindowProperties::push_event(const WindowEvent& event) noexcept
+    {
+        if (!this->m_events.push(event))
+        {
+            // Close and size changes still take effect, only their event is lost
+            this->m_dropped_event_count.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
@@ -0,0 +1,100 @@
+///
+/// @file playback_source_test.cpp
+/// @author Yasin BASAR
+/// @brief Checks which YUV4MPEG2 headers `PlaybackSource` accepts.
+/// @version 1.0.0
+/// @date 22/08/2024
+/// @copyright Copyright (c) 2024
+///
+
+////////////////////////////////////////////////////////////////////////////////
+// Project Includes
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "playback_source.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+// Third Party Includes
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    constexpr const char* test_file_path = "playback_source_test.y4m";
+
+    /// @brief Writes a Y4M file with one 8 bit 4:2:0 sized frame.
+    /// @param colorspace[in] Value of the `C` header token
+    void write_y4m_file(const char* colorspace)
+    {
+        const std::string header = std::string("YUV4MPEG2 W4 H4 F25:1 C") + colorspace + "\nFRAME\n";
+        const std::vector<char> frame(4 * 4 * 3 / 2, 16);
+
+        std::FILE* file = std::fopen(test_file_path, "wb");
+
+        if (!file)
+        {
+            throw std::runtime_error("Could not create test file");
+        }
+
+        std::fwrite(header.data(), 1, header.size(), file);
+        std::fwrite(frame.data(), 1, frame.size(), file);
+        std::fclose(file);
+    }
+
+    /// @brief Opens a Y4M file with the given colorspace.
+    /// @param colorspace[in] Value of the `C` header token
+    /// @return true if the file was accepted
+    bool is_colorspace_accepted(const char* colorspace)
+    {
+        write_y4m_file(colorspace);
+
+        bool is_accepted = true;
+
+        try
+        {
+            YB::PlaybackSource source(test_file_path);
+            is_accepted = source.get_frame_count() == 1;
+        }
+        catch (const std::runtime_error&)
+        {
+            is_accepted = false;
+        }
+
+        std::remove(test_file_path);
+
+        return is_accepted;
+    }
+}
+
+int main()
+{
+    int failure_count = 0;
+
+    const auto expect = [&](const char* colorspace, bool is_expected)
+    {
+        if (is_colorspace_accepted(colorspace) != is_expected)
+        {
+            std::fprintf(stderr,
+                         "C%s should be %s\n",
+                         colorspace,
+                         is_expected ? "accepted" : "rejected");
+            ++failure_count;
+        }
+    };
+
+    expect("420jpeg", true);
+    expect("420mpeg2", true);
+    expect("mono", true);
+    expect("420p10", false);
+    expect("420p12", false);
+    expect("420p16", false);
+    expect("mono16", false);
+    expect("444", false);
+
+    return (0 == failure_count) ? 0 : 1;
+}
+
+/* End of File */